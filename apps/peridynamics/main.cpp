@@ -74,15 +74,14 @@ public:
 
     // reset force
     auto t1 = steady_clock::now();
-    tf::Executor executor(util::parallel::getNThreads());
     tf::Taskflow taskflow;
 
     taskflow.for_each_index(
             (std::size_t) 0, d_x.size(), (std::size_t) 1,
-            [this](std::size_t i) { this->d_f[i] = util::Point(); }
+            [this](std::size_t i) { this->d_f.set(i, util::Point()); }
     ); // for_each
 
-    executor.run(taskflow).get();
+    util::parallel::runTaskflow(taskflow);
     auto force_reset_time = util::methods::timeDiff(t1, steady_clock::now());
 
     // compute peridynamic forces
@@ -293,19 +293,21 @@ public:
       }
     }
 
-    // compute stress and strain
+    // compute stress and strain (fe utilities work with list of points)
+    const auto xRef = d_xRef.toVector();
+    const auto u = d_u.toVector();
     for (auto &p: d_particlesListTypeAll) {
 
       const auto particle_mesh_p = p->getMeshP();
 
-      fe::getCurrentQuadPoints(particle_mesh_p.get(), d_xRef, d_u, d_xQuadCur,
+      fe::getCurrentQuadPoints(particle_mesh_p.get(), xRef, u, d_xQuadCur,
                                p->d_globStart,
                                p->d_globQuadStart,
                                d_modelDeck_p->d_quadOrder);
 
       auto p_z_id = p->d_zoneId;
       auto isPlaneStrain = d_pDeck_p->d_particleZones[p_z_id].d_matDeck.d_isPlaneStrain;
-      fe::getStrainStress(particle_mesh_p.get(), d_xRef, d_u,
+      fe::getStrainStress(particle_mesh_p.get(), xRef, u,
                           isPlaneStrain,
                           d_strain, d_stress,
                           p->d_globStart,
@@ -319,7 +321,7 @@ public:
       double p_max_stress = 0.;
       auto p_max_stress_loc_cur = util::Point();
       auto p_max_stress_loc_ref = util::Point();
-      fe::getMaxShearStressAndLoc(p->getMeshP().get(), d_xRef, d_u, d_stress,
+      fe::getMaxShearStressAndLoc(p->getMeshP().get(), xRef, u, d_stress,
                                   p_max_stress,
                                   p_max_stress_loc_ref,
                                   p_max_stress_loc_cur,
@@ -328,8 +330,8 @@ public:
       if (util::isGreater(p_max_stress, max_stress_t)) {
         max_stress_t = p_max_stress;
         auto p_center_node_id = p->d_globStart + p->d_rp_p->getCenterNodeId();
-        max_stress_loc_ref_t = p_max_stress_loc_ref - d_xRef[p_center_node_id];
-        max_stress_loc_cur_t = p_max_stress_loc_cur - d_x[p_center_node_id];
+        max_stress_loc_ref_t = p_max_stress_loc_ref - getXRef(p_center_node_id);
+        max_stress_loc_cur_t = p_max_stress_loc_cur - getX(p_center_node_id);
       }
     }
 
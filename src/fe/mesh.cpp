@@ -281,7 +281,6 @@ void fe::Mesh::computeVol() {
   //
   d_vol.resize(d_numNodes);
   
-  tf::Executor executor(util::parallel::getNThreads());
   tf::Taskflow taskflow;
 
   taskflow.for_each_index(
@@ -326,7 +325,7 @@ void fe::Mesh::computeVol() {
     }
   ); // for_each
   
-  executor.run(taskflow).get();
+  util::parallel::runTaskflow(taskflow);
 }
 
 void fe::Mesh::computeBBox() {
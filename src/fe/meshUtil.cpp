@@ -14,12 +14,236 @@
 #include "util/feElementDefs.h"
 #include "util/parallelUtil.h"
 #include "util/function.h"
+#include "util/io.h"
 
 #include <fmt/format.h>
 
 #include <taskflow/taskflow/taskflow.hpp>
 #include <taskflow/taskflow/algorithm/for_each.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <numeric>
+
+namespace {
+
+/*! @brief Number of bits per direction in space-filling curve index */
+const int sfc_bits = 21;
+
+/*!
+ * @brief Transforms integer coordinates to transposed Hilbert index (see J.
+ * Skilling, Programming the Hilbert curve, AIP Conf. Proc. 707, 2004)
+ */
+void axesToTranspose(uint32_t *X, int b, size_t n) {
+
+  uint32_t M = uint32_t(1) << (b - 1), P, Q, t;
+
+  // inverse undo
+  for (Q = M; Q > 1; Q >>= 1) {
+    P = Q - 1;
+    for (size_t i = 0; i < n; i++) {
+      if (X[i] & Q)
+        X[0] ^= P;
+      else {
+        t = (X[0] ^ X[i]) & P;
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+
+  // gray encode
+  for (size_t i = 1; i < n; i++)
+    X[i] ^= X[i - 1];
+  t = 0;
+  for (Q = M; Q > 1; Q >>= 1)
+    if (X[n - 1] & Q)
+      t ^= Q - 1;
+  for (size_t i = 0; i < n; i++)
+    X[i] ^= t;
+}
+
+/*! @brief Interleaves bits of integer coordinates into single index */
+uint64_t interleaveBits(const uint32_t *X, int b, size_t n) {
+  uint64_t key = 0;
+  for (int bit = b - 1; bit >= 0; bit--)
+    for (size_t i = 0; i < n; i++)
+      key = (key << 1) | ((X[i] >> bit) & 1);
+
+  return key;
+}
+
+} // anonymous namespace
+
+std::vector<size_t> fe::getSpaceFillingCurveOrder(
+    const std::vector<util::Point> &nodes, size_t dim,
+    const std::string &method) {
+
+  if (method != "morton" and method != "hilbert") {
+    std::cerr << "Error: Space-filling curve = " << method
+              << " is not supported. Use either 'morton' or 'hilbert'.\n";
+    exit(1);
+  }
+
+  if (dim < 1 or dim > 3) {
+    std::cerr << "Error: Dimension = " << dim
+              << " is not supported in getSpaceFillingCurveOrder().\n";
+    exit(1);
+  }
+
+  std::vector<size_t> order(nodes.size());
+  std::iota(order.begin(), order.end(), 0);
+  if (nodes.empty())
+    return order;
+
+  // bounding box (same scaling along all directions)
+  util::Point x_min = nodes[0], x_max = nodes[0];
+  for (const auto &x : nodes)
+    for (size_t d = 0; d < dim; d++) {
+      x_min[d] = std::min(x_min[d], x[d]);
+      x_max[d] = std::max(x_max[d], x[d]);
+    }
+
+  double L = 0.;
+  for (size_t d = 0; d < dim; d++)
+    L = std::max(L, x_max[d] - x_min[d]);
+
+  const double scale =
+      L > 0. ? double((uint32_t(1) << sfc_bits) - 1) / L : 0.;
+
+  // compute index of nodes along curve
+  std::vector<uint64_t> keys(nodes.size());
+  for (size_t i = 0; i < nodes.size(); i++) {
+    uint32_t X[3] = {0, 0, 0};
+    for (size_t d = 0; d < dim; d++)
+      X[d] = uint32_t((nodes[i][d] - x_min[d]) * scale);
+
+    if (method == "hilbert")
+      axesToTranspose(X, sfc_bits, dim);
+
+    keys[i] = interleaveBits(X, sfc_bits, dim);
+  }
+
+  std::stable_sort(order.begin(), order.end(),
+                   [&keys](const size_t &a, const size_t &b) {
+                     return keys[a] < keys[b];
+                   });
+
+  return order;
+}
+
+void fe::renumberNodes(fe::Mesh *mesh_p, const std::vector<size_t> &order) {
+
+  const size_t n = mesh_p->d_nodes.size();
+  if (order.size() != n) {
+    std::cerr << "Error: Size of node order = " << order.size()
+              << " does not match number of nodes = " << n << ".\n";
+    exit(1);
+  }
+
+  // element data read from file after renumbering would use old node ids,
+  // so read it now if mesh file has it
+  if (mesh_p->d_enc.empty() and !mesh_p->d_filename.empty() and
+      util::io::getExtensionFromFile(mesh_p->d_filename) != "csv")
+    mesh_p->readElementData(mesh_p->d_filename);
+
+  // new id of each old node
+  std::vector<size_t> new_id(n);
+  for (size_t k = 0; k < n; k++)
+    new_id[order[k]] = k;
+
+  // permute nodal data
+  auto permute = [&order, n](auto &data) {
+    if (data.size() != n)
+      return;
+
+    auto old_data = data;
+    for (size_t k = 0; k < n; k++)
+      data[k] = old_data[order[k]];
+  };
+
+  permute(mesh_p->d_nodes);
+  permute(mesh_p->d_fix);
+  permute(mesh_p->d_vol);
+  permute(mesh_p->d_nodePartition);
+  permute(mesh_p->d_nec);
+
+  // update node ids in element-node connectivity
+  for (auto &e : mesh_p->d_enc)
+    e = new_id[e];
+
+  // update dof maps (dof of node i along direction d is i * dim + d)
+  const size_t dim = mesh_p->d_dim;
+  if (!mesh_p->d_gMap.empty()) {
+    for (auto &g : mesh_p->d_gMap)
+      g = new_id[g / dim] * dim + g % dim;
+  }
+
+  if (mesh_p->d_gInvMap.size() == n * dim) {
+    auto old_map = mesh_p->d_gInvMap;
+    for (size_t k = 0; k < n; k++)
+      for (size_t d = 0; d < dim; d++)
+        mesh_p->d_gInvMap[k * dim + d] = old_map[order[k] * dim + d];
+  }
+}
+
+std::vector<size_t> fe::getBoundaryNodes(const fe::Mesh &mesh) {
+
+  // local vertices of facets of element
+  std::vector<std::vector<size_t>> facets;
+  switch (mesh.getElementType()) {
+  case util::vtk_type_line:
+    facets = {{0}, {1}};
+    break;
+  case util::vtk_type_triangle:
+    facets = {{0, 1}, {1, 2}, {2, 0}};
+    break;
+  case util::vtk_type_quad:
+    facets = {{0, 1}, {1, 2}, {2, 3}, {3, 0}};
+    break;
+  case util::vtk_type_tetra:
+    facets = {{0, 1, 2}, {0, 1, 3}, {1, 2, 3}, {0, 2, 3}};
+    break;
+  case util::vtk_type_hexahedron:
+    facets = {{0, 1, 2, 3}, {4, 5, 6, 7}, {0, 1, 5, 4},
+              {1, 2, 6, 5}, {2, 3, 7, 6}, {3, 0, 4, 7}};
+    break;
+  default:
+    return {};
+  }
+
+  const auto &enc = mesh.getElementConnectivities();
+  const size_t num_vertex = mesh.d_eNumVertex;
+  if (enc.empty() or num_vertex == 0)
+    return {};
+
+  // count number of elements sharing each facet
+  std::map<std::vector<size_t>, size_t> facet_count;
+  for (size_t e = 0; e < enc.size() / num_vertex; e++) {
+    for (const auto &f : facets) {
+      std::vector<size_t> key(f.size());
+      for (size_t k = 0; k < f.size(); k++)
+        key[k] = enc[e * num_vertex + f[k]];
+      std::sort(key.begin(), key.end());
+      facet_count[key]++;
+    }
+  }
+
+  std::vector<uint8_t> is_boundary(mesh.getNumNodes(), 0);
+  for (const auto &[key, count] : facet_count)
+    if (count == 1)
+      for (auto i : key)
+        is_boundary[i] = 1;
+
+  std::vector<size_t> nodes;
+  for (size_t i = 0; i < is_boundary.size(); i++)
+    if (is_boundary[i])
+      nodes.push_back(i);
+
+  return nodes;
+}
+
 void fe::createUniformMesh(fe::Mesh *mesh_p, size_t dim, std::pair<std::vector<double>, std::vector<double>> box, std::vector<size_t> nGrid) {
 
   mesh_p->d_dim = dim;
@@ -234,7 +458,6 @@ fe::getCurrentQuadPoints(const fe::Mesh *mesh_p,
 
 
   // compute current position of quad points
-  tf::Executor executor(util::parallel::getNThreads());
   tf::Taskflow taskflow;
   taskflow.for_each_index(
         (std::size_t) 0, num_elems, (std::size_t) 1,
@@ -274,7 +497,7 @@ fe::getCurrentQuadPoints(const fe::Mesh *mesh_p,
         } // loop over elements
   ); // for_each
 
-  executor.run(taskflow).get();
+  util::parallel::runTaskflow(taskflow);
 }
 
 void fe::getStrainStress(const fe::Mesh *mesh_p,
@@ -341,7 +564,6 @@ void fe::getStrainStress(const fe::Mesh *mesh_p,
             "total number of quadrature points.\n");
 
   // compute current position of quad points
-  tf::Executor executor(util::parallel::getNThreads());
   tf::Taskflow taskflow;
   taskflow.for_each_index(
           (std::size_t) 0, num_elems, (std::size_t) 1,
@@ -423,7 +645,7 @@ void fe::getStrainStress(const fe::Mesh *mesh_p,
           } // loop over elements
   ); // for_each
 
-  executor.run(taskflow).get();
+  util::parallel::runTaskflow(taskflow);
 }
 
 void fe::getMaxShearStressAndLoc(const fe::Mesh *mesh_p,
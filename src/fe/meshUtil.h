@@ -30,6 +30,51 @@ class Mesh;
  */
 void createUniformMesh(fe::Mesh *mesh_p, size_t dim, std::pair<std::vector<double>, std::vector<double>> box, std::vector<size_t> nGrid);
 
+/*!
+ * @brief Returns order of nodes along a space-filling curve
+ *
+ * Nodes are mapped to an integer grid (21 bits per direction) covering
+ * their bounding box and sorted by Morton (Z-order) or Hilbert index. Nodes
+ * close along the curve are close in space, so numbering nodes in this
+ * order makes neighbors of a node close in memory.
+ *
+ * @param nodes Coordinates of nodes
+ * @param dim Dimension
+ * @param method Either "morton" or "hilbert"
+ * @return order Old id of node for each new id, i.e., order[k] is the node
+ * that is numbered k in the new order
+ */
+std::vector<size_t> getSpaceFillingCurveOrder(
+    const std::vector<util::Point> &nodes, size_t dim,
+    const std::string &method);
+
+/*!
+ * @brief Renumbers nodes of mesh
+ *
+ * Nodes, fixity, nodal volume, node partition, element-node and
+ * node-element connectivity, and dof maps are updated consistently. If
+ * element data is not read yet (e.g., .vtu mesh with nodal volume), it is
+ * read from mesh file before renumbering.
+ *
+ * @param mesh_p Pointer to mesh
+ * @param order Old id of node for each new id (see
+ * getSpaceFillingCurveOrder())
+ */
+void renumberNodes(fe::Mesh *mesh_p, const std::vector<size_t> &order);
+
+/*!
+ * @brief Returns nodes on boundary of mesh
+ *
+ * Boundary nodes are vertices of element facets (end points of lines, edges
+ * of triangles and quadrangles, and faces of tetrahedra and hexahedra) that
+ * belong to only one element.
+ *
+ * @param mesh Mesh
+ * @return nodes Sorted list of boundary nodes (empty if mesh does not have
+ * element-node connectivity data or if element type is not supported)
+ */
+std::vector<size_t> getBoundaryNodes(const fe::Mesh &mesh);
+
 /*!
  * @brief Get current location of quadrature points of elements in the mesh.
  * This function expects mesh has element-node connectivity data.
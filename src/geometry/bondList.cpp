@@ -0,0 +1,137 @@
+/*
+ * -------------------------------------------
+ * Copyright (c) 2021 - 2024 Prashant K. Jha
+ * -------------------------------------------
+ * PeriDEM https://github.com/prashjha/PeriDEM
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE)
+ */
+
+#include "bondList.h"
+#include "util/io.h"
+#include "util/parallelUtil.h"
+#include <taskflow/taskflow/taskflow.hpp>
+#include <taskflow/taskflow/algorithm/for_each.hpp>
+
+void geometry::BondList::build(
+    const std::vector<std::vector<std::size_t>> &neighbor_list) {
+
+  std::size_t n = neighbor_list.size();
+  if (n > std::size_t(id_mask)) {
+    std::cerr << "Error: BondList supports at most " << id_mask
+              << " nodes. Number of nodes = " << n << ".\n";
+    exit(1);
+  }
+
+  // offsets from prefix sum of number of neighbors
+  d_offsets.resize(n + 1);
+  d_offsets[0] = 0;
+  for (std::size_t i = 0; i < n; i++)
+    d_offsets[i + 1] = d_offsets[i] + neighbor_list[i].size();
+
+  d_bonds.resize(d_offsets[n]);
+  d_bonds.shrink_to_fit();
+
+  tf::Taskflow taskflow;
+
+  taskflow.for_each_index(
+    (std::size_t) 0, n, (std::size_t) 1, [this, &neighbor_list](std::size_t i) {
+      auto b = this->d_offsets[i];
+      for (const auto &j : neighbor_list[i])
+        this->d_bonds[b++] = uint32_t(j) & id_mask;
+    }
+  ); // for_each
+
+  util::parallel::runTaskflow(taskflow);
+}
+
+void geometry::BondList::clear() {
+  d_offsets.assign(1, 0);
+  d_bonds.clear();
+}
+
+std::size_t geometry::BondList::numBrokenBonds() const {
+  std::size_t n = 0;
+  for (const auto &w : d_bonds)
+    n += (w & state_mask) ? 1 : 0;
+
+  return n;
+}
+
+std::vector<std::size_t> geometry::BondList::compact(BondList &broken) {
+
+  const std::size_t n = numNodes();
+  const bool has_broken = broken.numNodes() == n;
+  if (!has_broken and broken.numBonds() > 0) {
+    std::cerr << "Error: Number of nodes in list of broken bonds = "
+              << broken.numNodes() << " does not match number of nodes = "
+              << n << ".\n";
+    exit(1);
+  }
+
+  // count bonds of nodes in new lists
+  std::vector<std::size_t> offsets(n + 1, 0), broken_offsets(n + 1, 0);
+  for (std::size_t i = 0; i < n; i++) {
+    for (auto b = begin(i); b < end(i); b++)
+      getBondState(b) ? broken_offsets[i + 1]++ : offsets[i + 1]++;
+    if (has_broken)
+      broken_offsets[i + 1] += broken.numBonds(i);
+  }
+
+  for (std::size_t i = 0; i < n; i++) {
+    offsets[i + 1] += offsets[i];
+    broken_offsets[i + 1] += broken_offsets[i];
+  }
+
+  // move bonds
+  std::vector<uint32_t> bonds(offsets[n]), broken_bonds(broken_offsets[n]);
+  std::vector<std::size_t> map(offsets[n]);
+  for (std::size_t i = 0; i < n; i++) {
+    auto k = offsets[i];
+    auto kb = broken_offsets[i];
+    if (has_broken)
+      for (auto b = broken.begin(i); b < broken.end(i); b++)
+        broken_bonds[kb++] = broken.d_bonds[b];
+
+    for (auto b = begin(i); b < end(i); b++) {
+      if (getBondState(b))
+        broken_bonds[kb++] = d_bonds[b];
+      else {
+        map[k] = b;
+        bonds[k++] = d_bonds[b];
+      }
+    }
+  }
+
+  d_offsets.swap(offsets);
+  d_bonds.swap(bonds);
+  broken.d_offsets.swap(broken_offsets);
+  broken.d_bonds.swap(broken_bonds);
+
+  return map;
+}
+
+std::vector<std::size_t>
+geometry::BondList::getNeighbors(const std::size_t &i) const {
+
+  std::vector<std::size_t> neighs;
+  neighs.reserve(numBonds(i));
+  for (auto b = begin(i); b < end(i); b++)
+    neighs.push_back(getNeighbor(b));
+
+  return neighs;
+}
+
+std::string geometry::BondList::printStr(int nt, int lvl) const {
+
+  auto tabS = util::io::getTabS(nt);
+  std::ostringstream oss;
+  oss << tabS << "------- BondList --------" << std::endl << std::endl;
+  oss << tabS << "Num of nodes = " << numNodes() << std::endl;
+  oss << tabS << "Num of bonds = " << numBonds() << std::endl;
+  oss << tabS << "Memory (bytes) = " << memorySize() << std::endl;
+  oss << tabS << std::endl;
+
+  return oss.str();
+}
@@ -0,0 +1,206 @@
+/*
+ * -------------------------------------------
+ * Copyright (c) 2021 - 2024 Prashant K. Jha
+ * -------------------------------------------
+ * PeriDEM https://github.com/prashjha/PeriDEM
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE)
+ */
+
+#ifndef GEOM_BONDLIST_H
+#define GEOM_BONDLIST_H
+
+#include <cstdint> // uint32_t type
+#include <cstring> // string and size_t type
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace geometry {
+
+/*! @brief A compressed-sparse-row (CSR) list of peridynamic bonds
+ *
+ * Bonds of node i are stored contiguously in positions [begin(i), end(i))
+ * of a single array. Each bond is a 32-bit word whose lower 31 bits hold the
+ * id of the neighboring node and whose highest bit holds the fracture state
+ * of the bond (1 if broken). Compared to storing std::vector<size_t> per node
+ * along with a separate fracture state per node, this cuts memory per bond
+ * from more than 8 bytes to 4 bytes, removes one heap allocation per node,
+ * and lets bond loops stream through a single contiguous array.
+ *
+ * Since each bond word is owned by one node, bond states of different nodes
+ * can be modified concurrently.
+ */
+class BondList {
+
+public:
+  /*! @brief Bit holding the fracture state of bond */
+  static constexpr uint32_t state_mask = uint32_t(1) << 31;
+
+  /*! @brief Bits holding the neighbor id of bond */
+  static constexpr uint32_t id_mask = ~state_mask;
+
+  /*!
+   * @brief Constructor
+   */
+  BondList() : d_offsets(1, 0) {}
+
+  /*!
+   * @brief Builds the list from neighbor list of nodes
+   *
+   * All bonds are marked as unbroken. Node ids should be less than 2^31.
+   *
+   * @param neighbor_list List of neighbors of each node
+   */
+  void build(const std::vector<std::vector<std::size_t>> &neighbor_list);
+
+  /*! @brief Removes all bonds */
+  void clear();
+
+  /*!
+   * @brief Returns number of nodes
+   *
+   * @return n Number of nodes
+   */
+  std::size_t numNodes() const { return d_offsets.size() - 1; }
+
+  /*!
+   * @brief Returns total number of bonds
+   *
+   * @return n Number of bonds
+   */
+  std::size_t numBonds() const { return d_bonds.size(); }
+
+  /*!
+   * @brief Returns number of bonds of node i
+   *
+   * @param i Nodal id
+   * @return n Number of bonds
+   */
+  std::size_t numBonds(const std::size_t &i) const {
+    return d_offsets[i + 1] - d_offsets[i];
+  }
+
+  /*!
+   * @brief Returns global id of first bond of node i
+   *
+   * @param i Nodal id
+   * @return b Bond id
+   */
+  std::size_t begin(const std::size_t &i) const { return d_offsets[i]; }
+
+  /*!
+   * @brief Returns global id of one past the last bond of node i
+   *
+   * @param i Nodal id
+   * @return b Bond id
+   */
+  std::size_t end(const std::size_t &i) const { return d_offsets[i + 1]; }
+
+  /*!
+   * @brief Returns neighbor node of bond
+   *
+   * @param b Global bond id
+   * @return j Id of neighboring node
+   */
+  std::size_t getNeighbor(const std::size_t &b) const {
+    return d_bonds[b] & id_mask;
+  }
+
+  /*!
+   * @brief Read bond state
+   *
+   * @param b Global bond id
+   * @return bool True if bond is fractured otherwise false
+   */
+  bool getBondState(const std::size_t &b) const {
+    return d_bonds[b] & state_mask;
+  }
+
+  /*!
+   * @brief Sets the bond state
+   *
+   * @param b Global bond id
+   * @param state State which is applied to the bond
+   */
+  void setBondState(const std::size_t &b, const bool &state) {
+    state ? (d_bonds[b] |= state_mask) : (d_bonds[b] &= id_mask);
+  }
+
+  /*!
+   * @brief Returns pointer to array of bond words (neighbor id and state)
+   *
+   * @return pointer Pointer to first bond
+   */
+  uint32_t *data() { return d_bonds.data(); }
+
+  /*! @copydoc data() */
+  const uint32_t *data() const { return d_bonds.data(); }
+
+  /*!
+   * @brief Returns number of broken bonds
+   *
+   * @return n Number of broken bonds
+   */
+  std::size_t numBrokenBonds() const;
+
+  /*!
+   * @brief Moves broken bonds of this list to another list
+   *
+   * Unbroken bonds stay in this list in their original order. Broken bonds
+   * of node i are appended to the bonds of node i in list broken (which is
+   * either empty or has the same number of nodes as this list).
+   *
+   * @param broken List to which broken bonds are appended
+   * @return map Old global bond id of each bond kept in this list (used to
+   * compact data indexed by bond id)
+   */
+  std::vector<std::size_t> compact(BondList &broken);
+
+  /*!
+   * @brief Returns list of neighbors of node i
+   *
+   * @param i Nodal id
+   * @return list Neighbors of node i
+   */
+  std::vector<std::size_t> getNeighbors(const std::size_t &i) const;
+
+  /*!
+   * @brief Returns memory used by the list in bytes
+   *
+   * @return size Memory in bytes
+   */
+  std::size_t memorySize() const {
+    return d_offsets.capacity() * sizeof(std::size_t) +
+           d_bonds.capacity() * sizeof(uint32_t);
+  }
+
+  /*!
+   * @brief Returns the string containing printable information about the object
+   *
+   * @param nt Number of tabs to append before printing
+   * @param lvl Information level (higher means more information)
+   * @return string String containing printable information about the object
+   */
+  std::string printStr(int nt = 0, int lvl = 0) const;
+
+  /*!
+   * @brief Prints the information about the object
+   *
+   * @param nt Number of tabs to append before printing
+   * @param lvl Information level (higher means more information)
+   */
+  void print(int nt = 0, int lvl = 0) const { std::cout << printStr(nt, lvl); }
+
+private:
+  /*! @brief Offsets of bonds of nodes (size is number of nodes plus one) */
+  std::vector<std::size_t> d_offsets;
+
+  /*! @brief Bonds (neighbor id and fracture state packed in 32 bits) */
+  std::vector<uint32_t> d_bonds;
+};
+
+} // namespace geometry
+
+#endif // GEOM_BONDLIST_H
@@ -18,16 +18,19 @@
 geometry::Fracture::Fracture() {}
 
 geometry::Fracture::Fracture(const std::vector<util::Point> *nodes,
+    const std::vector<std::vector<std::size_t>> *neighbor_list)
+    : Fracture(nodes->size(), neighbor_list) {}
+
+geometry::Fracture::Fracture(std::size_t num_nodes,
     const std::vector<std::vector<std::size_t>> *neighbor_list) {
 
-  std::size_t n = nodes->size();
+  std::size_t n = num_nodes;
   d_fracture.resize(n);
 
-  tf::Executor executor(util::parallel::getNThreads());
   tf::Taskflow taskflow;
 
   taskflow.for_each_index(
-    (std::size_t) 0, n, (std::size_t) 1, [this, &nodes, &neighbor_list, n](std::size_t i) {
+    (std::size_t) 0, n, (std::size_t) 1, [this, &neighbor_list, n](std::size_t i) {
       // get neighborlist of node i if neighborlist is provided
       std::vector<size_t> neighs;
       if (neighbor_list != nullptr)
@@ -45,7 +48,7 @@ geometry::Fracture::Fracture(const std::vector<util::Point> *nodes,
     }
   ); // for_each
 
-  executor.run(taskflow).get();
+  util::parallel::runTaskflow(taskflow);
 }
 
 void geometry::Fracture::setBondState(const std::size_t &i, const std::size_t &j,
@@ -38,6 +38,18 @@ public:
   Fracture(const std::vector<util::Point> *nodes,
            const std::vector<std::vector<std::size_t>> *neighbor_list = nullptr);
 
+  /*!
+   * @brief Constructor
+   *
+   * If neighbor list is null, then it assumes all nodes interact with all
+   * other nodes (PeriDEM implementation).
+   *
+   * @param num_nodes Number of nodes
+   * @param neighbor_list Pointer to neighbor list
+   */
+  Fracture(std::size_t num_nodes,
+           const std::vector<std::vector<std::size_t>> *neighbor_list = nullptr);
+
   /*!
    * @brief Constructor
    */
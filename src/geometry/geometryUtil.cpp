@@ -24,12 +24,13 @@ void geometry::computeNonlocalNeighborhood(const std::vector<util::Point> &nodes
   set_tree_time += nsearch_p->setInputCloud();
   std::cout << fmt::format("Tree setup time (ms) = {}. \n", set_tree_time);
 
+  nsearch::SearchBuffer buffer;
+  const auto &neighs = buffer.d_neighs;
   for (size_t i=0; i<nodes.size(); i++) {
-    std::vector<size_t> neighs;
-    std::vector<double> sqr_dist;
     nodeNeighs[i].resize(0);
 
-    if (nsearch_p->radiusSearch(nodes[i], horizon, neighs, sqr_dist) > 0) {
+    if (nsearch_p->radiusSearch(nodes[i], horizon, buffer.d_neighs,
+                                buffer.d_sqrDist) > 0) {
       for (std::size_t j = 0; j < neighs.size(); ++j)
         if (neighs[j] != i) {
           nodeNeighs[i].push_back(neighs[j]);
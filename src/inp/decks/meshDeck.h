@@ -78,6 +78,16 @@ struct MeshDeck {
    */
   util::geometry::GeomData d_createMeshGeomData;
 
+  /*!
+   * @brief Space-filling curve used to renumber nodes after the mesh is
+   * read (empty string to keep node order of mesh file)
+   *
+   * List of allowed values are:
+   * - \a morton
+   * - \a hilbert
+   */
+  std::string d_nodeOrdering;
+
   /*!
    * @brief Constructor
    */
@@ -109,6 +119,7 @@ struct MeshDeck {
     oss << tabS << "Create mesh info = " << d_createMeshInfo << std::endl;
     oss << tabS << "Create mesh geometry details: " << std::endl;
     oss << d_createMeshGeomData.printStr(nt+1, lvl);
+    oss << tabS << "Node ordering = " << d_nodeOrdering << std::endl;
     oss << tabS << std::endl;
 
     return oss.str();
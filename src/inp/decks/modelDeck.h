@@ -98,13 +98,136 @@ struct ModelDeck {
   /*! @brief Seed for random calculations (if any) */
   int d_seed;
 
+  /*!
+   * @brief Flag to run the central difference time step as a single task graph
+   *
+   * When true, integration, displacement bc, force reset, peridynamic
+   * force, contact neighborlist update, contact force, and external force
+   * are expressed as one taskflow graph with data dependencies between
+   * them, so that independent phases (e.g., contact neighborlist update
+   * and peridynamic force) overlap.
+   */
+  bool d_stepTaskGraph;
+
+  /*!
+   * @brief Flag to cache reference quantities of peridynamic bonds
+   *
+   * When true, reference bond length, corrected volume of neighbor,
+   * influence function, and critical strain of each bond are computed once
+   * after the peridynamic neighborlist is created and reused in every time
+   * step. This trades 32 bytes of memory per bond for speed, so it may be
+   * turned off for very large simulations.
+   */
+  bool d_pdBondCache;
+
+  /*!
+   * @brief Flag to use explicitly vectorized (AVX2) bond kernel for
+   * bond-based materials with linear bond force (PMB and PD elastic)
+   *
+   * It is only used if the CPU supports AVX2. Results agree with the default
+   * kernel up to round-off.
+   */
+  bool d_pdSimdKernel;
+
+  /*!
+   * @brief Flag to store bond-level quantities in single precision
+   *
+   * When true, the peridynamic bond cache (see d_pdBondCache) is enabled and
+   * stored in float, halving its memory. Positions, displacements, and
+   * forces remain in double and bond contributions are accumulated in double.
+   * Only the bond cache is in float; contact data and all other arrays of
+   * model::ModelData stay in double.
+   */
+  bool d_mixedPrecision;
+
+  /*!
+   * @brief Flag to store each peridynamic bond once (in list of node with
+   * smaller id) and evaluate it once per time step
+   *
+   * Equal and opposite forces of bond are added to both nodes using
+   * accumulation buffers for contiguous ranges of nodes, which are summed in
+   * fixed order. Only bond-based materials are supported.
+   */
+  bool d_pdHalfBonds;
+
+  /*!
+   * @brief Fraction of broken peridynamic bonds above which broken bonds are
+   * compacted out of the list of bonds (zero disables compaction)
+   *
+   * Broken bonds are moved to a separate list that is only used for contact
+   * between broken bonds and for damage. See d_pdBondCompactionInterval.
+   */
+  double d_pdBondCompactionThreshold;
+
+  /*!
+   * @brief Number of time steps between checks of the fraction of broken
+   * peridynamic bonds
+   */
+  size_t d_pdBondCompactionInterval;
+
+  /*!
+   * @brief Maximum nodal velocity below which particle is considered at rest
+   * (zero disables sleeping of particles)
+   *
+   * Particles that are at rest for d_sleepSteps time steps are put to sleep,
+   * i.e., their nodes are skipped in time integration and force computation.
+   * Sleeping particle is woken up when a particle or wall in contact with it
+   * moves with velocity above this threshold.
+   */
+  double d_sleepVelocityThreshold;
+
+  /*!
+   * @brief Maximum nodal force density below which particle is considered
+   * at rest
+   */
+  double d_sleepForceThreshold;
+
+  /*! @brief Number of time steps particle should be at rest before sleeping */
+  size_t d_sleepSteps;
+
+  /*! @brief Number of time steps between checks of sleeping state of particles */
+  size_t d_sleepCheckInterval;
+
+  /*!
+   * @brief Flag to evaluate contact force of each pair of nodes once
+   *
+   * When true, pair of nodes that are both searched for contact neighbors is
+   * stored only once in contact neighborlist, and its force is applied to
+   * both nodes. Forces of pairs are gathered at nodes in fixed order so that
+   * result does not depend on number of threads.
+   */
+  bool d_contactHalfPairs;
+
+  /*!
+   * @brief Flag to share peridynamic neighborhoods between particles created
+   * from the same reference particle
+   *
+   * Particles with same reference particle, zone, scale, and horizon have the
+   * same bonds up to a shift of node ids. Neighbor search, reference bond
+   * data, and weighted volume m_x are then computed only for the first of
+   * these particles and copied to others.
+   *
+   * Only the setup cost is shared. Each particle still stores its own copy of
+   * bonds and bond data, since the fracture state is kept in the bond words
+   * (see geometry::BondList). Storing bonds once per reference particle would
+   * need the fracture state in a separate per-particle bitset and is not
+   * implemented.
+   */
+  bool d_pdShareRefNeighbors;
+
   /*!
    * @brief Constructor
    */
   ModelDeck()
       : d_dim(0), d_isRestartActive(false), d_populateElementNodeConnectivity(false),
         d_tFinal(0.), d_dt(0.), d_Nt(0),
-        d_horizon(0.), d_rh(0), d_h(0.), d_particleSimType(""), d_seed(1), d_quadOrder(1) {};
+        d_horizon(0.), d_rh(0), d_h(0.), d_particleSimType(""), d_seed(1), d_quadOrder(1),
+        d_stepTaskGraph(false), d_pdBondCache(false),
+        d_pdSimdKernel(false), d_mixedPrecision(false), d_pdHalfBonds(false),
+        d_pdBondCompactionThreshold(0.), d_pdBondCompactionInterval(100),
+        d_sleepVelocityThreshold(0.), d_sleepForceThreshold(0.),
+        d_sleepSteps(1000), d_sleepCheckInterval(10),
+        d_contactHalfPairs(false), d_pdShareRefNeighbors(false) {};
 
   /*!
    * @brief Returns the string containing printable information about the object
@@ -135,6 +258,25 @@ struct ModelDeck {
     oss << tabS << "Horizon to mesh size ratio = " << d_rh << std::endl;
     oss << tabS << "Mesh size = " << d_h << std::endl;
     oss << tabS << "Seed = " << d_seed << std::endl;
+    oss << tabS << "Step task graph = " << d_stepTaskGraph << std::endl;
+    oss << tabS << "Peridynamic bond cache = " << d_pdBondCache << std::endl;
+    oss << tabS << "Peridynamic SIMD kernel = " << d_pdSimdKernel << std::endl;
+    oss << tabS << "Mixed precision = " << d_mixedPrecision << std::endl;
+    oss << tabS << "Peridynamic half bonds = " << d_pdHalfBonds << std::endl;
+    oss << tabS << "Peridynamic bond compaction threshold = "
+        << d_pdBondCompactionThreshold << std::endl;
+    oss << tabS << "Peridynamic bond compaction interval = "
+        << d_pdBondCompactionInterval << std::endl;
+    oss << tabS << "Sleep velocity threshold = " << d_sleepVelocityThreshold
+        << std::endl;
+    oss << tabS << "Sleep force threshold = " << d_sleepForceThreshold
+        << std::endl;
+    oss << tabS << "Sleep steps = " << d_sleepSteps << std::endl;
+    oss << tabS << "Sleep check interval = " << d_sleepCheckInterval
+        << std::endl;
+    oss << tabS << "Contact half pairs = " << d_contactHalfPairs << std::endl;
+    oss << tabS << "Peridynamic shared reference neighbors = "
+        << d_pdShareRefNeighbors << std::endl;
     oss << tabS << std::endl;
 
     return oss.str();
@@ -287,6 +287,61 @@ void inp::Input::setModelDeck() {
   // seed for random number generators
   if (config["Model"]["Seed"])
     d_modelDeck_p->d_seed = config["Model"]["Seed"].as<int>();
+
+  // run time step as single task graph
+  if (config["Model"]["Step_Task_Graph"])
+    d_modelDeck_p->d_stepTaskGraph = config["Model"]["Step_Task_Graph"].as<bool>();
+
+  // cache reference quantities of peridynamic bonds
+  if (config["Model"]["PD_Bond_Cache"])
+    d_modelDeck_p->d_pdBondCache = config["Model"]["PD_Bond_Cache"].as<bool>();
+
+  // use vectorized bond kernel
+  if (config["Model"]["PD_SIMD_Kernel"])
+    d_modelDeck_p->d_pdSimdKernel = config["Model"]["PD_SIMD_Kernel"].as<bool>();
+
+  // store bond-level quantities in single precision
+  if (config["Model"]["Mixed_Precision"])
+    d_modelDeck_p->d_mixedPrecision = config["Model"]["Mixed_Precision"].as<bool>();
+
+  // store each peridynamic bond once
+  if (config["Model"]["PD_Half_Bonds"])
+    d_modelDeck_p->d_pdHalfBonds = config["Model"]["PD_Half_Bonds"].as<bool>();
+
+  // compaction of broken peridynamic bonds
+  if (config["Model"]["PD_Bond_Compaction_Threshold"])
+    d_modelDeck_p->d_pdBondCompactionThreshold =
+        config["Model"]["PD_Bond_Compaction_Threshold"].as<double>();
+  if (config["Model"]["PD_Bond_Compaction_Interval"])
+    d_modelDeck_p->d_pdBondCompactionInterval =
+        config["Model"]["PD_Bond_Compaction_Interval"].as<size_t>();
+
+  // sleeping of particles at rest
+  if (config["Model"]["Sleep_Velocity_Threshold"])
+    d_modelDeck_p->d_sleepVelocityThreshold =
+        config["Model"]["Sleep_Velocity_Threshold"].as<double>();
+  if (config["Model"]["Sleep_Force_Threshold"])
+    d_modelDeck_p->d_sleepForceThreshold =
+        config["Model"]["Sleep_Force_Threshold"].as<double>();
+  if (config["Model"]["Sleep_Steps"])
+    d_modelDeck_p->d_sleepSteps = config["Model"]["Sleep_Steps"].as<size_t>();
+  if (config["Model"]["Sleep_Check_Interval"])
+    d_modelDeck_p->d_sleepCheckInterval =
+        config["Model"]["Sleep_Check_Interval"].as<size_t>();
+  if (d_modelDeck_p->d_sleepCheckInterval == 0) {
+    std::cerr << "Error: Sleep_Check_Interval should be positive.\n";
+    exit(1);
+  }
+
+  // evaluate contact force of each pair of nodes once
+  if (config["Model"]["Contact_Half_Pairs"])
+    d_modelDeck_p->d_contactHalfPairs =
+        config["Model"]["Contact_Half_Pairs"].as<bool>();
+
+  // share peridynamic neighborhoods of particles with same reference particle
+  if (config["Model"]["PD_Share_Reference_Neighbors"])
+    d_modelDeck_p->d_pdShareRefNeighbors =
+        config["Model"]["PD_Share_Reference_Neighbors"].as<bool>();
 } // setModelDeck
 
 void inp::Input::setParticleDeck() {
@@ -435,6 +490,21 @@ void inp::Input::setParticleDeck() {
     else
       d_particleDeck_p->d_pNeighDeck.d_updateCriteria = "simple_all";
 
+    if (ne["Search_Method"])
+      d_particleDeck_p->d_pNeighDeck.d_searchMethod =
+              ne["Search_Method"].as<std::string>();
+    else
+      d_particleDeck_p->d_pNeighDeck.d_searchMethod = "nflann_kdtree";
+
+    if (d_particleDeck_p->d_pNeighDeck.d_searchMethod != "nflann_kdtree" and
+        d_particleDeck_p->d_pNeighDeck.d_searchMethod != "cell_list") {
+      std::cerr << "Error: Search_Method = "
+                << d_particleDeck_p->d_pNeighDeck.d_searchMethod
+                << " in Neighbor block is not valid. Use nflann_kdtree or "
+                   "cell_list.\n";
+      exit(1);
+    }
+
     if (ne["Search_Factor"])
       d_particleDeck_p->d_pNeighDeck.d_sFactor =
           ne["Search_Factor"].as<double>();
@@ -446,6 +516,30 @@ void inp::Input::setParticleDeck() {
               ne["Search_Interval"].as<size_t>();
     else
       d_particleDeck_p->d_pNeighDeck.d_neighUpdateInterval = 1;
+
+    if (ne["Skin_Factor"])
+      d_particleDeck_p->d_pNeighDeck.d_skinFactor =
+              ne["Skin_Factor"].as<double>();
+    else
+      d_particleDeck_p->d_pNeighDeck.d_skinFactor = 0.;
+
+    if (ne["Contact_Boundary_Nodes_Only"])
+      d_particleDeck_p->d_pNeighDeck.d_contBoundaryNodesOnly =
+              ne["Contact_Boundary_Nodes_Only"].as<bool>();
+    else
+      d_particleDeck_p->d_pNeighDeck.d_contBoundaryNodesOnly = false;
+
+    if (ne["Tree_Refit"])
+      d_particleDeck_p->d_pNeighDeck.d_treeRefit =
+              ne["Tree_Refit"].as<bool>();
+    else
+      d_particleDeck_p->d_pNeighDeck.d_treeRefit = false;
+
+    if (d_particleDeck_p->d_pNeighDeck.d_skinFactor < 0.) {
+      std::cerr << "Error: Skin_Factor in Neighbor block should be "
+                   "non-negative.\n";
+      exit(1);
+    }
   } else {
     if (isMultiParticle()) {
       std::cout << "Warning: Neighbor block is missing in input yaml file.\n";
@@ -1221,6 +1315,13 @@ void inp::Input::setZoneMeshDeck(std::vector<std::string> s_config,
     }
   }
 
+  // renumber nodes along space-filling curve (zone value overrides value
+  // in Mesh block)
+  if (config["Mesh"]["Node_Ordering"])
+    mesh_deck->d_nodeOrdering = config["Mesh"]["Node_Ordering"].as<std::string>();
+  if (e["Node_Ordering"])
+    mesh_deck->d_nodeOrdering = e["Node_Ordering"].as<std::string>();
+
   if (e["Mesh_Size"]) {
     mesh_deck->d_h = e["Mesh_Size"].as<double>();
     mesh_deck->d_computeMeshSize = false;
@@ -1310,6 +1411,17 @@ void inp::Input::setParticleData(std::string string_zone,
     particle_data->d_createParticleUsingParticleZoneGeomObject
       = pe["Create_Particle_Using_ParticleZone_GeomObject"].as<bool>();
 
+  particle_data->d_analyticWall = false;
+  if (pe["Analytic_Wall"])
+    particle_data->d_analyticWall = pe["Analytic_Wall"].as<bool>();
+
+  if (particle_data->d_analyticWall and
+      (!particle_data->d_isWall or !particle_data->d_allDofsConstrained)) {
+    std::cerr << "Error: Analytic_Wall in zone = " << string_zone
+              << " requires Is_Wall and All_Dofs_Constrained to be true.\n";
+    exit(EXIT_FAILURE);
+  }
+
   if (!isMultiParticle() and !particle_data->d_createParticleUsingParticleZoneGeomObject) {
     // set the flag as true for single particle simulation
     particle_data->d_createParticleUsingParticleZoneGeomObject = true;
@@ -23,6 +23,10 @@ struct PNeighborDeck {
   /*! @brief Neighbor search update criteria (if any) */
   std::string d_updateCriteria;
 
+  /*! @brief Neighbor search method: nflann_kdtree (nanoflann kd-tree) or
+   * cell_list (uniform grid with cell size equal to contact search radius) */
+  std::string d_searchMethod;
+
   /*! @brief Neighbor search factor (search length is factor times biggest
    * radius of particle) */
   double d_sFactor;
@@ -35,14 +39,37 @@ struct PNeighborDeck {
   /*! @brief Neighbor update time interval (for contact) */
   size_t d_neighUpdateInterval;
 
+  /*! @brief Skin factor for contact neighborlist (skin is factor times
+   * biggest contact radius). If positive, contact neighborlist is built with
+   * radius contact radius + skin and is rebuilt only when maximum
+   * displacement of nodes since last build exceeds half of skin.
+   * d_sFactor and d_neighUpdateInterval are not used in this case. */
+  double d_skinFactor;
+
+  /*! @brief If true, only nodes within contact radius (plus mesh size) of
+   * boundary of mesh of particle are used in contact search. Boundary is
+   * found from element data of mesh in reference configuration, so new
+   * surfaces due to fracture do not take part in contact. */
+  bool d_contBoundaryNodesOnly;
+
+  /*! @brief If true, kd-tree for contact search is refitted (split bounds
+   * recomputed from current positions) instead of rebuilt when contact
+   * neighborlist is updated. Tree is rebuilt when refit is not possible or
+   * when quality of tree has degraded. */
+  bool d_treeRefit;
+
   /*!
    * @brief Constructor
    */
   PNeighborDeck()
       : d_updateCriteria("simple_all"),
+        d_searchMethod("nflann_kdtree"),
         d_sFactor(1.),
         d_sTol(0.),
-        d_neighUpdateInterval(1) {};
+        d_neighUpdateInterval(1),
+        d_skinFactor(0.),
+        d_contBoundaryNodesOnly(false),
+        d_treeRefit(false) {};
 
   /*!
    * @brief Returns the string containing printable information about the object
@@ -57,9 +84,13 @@ struct PNeighborDeck {
     std::ostringstream oss;
     oss << tabS << "------- PNeighborDeck --------" << std::endl << std::endl;
     oss << tabS << "Update criteria  = " << d_updateCriteria << std::endl;
+    oss << tabS << "Search method = " << d_searchMethod << std::endl;
     oss << tabS << "Search factor = " << d_sFactor << std::endl;
     oss << tabS << "Search tolerance = " << d_sTol << std::endl;
     oss << tabS << "Search update interval = " << d_neighUpdateInterval << std::endl;
+    oss << tabS << "Skin factor = " << d_skinFactor << std::endl;
+    oss << tabS << "Contact boundary nodes only = " << d_contBoundaryNodesOnly << std::endl;
+    oss << tabS << "Tree refit = " << d_treeRefit << std::endl;
     oss << tabS << std::endl;
 
     return oss.str();
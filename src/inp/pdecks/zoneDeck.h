@@ -141,6 +141,17 @@ struct ParticleZone {
    */
   bool d_createParticleUsingParticleZoneGeomObject;
 
+  /*!
+   * @brief Specify if wall is analytic, i.e., contact of particles with the
+   * wall is computed from the signed distance to the geometry object of the
+   * wall (see util::geometry::GeomObject::signedDistance()) and nodes of
+   * wall are not used in contact search. Wall should be rigid (all dofs
+   * constrained) and may be translated and rotated about z-axis using
+   * displacement loading. Translation and rotation are found from the
+   * current position of nodes of wall.
+   */
+  bool d_analyticWall;
+
   /*!
    * @brief Constructor
    */
@@ -158,7 +169,8 @@ struct ParticleZone {
         d_meshFlag(true),
         d_allDofsConstrained(false),
         d_nearBdNodesTol(0.5),
-        d_createParticleUsingParticleZoneGeomObject (false)
+        d_createParticleUsingParticleZoneGeomObject (false),
+        d_analyticWall(false)
         {};
 
   /*!
@@ -180,7 +192,8 @@ struct ParticleZone {
         d_meshFlag(pz.d_meshFlag),
         d_allDofsConstrained(pz.d_allDofsConstrained),
         d_nearBdNodesTol(pz.d_nearBdNodesTol),
-        d_createParticleUsingParticleZoneGeomObject(pz.d_createParticleUsingParticleZoneGeomObject)
+        d_createParticleUsingParticleZoneGeomObject(pz.d_createParticleUsingParticleZoneGeomObject),
+        d_analyticWall(pz.d_analyticWall)
         {};
 
   /*!
@@ -203,6 +216,7 @@ struct ParticleZone {
     oss << tabS << "Mesh flag = " << d_meshFlag << std::endl;
     oss << tabS << "All dofs constrained = " << d_allDofsConstrained << std::endl;
     oss << tabS << "d_createParticleUsingParticleZoneGeomObject = " << d_createParticleUsingParticleZoneGeomObject << std::endl;
+    oss << tabS << "Analytic wall = " << d_analyticWall << std::endl;
     oss << tabS << "Particle geometry details: " << std::endl;
     oss << d_particleGeomData.printStr(nt+1, lvl);
     oss << tabS << "Reference rarticle geometry details: " << std::endl;
@@ -98,7 +98,6 @@ void loading::ParticleFLoading::apply(const double &time,
     auto reg_box = bc.d_regionGeomData.d_geom_p->box();
 
     // for (size_t i = 0; i < particle->getNumNodes(); i++) {
-    tf::Executor executor(util::parallel::getNThreads());
     tf::Taskflow taskflow;
 
     taskflow.for_each_index(
@@ -169,6 +168,6 @@ void loading::ParticleFLoading::apply(const double &time,
             }
     ); // for_each
 
-    executor.run(taskflow).get();
+    util::parallel::runTaskflow(taskflow);
   } // loop over bc sets
 }
\ No newline at end of file
@@ -14,6 +14,7 @@
 #include "particle/baseParticle.h"
 #include "util/function.h"
 #include "util/geom.h"
+#include "util/parallelUtil.h"
 #include "util/transformation.h"
 #include <taskflow/taskflow/taskflow.hpp>
 #include <taskflow/taskflow/algorithm/for_each.hpp>
@@ -137,7 +138,6 @@ void loading::ParticleULoading::apply(const double &time,
     auto reg_box = bc.d_regionGeomData.d_geom_p->box();
 
     // for (size_t i = 0; i < particle->getNumNodes(); i++) {
-    tf::Executor executor(util::parallel::getNThreads());
     tf::Taskflow taskflow;
 
     taskflow.for_each_index(
@@ -226,6 +226,6 @@ void loading::ParticleULoading::apply(const double &time,
             }
     ); // for_each
 
-    executor.run(taskflow).get();
+    util::parallel::runTaskflow(taskflow);
   } // loop over bc sets
 }
\ No newline at end of file
@@ -18,27 +18,25 @@
 
 namespace {
 
-double computeStateMxI(size_t i, const std::vector<util::Point> &nodes,
+double computeStateMxI(size_t i, const util::PointSoA &nodes,
                        const std::vector<double> &nodal_vol,
-                       const std::vector<std::vector<size_t>> &neighbors,
-                       const std::vector<std::vector<float>> &neighbors_sq_dist,
+                       const geometry::BondList &bonds,
                        const double &mesh_size,
                        const material::Material *material) {
 
   double horizon = material->getHorizon();
-  const auto &xi = nodes[i];
+  const auto xi = nodes.get(i);
   double m = 0.;
 
   // upper and lower bound for volume correction
   auto check_up = horizon + 0.5 * mesh_size;
   auto check_low = horizon - 0.5 * mesh_size;
 
-  size_t k = 0;
-  for (size_t j : neighbors[i]) {
+  for (size_t b = bonds.begin(i); b < bonds.end(i); b++) {
 
-    const auto &xj = nodes[j];
+    const auto j = bonds.getNeighbor(b);
+    const auto xj = nodes.get(j);
     double rji = (xj - xi).length();
-    //double rji = std::sqrt(neighbors_sq_dist[i][k]);
 
     if (util::isGreater(rji, horizon)) // or j == i) <-- check! For weighted volume, we don't want to skip the node itself
       continue;
@@ -50,8 +48,6 @@ double computeStateMxI(size_t i, const std::vector<util::Point> &nodes,
       volj *= (check_up - rji) / mesh_size;
 
     m += std::pow(rji, 2) * material->getInfFn(rji) * volj;
-
-    k++;
   }
 
   if (util::isLess(m, 1.0E-18)) {
@@ -72,19 +68,17 @@ double computeStateMxI(size_t i, const std::vector<util::Point> &nodes,
   return m;
 }
 
-double computeStateThetaxI(size_t i, const std::vector<util::Point> &nodes,
-                           const std::vector<util::Point> &nodes_disp,
+double computeStateThetaxI(size_t i, const util::PointSoA &nodes,
+                           const util::PointSoA &nodes_disp,
                            const std::vector<double> &nodal_vol,
-                           const std::vector<std::vector<size_t>> &neighbors,
-                           const std::vector<std::vector<float>> &neighbors_sq_dist,
+                           const geometry::BondList &bonds,
                            const double &mesh_size,
                            const material::Material *material,
-                           const geometry::Fracture *fracture,
                            const std::vector<double> &mx) {
 
   double horizon = material->getHorizon();
-  const auto &xi = nodes[i];
-  const auto &ui = nodes_disp[i];
+  const auto xi = nodes.get(i);
+  const auto ui = nodes_disp.get(i);
   double m = mx[i];
   double theta = 0.;
 
@@ -92,14 +86,12 @@ double computeStateThetaxI(size_t i, const std::vector<util::Point> &nodes,
   auto check_up = horizon + 0.5 * mesh_size;
   auto check_low = horizon - 0.5 * mesh_size;
 
-  size_t k = 0;
-  for (size_t j : neighbors[i]) {
+  for (size_t b = bonds.begin(i); b < bonds.end(i); b++) {
 
-    const auto &xj = nodes[j];
-    const auto &uj = nodes_disp[j];
+    const auto j = bonds.getNeighbor(b);
+    const auto xj = nodes.get(j);
+    const auto uj = nodes_disp.get(j);
     double rji = (xj - xi).length();
-    //double rji = std::sqrt(neighbors_sq_dist[i][k]); // distance in
-                                                      // reference configuration
 
     if (util::isGreater(rji, horizon) or j == i)
       continue;
@@ -111,7 +103,7 @@ double computeStateThetaxI(size_t i, const std::vector<util::Point> &nodes,
       volj *= (check_up - rji) / mesh_size;
 
     // get bond state
-    double bond_state = fracture->getBondState(i, k) ? 0. : 1.;
+    double bond_state = bonds.getBondState(b) ? 0. : 1.;
 
     // get change in bond length
     auto yi = xi + ui;
@@ -120,26 +112,22 @@ double computeStateThetaxI(size_t i, const std::vector<util::Point> &nodes,
 
     theta += bond_state * rji * change_length *
              material->getInfFn(rji) * volj;
-
-    k += 1;
   }
 
   return 3. * theta / m;
 }
 
-double computeHydrostaticStrainI(size_t i, const std::vector<util::Point> &nodes,
-                           const std::vector<util::Point> &nodes_disp,
+double computeHydrostaticStrainI(size_t i, const util::PointSoA &nodes,
+                           const util::PointSoA &nodes_disp,
                            const std::vector<double> &nodal_vol,
-                                 const std::vector<std::vector<size_t>> &neighbors,
-                                 const std::vector<std::vector<float>> &neighbors_sq_dist,
+                                 const geometry::BondList &bonds,
                            const double &mesh_size,
                            const material::Material *material,
-                           const geometry::Fracture *fracture,
                            size_t dim) {
 
   double horizon = material->getHorizon();
-  const auto &xi = nodes[i];
-  const auto &ui = nodes_disp[i];
+  const auto xi = nodes.get(i);
+  const auto ui = nodes_disp.get(i);
   double theta = 0.;
 
   // upper and lower bound for volume correction
@@ -151,13 +139,12 @@ double computeHydrostaticStrainI(size_t i, const std::vector<util::Point> &nodes
   if (dim == 3)
     vol_ball *= horizon * 4. / 3.;
 
-  size_t k = 0;
-  for (size_t j : neighbors[i]) {
+  for (size_t b = bonds.begin(i); b < bonds.end(i); b++) {
 
-    const auto &xj = nodes[j];
-    const auto &uj = nodes_disp[j];
+    const auto j = bonds.getNeighbor(b);
+    const auto xj = nodes.get(j);
+    const auto uj = nodes_disp.get(j);
     double rji = (xj - xi).length();
-    //double rji = std::sqrt(neighbors_sq_dist[i][k]);
 
     if (util::isGreater(rji, horizon) or j == i)
       continue;
@@ -169,40 +156,36 @@ double computeHydrostaticStrainI(size_t i, const std::vector<util::Point> &nodes
       volj *= (check_up - rji) / mesh_size;
 
     // get bond state
-    double bond_state = fracture->getBondState(i, k) ? 0. : 1.;
+    double bond_state = bonds.getBondState(b) ? 0. : 1.;
 
     // get bond strain
     double Sji = material->getS(xj - xi, uj - ui);
 
     theta += bond_state * rji * Sji *
              material->getInfFn(rji) * volj / vol_ball;
-
-    k += 1;
   }
 
   return theta;
 }
 
-void updateBondFractureDataI(size_t i, const std::vector<util::Point> &nodes,
-                             const std::vector<std::vector<size_t>> &neighbors,
-                                 const std::vector<util::Point> &nodes_disp,
-                                 const material::Material *material,
-                                 geometry::Fracture *fracture) {
+void updateBondFractureDataI(size_t i, const util::PointSoA &nodes,
+                             geometry::BondList &bonds,
+                                 const util::PointSoA &nodes_disp,
+                                 const material::Material *material) {
 
-  size_t k = 0;
-  for (size_t j : neighbors[i]) {
+  for (size_t b = bonds.begin(i); b < bonds.end(i); b++) {
 
-    double s = material->getS(nodes[j] - nodes[i], nodes_disp[j] -
-    nodes_disp[i]);
-    double sc = material->getSc((nodes[j] - nodes[i]).length());
+    const auto j = bonds.getNeighbor(b);
+    const auto xi = nodes.get(i);
+    const auto xj = nodes.get(j);
+    double s = material->getS(xj - xi, nodes_disp.get(j) - nodes_disp.get(i));
+    double sc = material->getSc((xj - xi).length());
 
     // get fracture state, modify, and set
-    auto fs = fracture->getBondState(i, k);
+    auto fs = bonds.getBondState(b);
     if (!fs && util::isGreater(std::abs(s), sc + 1.0e-10))
       fs = true;
-    fracture->setBondState(i, k, fs);
-
-    k += 1;
+    bonds.setBondState(b, fs);
   }
 }
 
@@ -210,13 +193,18 @@ void updateBondFractureDataI(size_t i, const std::vector<util::Point> &nodes,
 
 void material::computeStateMx(model::ModelData *model, bool compute_in_parallel) {
 
+  // nodes whose neighborhood is copied from other node copy m_x of that node
+  // below (see inp::ModelDeck::d_pdShareRefNeighbors)
   model->d_mX.resize(model->d_x.size());
   if (!compute_in_parallel) {
     for (size_t i = 0; i < model->d_x.size(); i++) {
+      if (model->getPdRefNode(i) != i)
+        continue;
+
       const auto &pti = model->getPtId(i);
       const auto &particle = model->getParticleFromAllList(pti);
       auto mx = computeStateMxI(i, model->d_xRef, model->d_vol,
-                                model->d_neighPd, model->d_neighPdSqdDist,
+                                model->d_bondsPd,
                                 particle->getMeshSize(),
                                 particle->getMaterial());
 
@@ -224,15 +212,17 @@ void material::computeStateMx(model::ModelData *model, bool compute_in_parallel)
     }
   } else {
 
-    tf::Executor executor(util::parallel::getNThreads());
     tf::Taskflow taskflow;
 
     taskflow.for_each_index(
       (std::size_t) 0, model->d_x.size(), (std::size_t) 1, [model](std::size_t i) {
+        if (model->getPdRefNode(i) != i)
+          return;
+
         const auto &pti = model->getPtId(i);
         const auto &particle = model->getParticleFromAllList(pti);
         auto mx = computeStateMxI(i, model->d_xRef, model->d_vol,
-                                  model->d_neighPd, model->d_neighPdSqdDist,
+                                  model->d_bondsPd,
                                   particle->getMeshSize(),
                                   particle->getMaterial());
 
@@ -240,8 +230,15 @@ void material::computeStateMx(model::ModelData *model, bool compute_in_parallel)
       }
     ); // for_each
 
-    executor.run(taskflow).get();
+    util::parallel::runTaskflow(taskflow);
   }
+
+  if (!model->d_pdRefParticle.empty())
+    for (size_t i = 0; i < model->d_x.size(); i++) {
+      const auto r = model->getPdRefNode(i);
+      if (r != i)
+        model->setMx(i, model->getMx(r));
+    }
 }
 
 void material::computeStateThetax(model::ModelData *model, bool compute_in_parallel) {
@@ -254,10 +251,9 @@ void material::computeStateThetax(model::ModelData *model, bool compute_in_paral
 
       auto thetax = computeStateThetaxI(i, model->d_xRef, model->d_u,
                                         model->d_vol,
-                                        model->d_neighPd, model->d_neighPdSqdDist,
+                                        model->d_bondsPd,
                                         particle->getMeshSize(),
                                       particle->getMaterial(),
-                                        model->d_fracture_p.get(),
                                         model->d_mX);
 
       model->setThetax(i, thetax);
@@ -266,7 +262,6 @@ void material::computeStateThetax(model::ModelData *model, bool compute_in_paral
 
   } else {
 
-    tf::Executor executor(util::parallel::getNThreads());
     tf::Taskflow taskflow;
 
     taskflow.for_each_index(
@@ -276,17 +271,16 @@ void material::computeStateThetax(model::ModelData *model, bool compute_in_paral
 
         auto thetax = computeStateThetaxI(i, model->d_xRef, model->d_u,
                                           model->d_vol,
-                                          model->d_neighPd, model->d_neighPdSqdDist,
+                                          model->d_bondsPd,
                                           particle->getMeshSize(),
                                           particle->getMaterial(),
-                                          model->d_fracture_p.get(),
-                                          model->d_mX);
+                                            model->d_mX);
 
         model->setThetax(i, thetax);
       }
     ); // for_each
 
-    executor.run(taskflow).get();
+    util::parallel::runTaskflow(taskflow);
   }
 }
 
@@ -300,17 +294,15 @@ void material::computeHydrostaticStrain(model::ModelData *model, bool compute_in
 
       auto thetax = computeHydrostaticStrainI(i, model->d_xRef, model->d_u,
                                         model->d_vol,
-                                        model->d_neighPd, model->d_neighPdSqdDist,
+                                        model->d_bondsPd,
                                         particle->getMeshSize(),
                                         particle->getMaterial(),
-                                        model->d_fracture_p.get(),
                                         particle->getDimension());
 
       model->setThetax(i, thetax);
     }
   } else {
 
-    tf::Executor executor(util::parallel::getNThreads());
     tf::Taskflow taskflow;
 
     taskflow.for_each_index(
@@ -322,17 +314,16 @@ void material::computeHydrostaticStrain(model::ModelData *model, bool compute_in
           model->d_xRef, 
           model->d_u,
           model->d_vol,
-          model->d_neighPd, model->d_neighPdSqdDist,
+          model->d_bondsPd,
           particle->getMeshSize(),
           particle->getMaterial(),
-          model->d_fracture_p.get(),
           particle->getDimension());
 
         model->setThetax(i, thetax);
       }
     ); // for_each
 
-    executor.run(taskflow).get();
+    util::parallel::runTaskflow(taskflow);
   }
 
 }
@@ -344,13 +335,11 @@ void material::updateBondFractureData(model::ModelData *model, bool compute_in_p
       const auto &pti = model->getPtId(i);
       const auto &particle = model->getParticleFromAllList(pti);
 
-      updateBondFractureDataI(i, model->d_xRef, model->d_neighPd, model->d_u,
-                              particle->getMaterial(),
-                                              model->d_fracture_p.get());
+      updateBondFractureDataI(i, model->d_xRef, model->d_bondsPd, model->d_u,
+                              particle->getMaterial());
     }
   } else {
 
-    tf::Executor executor(util::parallel::getNThreads());
     tf::Taskflow taskflow;
 
     taskflow.for_each_index(
@@ -360,13 +349,12 @@ void material::updateBondFractureData(model::ModelData *model, bool compute_in_p
 
         updateBondFractureDataI(i, 
           model->d_xRef, 
-          model->d_neighPd, 
+          model->d_bondsPd, 
           model->d_u,
-          particle->getMaterial(),
-          model->d_fracture_p.get());
+          particle->getMaterial());
       }
     ); // for_each
 
-    executor.run(taskflow).get();
+    util::parallel::runTaskflow(taskflow);
   }
 }
@@ -18,10 +18,6 @@ material::ConstInfluenceFn::ConstInfluenceFn(
   d_a0 = params.empty() ? double(dim + 1) : params[0];
 }
 
-double material::ConstInfluenceFn::getInfFn(const double &r) const {
-  return d_a0;
-}
-
 double material::ConstInfluenceFn::getMoment(const size_t &i) const {
   return d_a0 / double(i + 1);
 }
@@ -52,10 +48,6 @@ material::LinearInfluenceFn::LinearInfluenceFn(
   }
 }
 
-double material::LinearInfluenceFn::getInfFn(const double &r) const {
-  return d_a0 + d_a1 * r;
-}
-
 double material::LinearInfluenceFn::getMoment(const size_t &i) const {
   return (d_a0 / double(i + 1)) + (d_a1 / double(i + 2));
 }
@@ -83,10 +75,6 @@ material::GaussianInfluenceFn::GaussianInfluenceFn(
   }
 }
 
-double material::GaussianInfluenceFn::getInfFn(const double &r) const {
-  return d_alpha * std::exp(-r * r / d_beta);
-}
-
 double material::GaussianInfluenceFn::getMoment(const size_t &i) const {
 
   double sq1 = std::sqrt(d_beta);
@@ -12,6 +12,7 @@
 #define MATERIAL_PD_INFLUENCEFN_H
 
 #include "util/io.h"
+#include <cmath>
 #include <cstring>
 #include <iostream>
 #include <vector>
@@ -76,7 +77,7 @@ public:
 };
 
 /*! @brief A class to implement constant influence function */
-class ConstInfluenceFn : public BaseInfluenceFn {
+class ConstInfluenceFn final : public BaseInfluenceFn {
 
 public:
   /*!
@@ -92,7 +93,9 @@ public:
    * @param r Reference (initial) bond length
    * @return value Influence function at r
    */
-  double getInfFn(const double &r) const override;
+  double getInfFn(const double &r) const override {
+    return d_a0;
+  };
 
   /*!
    * @brief Returns the moment of influence function
@@ -148,7 +151,7 @@ private:
  *
  * \f$ J(r) = a0 + a1 r \f$
  */
-class LinearInfluenceFn : public BaseInfluenceFn {
+class LinearInfluenceFn final : public BaseInfluenceFn {
 
 public:
   /*!
@@ -164,7 +167,9 @@ public:
    * @param r Reference (initial) bond length
    * @return value Influence function at r
    */
-  double getInfFn(const double &r) const override;
+  double getInfFn(const double &r) const override {
+    return d_a0 + d_a1 * r;
+  };
 
   /*!
    * @brief Returns the moment of influence function
@@ -224,7 +229,7 @@ private:
  *
  * \f$ J(r) = \alpha \exp(-r^2/\beta) \f$
  */
-class GaussianInfluenceFn : public BaseInfluenceFn {
+class GaussianInfluenceFn final : public BaseInfluenceFn {
 
 public:
   /*!
@@ -240,7 +245,9 @@ public:
    * @param r Reference (initial) bond length
    * @return value Influence function at r
    */
-  double getInfFn(const double &r) const override;
+  double getInfFn(const double &r) const override {
+    return d_alpha * std::exp(-r * r / d_beta);
+  };
 
   /*!
    * @brief Returns the moment of influence function
@@ -140,6 +140,42 @@ public:
   getBondEF(const double &r, const double &s, bool &fs, const double
   &mx, const double &thetax) const = 0;
 
+  /*!
+   * @brief Returns energy and force between bond due to pairwise interaction
+   * for given value of influence function
+   *
+   * Same as getBondEF() except that the influence function at r is provided
+   * by the caller. This lets the force kernels evaluate the influence
+   * function without virtual calls.
+   *
+   * @param J Influence function at r
+   * @param r Reference (initial) bond length
+   * @param s Bond strain
+   * @param fs Bond fracture state
+   * @param break_bonds Flag to specify whether bonds are allowed to break or not
+   * @return value Pair of energy and force
+   */
+  virtual std::pair<double, double>
+  getBondEFWithInfFn(const double &J, const double &r, const double &s,
+                     bool &fs, const bool &break_bonds) const = 0;
+
+  /*!
+   * @brief Returns energy and force between bond due to state-based model
+   * for given value of influence function
+   *
+   * @param J Influence function at r
+   * @param r Reference (initial) bond length
+   * @param s Bond strain
+   * @param fs Bond fracture state
+   * @param mx Weighted volume at node
+   * @param thetax Dilation
+   * @return value Pair of energy and force
+   */
+  virtual std::pair<double, double>
+  getBondEFWithInfFn(const double &J, const double &r, const double &s,
+                     bool &fs, const double &mx,
+                     const double &thetax) const = 0;
+
   /*!
    * @brief Returns the unit vector along which bond-force acts
    *
@@ -239,6 +275,16 @@ public:
   /*! @brief Prints the information about the object */
   virtual void print() const { print(0, 0); }
 
+  /*!
+   * @brief Returns the influence function used by the material
+   * @return fn Pointer to influence function
+   */
+  const BaseInfluenceFn *getInfluenceFn() const { return d_influenceFn_p.get(); }
+
+protected:
+  /*! @brief Influence function (shared by all materials) */
+  std::shared_ptr<BaseInfluenceFn> d_influenceFn_p;
+
 private:
   /*! @brief Name of the material */
   std::string d_name;
@@ -248,7 +294,7 @@ private:
  * @brief A class providing methods to compute energy density and force of
  * peridynamic material
  */
-class RnpMaterial : public Material {
+class RnpMaterial final : public Material {
 
 public:
   /*!
@@ -292,6 +338,7 @@ public:
                 << " is invalid.\n";
       exit(1);
     }
+    d_influenceFn_p = influence_fn;
 
     if (dim == 1)
       d_invFactor = std::pow(horizon, 2) * 2.;
@@ -343,6 +390,17 @@ public:
                                       bool &fs,
                                       const bool &break_bonds) const override {
 
+    return getBondEFWithInfFn(getInfFn(r), r, s, fs, break_bonds);
+  };
+
+  /*!
+   * @brief Returns energy and force between bond for given value of
+   * influence function (see getBondEF())
+   */
+  std::pair<double, double>
+  getBondEFWithInfFn(const double &J, const double &r, const double &s,
+                     bool &fs, const bool &break_bonds) const override {
+
     if (break_bonds) {
       // check if fracture state of the bond need to be updated
       if (d_irrevBondBreak && !fs &&
@@ -353,16 +411,16 @@ public:
       // potential otherwise return energy of fractured bond, and zero force
       if (!fs)
         return std::make_pair(
-            getInfFn(r) * d_C *
+            J * d_C *
                 (1. - std::exp(-d_beta * r * s * s)) / d_invFactor,
-            getInfFn(r) * 4. * s * d_C * d_beta *
+            J * 4. * s * d_C * d_beta *
                 std::exp(-d_beta * r * s * s) / d_invFactor);
       else
         return std::make_pair(d_C / d_invFactor, 0.);
     } else {
-      return std::make_pair(getInfFn(r) * d_C * d_beta *
+      return std::make_pair(J * d_C * d_beta *
                                 r * s * s / d_invFactor,
-                            getInfFn(r) * 4. * s * d_C *
+                            J * 4. * s * d_C *
                                 d_beta / d_invFactor);
     }
   };
@@ -381,7 +439,19 @@ public:
   getBondEF(const double &r, const double &s, bool &fs, const double
   &mx, const double &thetax) const override {
 
-    return this->getBondEF(r, s, fs, true);
+    return getBondEFWithInfFn(getInfFn(r), r, s, fs, mx, thetax);
+  };
+
+  /*!
+   * @brief Returns energy and force between bond for given value of
+   * influence function (see getBondEF())
+   */
+  std::pair<double, double>
+  getBondEFWithInfFn(const double &J, const double &r, const double &s,
+                     bool &fs, const double &mx,
+                     const double &thetax) const override {
+
+    return this->getBondEFWithInfFn(J, r, s, fs, true);
   };
 
   /*!
@@ -662,7 +732,7 @@ private:
  * @brief A class providing methods to compute energy density and force of
  * peridynamic material
  */
-class PmbMaterial : public Material {
+class PmbMaterial final : public Material {
 
 public:
   /*!
@@ -704,6 +774,7 @@ public:
                 << " is invalid.\n";
       exit(1);
     }
+    d_influenceFn_p = influence_fn;
 
     // check if we need to compute the material parameters
     if (deck.d_computeParamsFromElastic)
@@ -733,10 +804,21 @@ public:
                                       bool &fs,
                                       const bool &break_bonds) const override {
 
+    return getBondEFWithInfFn(getInfFn(r), r, s, fs, break_bonds);
+  };
+
+  /*!
+   * @brief Returns energy and force between bond for given value of
+   * influence function (see getBondEF())
+   */
+  std::pair<double, double>
+  getBondEFWithInfFn(const double &J, const double &r, const double &s,
+                     bool &fs, const bool &break_bonds) const override {
+
     if (!break_bonds)
-      return std::make_pair(getInfFn(r) * 0.5 * d_c * s *
+      return std::make_pair(J * 0.5 * d_c * s *
                                 s * r,
-                            getInfFn(r) * d_c * s);
+                            J * d_c * s);
 
     // check if fracture state of the bond need to be updated
     if (!fs && util::isGreater(std::abs(s), d_s0 + 1.0e-10))
@@ -745,12 +827,12 @@ public:
     // if bond is not fractured, return energy and force from nonlinear
     // potential otherwise return energy of fractured bond, and zero force
     if (!fs)
-      return std::make_pair(getInfFn(r) * 0.5 * d_c * s *
+      return std::make_pair(J * 0.5 * d_c * s *
                                 s * r,
-                            getInfFn(r) * d_c * s);
+                            J * d_c * s);
     else
       return std::make_pair(
-          getInfFn(r) * 0.5 * d_c * d_s0 * d_s0 * r, 0.);
+          J * 0.5 * d_c * d_s0 * d_s0 * r, 0.);
   };
 
   /*!
@@ -767,7 +849,19 @@ public:
   getBondEF(const double &r, const double &s, bool &fs, const double
   &mx, const double &thetax) const override {
 
-    return this->getBondEF(r, s, fs, true);
+    return getBondEFWithInfFn(getInfFn(r), r, s, fs, mx, thetax);
+  };
+
+  /*!
+   * @brief Returns energy and force between bond for given value of
+   * influence function (see getBondEF())
+   */
+  std::pair<double, double>
+  getBondEFWithInfFn(const double &J, const double &r, const double &s,
+                     bool &fs, const double &mx,
+                     const double &thetax) const override {
+
+    return this->getBondEFWithInfFn(J, r, s, fs, true);
   };
 
   /*!
@@ -792,6 +886,14 @@ public:
     return ((dx + du).length() - dx.length()) / dx.length();
   };
 
+  /*!
+   * @brief Returns bond stiffness (force of bond is
+   * \f$ J(r) c s \f$ for influence function \f$ J \f$ and strain \f$ s \f$)
+   *
+   * @return c Bond stiffness
+   */
+  double getC() const { return d_c; };
+
   /*!
    * @brief Returns critical bond strain
    *
@@ -1022,7 +1124,7 @@ private:
  * @brief A class providing methods to compute energy density and force of
  * peridynamic material
  */
-class PdElastic : public Material {
+class PdElastic final : public Material {
 
 public:
   /*!
@@ -1064,6 +1166,7 @@ public:
                 << " is invalid.\n";
       exit(1);
     }
+    d_influenceFn_p = influence_fn;
 
     // check if we need to compute the material parameters
     if (deck.d_computeParamsFromElastic)
@@ -1091,9 +1194,20 @@ public:
                                       bool &fs,
                                       const bool &break_bonds) const override {
 
-    return std::make_pair(getInfFn(r) * 0.5 * d_c * s *
+    return getBondEFWithInfFn(getInfFn(r), r, s, fs, break_bonds);
+  };
+
+  /*!
+   * @brief Returns energy and force between bond for given value of
+   * influence function (see getBondEF())
+   */
+  std::pair<double, double>
+  getBondEFWithInfFn(const double &J, const double &r, const double &s,
+                     bool &fs, const bool &break_bonds) const override {
+
+    return std::make_pair(J * 0.5 * d_c * s *
                             s * r,
-                          getInfFn(r) * d_c * s);
+                          J * d_c * s);
   };
 
   /*!
@@ -1110,7 +1224,19 @@ public:
   getBondEF(const double &r, const double &s, bool &fs, const double
   &mx, const double &thetax) const override {
 
-    return this->getBondEF(r, s, fs, true);
+    return getBondEFWithInfFn(getInfFn(r), r, s, fs, mx, thetax);
+  };
+
+  /*!
+   * @brief Returns energy and force between bond for given value of
+   * influence function (see getBondEF())
+   */
+  std::pair<double, double>
+  getBondEFWithInfFn(const double &J, const double &r, const double &s,
+                     bool &fs, const double &mx,
+                     const double &thetax) const override {
+
+    return this->getBondEFWithInfFn(J, r, s, fs, true);
   };
 
   /*!
@@ -1135,6 +1261,14 @@ public:
     return ((dx + du).length() - dx.length()) / dx.length();
   };
 
+  /*!
+   * @brief Returns bond stiffness (force of bond is
+   * \f$ J(r) c s \f$ for influence function \f$ J \f$ and strain \f$ s \f$)
+   *
+   * @return c Bond stiffness
+   */
+  double getC() const { return d_c; };
+
   /*!
    * @brief Returns critical bond strain
    *
@@ -1327,7 +1461,7 @@ private:
  * @brief A class providing methods to compute energy density and force of
  * peridynamic material
  */
-class PdState : public Material {
+class PdState final : public Material {
 
 public:
   /*!
@@ -1369,6 +1503,7 @@ public:
                 << " is invalid.\n";
       exit(1);
     }
+    d_influenceFn_p = influence_fn;
 
     // check if we need to compute the material parameters
     if (deck.d_computeParamsFromElastic)
@@ -1399,6 +1534,17 @@ public:
                                       bool &fs,
                                       const bool &break_bonds) const override {
 
+    return getBondEFWithInfFn(getInfFn(r), r, s, fs, break_bonds);
+  };
+
+  /*!
+   * @brief Returns energy and force between bond for given value of
+   * influence function (see getBondEF())
+   */
+  std::pair<double, double>
+  getBondEFWithInfFn(const double &J, const double &r, const double &s,
+                     bool &fs, const bool &break_bonds) const override {
+
     return {0., 0.};
   };
 
@@ -1416,10 +1562,21 @@ public:
   getBondEF(const double &r, const double &s, bool &fs, const double
   &mx, const double &thetax) const override {
 
+    return getBondEFWithInfFn(getInfFn(r), r, s, fs, mx, thetax);
+  };
+
+  /*!
+   * @brief Returns energy and force between bond for given value of
+   * influence function (see getBondEF())
+   */
+  std::pair<double, double>
+  getBondEFWithInfFn(const double &J, const double &r, const double &s,
+                     bool &fs, const double &mx,
+                     const double &thetax) const override {
+
     if (fs)
       return {0., 0.};
 
-    double J = getInfFn(r);
     double change_length = s * r;
 
     double alpha = 15. * d_G / mx;
@@ -0,0 +1,505 @@
+/*
+ * -------------------------------------------
+ * Copyright (c) 2021 - 2024 Prashant K. Jha
+ * -------------------------------------------
+ * PeriDEM https://github.com/prashjha/PeriDEM
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE)
+ */
+
+#include "pdForceKernel.h"
+#include "pdSimdKernel.h"
+#include "model/modelData.h"
+#include "particle/baseParticle.h"
+#include "util/function.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace {
+
+/*!
+ * @brief Returns influence function at reference bond length r
+ *
+ * For known influence function type, the function is evaluated directly
+ * without virtual call.
+ */
+template <class MaterialType, class InfFnType>
+inline double getInfFn(const MaterialType &material, const InfFnType *inf_fn,
+                       const double &r) {
+  if constexpr (std::is_same_v<InfFnType, material::BaseInfluenceFn>)
+    return material.getInfFn(r);
+  else
+    return inf_fn->getInfFn(r / material.getHorizon());
+}
+
+/*! @brief Pointers to cached reference quantities of bonds */
+template <class RealType> struct BondCache {
+  const RealType *d_length;
+  const RealType *d_volume;
+  const RealType *d_infFn;
+  const RealType *d_sc;
+};
+
+/*!
+ * @brief Returns cached reference quantities of bonds stored in double
+ * (RealType = double) or single (RealType = float) precision
+ */
+template <class RealType>
+inline BondCache<RealType> getBondCache(const model::ModelData *model) {
+  if constexpr (std::is_same_v<RealType, float>)
+    return {model->d_bondsPdLengthF.data(), model->d_bondsPdVolumeF.data(),
+            model->d_bondsPdInfFnF.data(), model->d_bondsPdScF.data()};
+  else
+    return {model->d_bondsPdLength.data(), model->d_bondsPdVolume.data(),
+            model->d_bondsPdInfFn.data(), model->d_bondsPdSc.data()};
+}
+
+template <class MaterialType, class InfFnType, class RealType>
+void computeStateNode(model::ModelData *model, size_t i, bool use_cache) {
+
+  const auto &pi = model->getParticleFromAllList(model->getPtId(i));
+  const auto &material =
+      static_cast<const MaterialType &>(*pi->getMaterial());
+  const auto *inf_fn =
+      static_cast<const InfFnType *>(material.getInfluenceFn());
+
+  if (!material.isStateActive())
+    return;
+
+  const double horizon = pi->getHorizon();
+  const double mesh_size = pi->getMeshSize();
+  const auto xi = model->d_xRef.get(i);
+  const auto ui = model->d_u.get(i);
+
+  // update bond state and compute thetax
+  const auto &m = model->d_mX[i];
+  double theta = 0.;
+
+  // upper and lower bound for volume correction
+  auto check_up = horizon + 0.5 * mesh_size;
+  auto check_low = horizon - 0.5 * mesh_size;
+
+  const auto cache = getBondCache<RealType>(model);
+  auto &bonds = model->d_bondsPd;
+  for (size_t b = bonds.begin(i); b < bonds.end(i); b++) {
+
+    const auto j = bonds.getNeighbor(b);
+    const auto xj = model->d_xRef.get(j);
+    const auto uj = model->d_u.get(j);
+    double rji = use_cache ? cache.d_length[b] : (xj - xi).length();
+    double change_length = (xj - xi + uj - ui).length() - rji;
+
+    // step 1: update the bond state
+    double s = change_length / rji;
+    double sc = use_cache ? cache.d_sc[b] : material.getSc(rji);
+
+    // get fracture state, modify, and set
+    auto fs = bonds.getBondState(b);
+    if (!fs && util::isGreater(std::abs(s), sc + 1.0e-10))
+      fs = true;
+    bonds.setBondState(b, fs);
+
+    if (!fs) {
+
+      if (use_cache) {
+        theta += rji * change_length * cache.d_infFn[b] * cache.d_volume[b];
+        continue;
+      }
+
+      // get corrected volume of node j
+      auto volj = model->d_vol[j];
+
+      if (util::isGreater(rji, check_low))
+        volj *= (check_up - rji) / mesh_size;
+
+      theta += rji * change_length * getInfFn(material, inf_fn, rji) * volj;
+    } // if bond is not broken
+  } // loop over neighbors
+
+  model->d_thetaX[i] = 3. * theta / m;
+}
+
+template <class MaterialType, class InfFnType, class RealType>
+void computeForceNode(model::ModelData *model, size_t i, bool use_cache) {
+
+  const auto &pi = model->getParticleFromAllList(model->getPtId(i));
+  const auto &material =
+      static_cast<const MaterialType &>(*pi->getMaterial());
+  const auto *inf_fn =
+      static_cast<const InfFnType *>(material.getInfluenceFn());
+  const bool is_state = material.isStateActive();
+
+  // local variable to hold force
+  util::Point force_i = util::Point();
+  double scalar_f = 0.;
+
+  // for damage
+  float Zi = 0.;
+
+  const double horizon = pi->getHorizon();
+  const double mesh_size = pi->getMeshSize();
+  const auto xi = model->d_xRef.get(i);
+  const auto ui = model->d_u.get(i);
+  // m_x and theta_x are only allocated if some material is state-based
+  const double mi = is_state ? model->d_mX[i] : 0.;
+  const double thetai = is_state ? model->d_thetaX[i] : 0.;
+
+  // upper and lower bound for volume correction
+  auto check_up = horizon + 0.5 * mesh_size;
+  auto check_low = horizon - 0.5 * mesh_size;
+
+  const auto cache = getBondCache<RealType>(model);
+  auto &bonds = model->d_bondsPd;
+  for (size_t b = bonds.begin(i); b < bonds.end(i); b++) {
+    const auto j = bonds.getNeighbor(b);
+    auto fs = bonds.getBondState(b);
+    const auto xj = model->d_xRef.get(j);
+    const auto uj = model->d_u.get(j);
+    auto volj = model->d_vol[j];
+    double rji = use_cache ? cache.d_length[b] : (xj - xi).length();
+    double Sji = material.getS(xj - xi, uj - ui);
+
+    if (!fs) {
+
+      // get corrected volume of node j
+      if (use_cache)
+        volj = cache.d_volume[b];
+      else if (util::isGreater(rji, check_low))
+        volj *= (check_up - rji) / mesh_size;
+
+      double J = use_cache ? cache.d_infFn[b]
+                           : getInfFn(material, inf_fn, rji);
+
+      // handle two cases differently
+      if (is_state) {
+
+        auto ef_i =
+            material.getBondEFWithInfFn(J, rji, Sji, fs, mi, thetai);
+        auto ef_j = material.getBondEFWithInfFn(J, rji, Sji, fs,
+                                                model->d_mX[j],
+                                                model->d_thetaX[j]);
+
+        // compute the contribution of bond force to force at i
+        scalar_f = (ef_i.second + ef_j.second) * volj;
+      } // if state-based
+      else {
+
+        auto ef = material.getBondEFWithInfFn(J, rji, Sji, fs, true);
+        bonds.setBondState(b, fs);
+
+        // compute the contribution of bond force to force at i
+        scalar_f = ef.second * volj;
+      } // if bond-based
+
+      force_i += scalar_f * material.getBondForceDirection(xj - xi, uj - ui);
+    } // if bond not broken
+    else {
+      // add normal contact force
+      auto yji = xj + uj - (xi + ui);
+      auto Rji = yji.length();
+      scalar_f = pi->d_Kn * volj * (Rji - pi->d_Rc) / Rji;
+      if (scalar_f > 0.)
+        scalar_f = 0.;
+      force_i += scalar_f * yji;
+    } // if bond is broken
+
+    // calculate damage
+    auto Sc = use_cache ? cache.d_sc[b] : material.getSc(rji);
+    if (util::isGreater(std::abs(Sji / Sc), Zi))
+      Zi = std::abs(Sji / Sc);
+  } // loop over neighbors
+
+  // add peridynamics force (force is reset before this function is called)
+  model->d_f.add(i, force_i);
+
+  model->d_Z[i] = Zi;
+}
+
+/*!
+ * @brief Adds contact force and damage due to broken bonds that were moved
+ * out of the list of bonds by compaction
+ */
+template <class MaterialType>
+void computeBrokenBondNode(model::ModelData *model, size_t i,
+                           bool use_cache) {
+
+  auto &bonds = model->d_bondsPdBroken;
+  if (bonds.numNodes() == 0 or bonds.numBonds(i) == 0)
+    return;
+
+  const auto &pi = model->getParticleFromAllList(model->getPtId(i));
+  const auto &material =
+      static_cast<const MaterialType &>(*pi->getMaterial());
+
+  util::Point force_i = util::Point();
+  float Zi = model->d_Z[i];
+
+  const auto xi = model->d_xRef.get(i);
+  const auto ui = model->d_u.get(i);
+  for (size_t b = bonds.begin(i); b < bonds.end(i); b++) {
+    const auto j = bonds.getNeighbor(b);
+    const auto xj = model->d_xRef.get(j);
+    const auto uj = model->d_u.get(j);
+
+    // add normal contact force
+    auto yji = xj + uj - (xi + ui);
+    auto Rji = yji.length();
+    double scalar_f = pi->d_Kn * model->d_vol[j] * (Rji - pi->d_Rc) / Rji;
+    if (scalar_f < 0.)
+      force_i += scalar_f * yji;
+
+    // calculate damage
+    double Sji = material.getS(xj - xi, uj - ui);
+    auto Sc = material.getSc((xj - xi).length());
+    if (util::isGreater(std::abs(Sji / Sc), Zi))
+      Zi = std::abs(Sji / Sc);
+  } // loop over broken bonds
+
+  model->d_f.add(i, force_i);
+
+  model->d_Z[i] = Zi;
+}
+
+/*!
+ * @brief Computes force of bonds of node i (bond-based materials) when each
+ * bond is stored once and adds equal and opposite force to node i and its
+ * neighbors in buffer
+ */
+template <class MaterialType, class InfFnType, class RealType>
+void computeHalfBondForceNode(model::ModelData *model, size_t i,
+                              bool use_cache,
+                              material::PdHalfBondBuffer &buffer) {
+
+  const auto &pi = model->getParticleFromAllList(model->getPtId(i));
+  const auto &material =
+      static_cast<const MaterialType &>(*pi->getMaterial());
+  const auto *inf_fn =
+      static_cast<const InfFnType *>(material.getInfluenceFn());
+
+  const auto s = buffer.d_start;
+  util::Point force_i = util::Point();
+  float Zi = buffer.d_Z[i - s];
+
+  const double horizon = pi->getHorizon();
+  const double mesh_size = pi->getMeshSize();
+  const auto xi = model->d_xRef.get(i);
+  const auto ui = model->d_u.get(i);
+  const auto voli = model->d_vol[i];
+
+  // upper and lower bound for volume correction
+  auto check_up = horizon + 0.5 * mesh_size;
+  auto check_low = horizon - 0.5 * mesh_size;
+
+  const auto cache = getBondCache<RealType>(model);
+  auto &bonds = model->d_bondsPd;
+  for (size_t b = bonds.begin(i); b < bonds.end(i); b++) {
+    const auto j = bonds.getNeighbor(b);
+    auto fs = bonds.getBondState(b);
+    const auto xj = model->d_xRef.get(j);
+    const auto uj = model->d_u.get(j);
+    const auto volj = model->d_vol[j];
+    double rji = use_cache ? cache.d_length[b] : (xj - xi).length();
+    double Sji = material.getS(xj - xi, uj - ui);
+
+    if (!fs) {
+
+      // volume correction is same for both nodes of bond
+      double fac = 1.;
+      if (util::isGreater(rji, check_low))
+        fac = (check_up - rji) / mesh_size;
+
+      double J = use_cache ? cache.d_infFn[b]
+                           : getInfFn(material, inf_fn, rji);
+
+      auto ef = material.getBondEFWithInfFn(J, rji, Sji, fs, true);
+      bonds.setBondState(b, fs);
+
+      auto f = ef.second *
+               material.getBondForceDirection(xj - xi, uj - ui);
+      force_i += f * (use_cache ? double(cache.d_volume[b]) : volj * fac);
+      buffer.d_f[j - s] += f * (-voli * fac);
+    } // if bond not broken
+    else {
+      // add normal contact force
+      auto yji = xj + uj - (xi + ui);
+      auto Rji = yji.length();
+      double scalar_f = pi->d_Kn * (Rji - pi->d_Rc) / Rji;
+      if (scalar_f > 0.)
+        scalar_f = 0.;
+      force_i += scalar_f * volj * yji;
+      buffer.d_f[j - s] += scalar_f * (-voli) * yji;
+    } // if bond is broken
+
+    // calculate damage
+    auto Sc = use_cache ? cache.d_sc[b] : material.getSc(rji);
+    float z = std::abs(Sji / Sc);
+    Zi = std::max(Zi, z);
+    buffer.d_Z[j - s] = std::max(buffer.d_Z[j - s], z);
+  } // loop over neighbors
+
+  // broken bonds moved out of the list of bonds by compaction
+  const auto &broken = model->d_bondsPdBroken;
+  if (broken.numNodes() > 0) {
+    for (size_t b = broken.begin(i); b < broken.end(i); b++) {
+      const auto j = broken.getNeighbor(b);
+      const auto xj = model->d_xRef.get(j);
+      const auto uj = model->d_u.get(j);
+
+      // add normal contact force
+      auto yji = xj + uj - (xi + ui);
+      auto Rji = yji.length();
+      double scalar_f = pi->d_Kn * (Rji - pi->d_Rc) / Rji;
+      if (scalar_f < 0.) {
+        force_i += scalar_f * model->d_vol[j] * yji;
+        buffer.d_f[j - s] += scalar_f * (-voli) * yji;
+      }
+
+      // calculate damage
+      double Sji = material.getS(xj - xi, uj - ui);
+      auto Sc = material.getSc((xj - xi).length());
+      float z = std::abs(Sji / Sc);
+      Zi = std::max(Zi, z);
+      buffer.d_Z[j - s] = std::max(buffer.d_Z[j - s], z);
+    } // loop over broken bonds
+  }
+
+  buffer.d_f[i - s] += force_i;
+  buffer.d_Z[i - s] = Zi;
+}
+
+/*!
+ * @brief Computes peridynamic force at node using explicitly vectorized bond
+ * kernel (for materials with linear bond force, i.e., PmbMaterial and
+ * PdElastic)
+ */
+template <class MaterialType, class InfFnType, class RealType>
+void computeForceNodeSimd(model::ModelData *model, size_t i, bool use_cache) {
+
+  const auto &pi = model->getParticleFromAllList(model->getPtId(i));
+  const auto &material =
+      static_cast<const MaterialType &>(*pi->getMaterial());
+  const auto *inf_fn =
+      static_cast<const InfFnType *>(material.getInfluenceFn());
+
+  const auto cache = getBondCache<RealType>(model);
+  auto &bonds = model->d_bondsPd;
+  const auto b0 = bonds.begin(i);
+
+  material::LinearBondForceNode<RealType> node;
+  node.d_dim = model->d_xRef.dim();
+  for (size_t d = 0; d < 3; d++) {
+    node.d_xRef[d] = d < node.d_dim ? model->d_xRef.data(d) : nullptr;
+    node.d_u[d] = d < node.d_dim ? model->d_u.data(d) : nullptr;
+  }
+  node.d_vol = model->d_vol.data();
+  node.d_xi = model->d_xRef.get(i);
+  node.d_ui = model->d_u.get(i);
+  node.d_bonds = bonds.data() + b0;
+  node.d_numBonds = bonds.numBonds(i);
+  node.d_bondLength = use_cache ? cache.d_length + b0 : nullptr;
+  node.d_bondVolume = use_cache ? cache.d_volume + b0 : nullptr;
+  node.d_bondInfFn = use_cache ? cache.d_infFn + b0 : nullptr;
+  node.d_c = material.getC();
+  // critical strain of these materials does not depend on bond length
+  node.d_sc = material.getSc(0.);
+  node.d_breakBonds = std::is_same_v<MaterialType, material::PmbMaterial>;
+  node.d_materialHorizon = material.getHorizon();
+  node.d_horizon = pi->getHorizon();
+  node.d_meshSize = pi->getMeshSize();
+  node.d_Kn = pi->d_Kn;
+  node.d_Rc = pi->d_Rc;
+
+  util::Point force_i;
+  float Zi = 0.;
+  material::computeLinearBondForce(node, inf_fn, force_i, Zi, true);
+
+  // add peridynamics force (force is reset before this function is called)
+  model->d_f.add(i, force_i);
+
+  model->d_Z[i] = Zi;
+}
+
+template <class MaterialType, class InfFnType, class RealType>
+material::PdKernels getKernels(const std::string &name) {
+  return {computeStateNode<MaterialType, InfFnType, RealType>,
+          computeForceNode<MaterialType, InfFnType, RealType>,
+          computeBrokenBondNode<MaterialType>,
+          computeHalfBondForceNode<MaterialType, InfFnType, RealType>, name};
+}
+
+template <class MaterialType, class InfFnType, class RealType>
+material::PdKernels getKernels(const std::string &name, bool use_simd) {
+
+  // explicitly vectorized force kernel is only available for materials with
+  // linear bond force
+  if constexpr (std::is_same_v<MaterialType, material::PmbMaterial> or
+                std::is_same_v<MaterialType, material::PdElastic>) {
+    if (use_simd)
+      return {computeStateNode<MaterialType, InfFnType, RealType>,
+              computeForceNodeSimd<MaterialType, InfFnType, RealType>,
+              computeBrokenBondNode<MaterialType>,
+              computeHalfBondForceNode<MaterialType, InfFnType, RealType>,
+              name + "-SIMD"};
+  }
+
+  return getKernels<MaterialType, InfFnType, RealType>(name);
+}
+
+template <class MaterialType, class InfFnType>
+material::PdKernels getKernels(const std::string &name, bool use_simd,
+                               bool use_float_cache) {
+  if (use_float_cache)
+    return getKernels<MaterialType, InfFnType, float>(name + "-Float",
+                                                      use_simd);
+  else
+    return getKernels<MaterialType, InfFnType, double>(name, use_simd);
+}
+
+template <class MaterialType>
+material::PdKernels getKernels(const material::BaseInfluenceFn *inf_fn,
+                               const std::string &name, bool use_simd,
+                               bool use_float_cache) {
+
+  if (dynamic_cast<const material::ConstInfluenceFn *>(inf_fn))
+    return getKernels<MaterialType, material::ConstInfluenceFn>(
+        name + "-ConstInfluenceFn", use_simd, use_float_cache);
+  else if (dynamic_cast<const material::LinearInfluenceFn *>(inf_fn))
+    return getKernels<MaterialType, material::LinearInfluenceFn>(
+        name + "-LinearInfluenceFn", use_simd, use_float_cache);
+  else if (dynamic_cast<const material::GaussianInfluenceFn *>(inf_fn))
+    return getKernels<MaterialType, material::GaussianInfluenceFn>(
+        name + "-GaussianInfluenceFn", use_simd, use_float_cache);
+
+  return getKernels<material::Material, material::BaseInfluenceFn>(
+      "Generic", false, use_float_cache);
+}
+
+} // anonymous namespace
+
+material::PdKernels
+material::getPdKernels(const material::Material *material, bool use_simd,
+                       bool use_float_cache) {
+
+  const auto *inf_fn = material->getInfluenceFn();
+  if (inf_fn == nullptr)
+    return getKernels<material::Material, material::BaseInfluenceFn>(
+        "Generic", false, use_float_cache);
+
+  if (dynamic_cast<const material::RnpMaterial *>(material))
+    return getKernels<material::RnpMaterial>(inf_fn, "RnpMaterial", use_simd,
+                                             use_float_cache);
+  else if (dynamic_cast<const material::PmbMaterial *>(material))
+    return getKernels<material::PmbMaterial>(inf_fn, "PmbMaterial", use_simd,
+                                             use_float_cache);
+  else if (dynamic_cast<const material::PdElastic *>(material))
+    return getKernels<material::PdElastic>(inf_fn, "PdElastic", use_simd,
+                                           use_float_cache);
+  else if (dynamic_cast<const material::PdState *>(material))
+    return getKernels<material::PdState>(inf_fn, "PdState", use_simd,
+                                         use_float_cache);
+
+  return getKernels<material::Material, material::BaseInfluenceFn>(
+      "Generic", false, use_float_cache);
+}
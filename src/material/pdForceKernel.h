@@ -0,0 +1,120 @@
+/*
+ * -------------------------------------------
+ * Copyright (c) 2021 - 2024 Prashant K. Jha
+ * -------------------------------------------
+ * PeriDEM https://github.com/prashjha/PeriDEM
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE)
+ */
+
+#ifndef MATERIAL_PDFORCEKERNEL_H
+#define MATERIAL_PDFORCEKERNEL_H
+
+#include "mparticle/material.h"
+#include "util/point.h"
+#include <string>
+#include <vector>
+
+namespace model {
+// forward declaration
+class ModelData;
+}
+
+namespace material {
+
+/*!
+ * @brief Function computing peridynamic quantities at a node
+ *
+ * @param model Pointer to model data
+ * @param i Nodal id
+ * @param use_cache True if reference quantities of bonds are cached in
+ * model (see model::ModelData::d_bondsPdLength)
+ */
+typedef void (*PdNodeKernel)(model::ModelData *model, size_t i,
+                             bool use_cache);
+
+/*!
+ * @brief Buffer holding force density and damage of a contiguous range of
+ * nodes, accumulated by half-bond kernel (see PdKernels::d_halfForceFn)
+ */
+struct PdHalfBondBuffer {
+
+  /*! @brief Id of first node in buffer */
+  size_t d_start;
+
+  /*! @brief Force density of nodes */
+  std::vector<util::Point> d_f;
+
+  /*! @brief Damage of nodes */
+  std::vector<float> d_Z;
+};
+
+/*!
+ * @brief Function computing peridynamic force of bonds that are stored only
+ * once (in list of node with smaller id) and adding equal and opposite
+ * contributions to both nodes of bond in buffer
+ *
+ * @param model Pointer to model data
+ * @param i Nodal id
+ * @param use_cache True if reference quantities of bonds are cached in
+ * model (see model::ModelData::d_bondsPdLength)
+ * @param buffer Buffer that covers node i and its neighbors
+ */
+typedef void (*PdHalfBondKernel)(model::ModelData *model, size_t i,
+                                 bool use_cache, PdHalfBondBuffer &buffer);
+
+/*!
+ * @brief Peridynamic force kernels specialized for a combination of material
+ * and influence function
+ *
+ * Kernels are instantiated for each of RnpMaterial, PmbMaterial, PdElastic,
+ * and PdState combined with each of ConstInfluenceFn, LinearInfluenceFn, and
+ * GaussianInfluenceFn. Since these classes are final, the loop over bonds in
+ * the kernels has no virtual calls and can be inlined by the compiler.
+ */
+struct PdKernels {
+
+  /*! @brief Kernel to update bond state and compute dilation at node
+   * (only used for state-based materials) */
+  PdNodeKernel d_stateFn;
+
+  /*! @brief Kernel to compute peridynamic force and damage at node */
+  PdNodeKernel d_forceFn;
+
+  /*! @brief Kernel to add contact force and damage due to compacted broken
+   * bonds of node (see model::ModelData::d_bondsPdBroken); it is called
+   * after d_forceFn */
+  PdNodeKernel d_brokenFn;
+
+  /*! @brief Kernel to compute peridynamic force, contact force of broken
+   * bonds, and damage when each bond is stored once (only for bond-based
+   * materials, see inp::ModelDeck::d_pdHalfBonds) */
+  PdHalfBondKernel d_halfForceFn;
+
+  /*! @brief Name of kernel */
+  std::string d_name;
+};
+
+/*!
+ * @brief Returns force kernels specialized for type of material and its
+ * influence function
+ *
+ * This should be called once per material (e.g., once per particle zone)
+ * and not in the loop over nodes. If the type of material or influence
+ * function is not known, generic kernels calling virtual methods are
+ * returned.
+ *
+ * @param material Pointer to material
+ * @param use_simd Flag to use explicitly vectorized bond kernel for
+ * PmbMaterial and PdElastic (see material::computeLinearBondForce())
+ * @param use_float_cache Flag to read cached reference quantities of bonds
+ * from single precision arrays (see model::ModelData::d_bondsPdLengthF)
+ * @return kernels Force kernels
+ */
+PdKernels getPdKernels(const material::Material *material,
+                       bool use_simd = false, bool use_float_cache = false);
+
+} // namespace material
+
+#endif // MATERIAL_PDFORCEKERNEL_H
@@ -0,0 +1,310 @@
+/*
+ * -------------------------------------------
+ * Copyright (c) 2021 - 2024 Prashant K. Jha
+ * -------------------------------------------
+ * PeriDEM https://github.com/prashjha/PeriDEM
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE)
+ */
+
+#include "pdSimdKernel.h"
+#include "geometry/bondList.h"
+#include "mparticle/influenceFn.h"
+#include "util/function.h"
+#include <cmath>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define PERIDEM_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/*! @brief Returns vector from component arrays */
+inline util::Point getPoint(const double *const x[3], const size_t &dim,
+                            const size_t &j) {
+  return {x[0][j], dim > 1 ? x[1][j] : 0., dim > 2 ? x[2][j] : 0.};
+}
+
+/*! @brief Computes force and damage due to k-th bond of node (scalar) */
+template <class InfFnType, class RealType>
+inline void linearBondForce(const material::LinearBondForceNode<RealType> &node,
+                            const InfFnType *inf_fn, const size_t &k,
+                            util::Point &force, float &Z) {
+
+  auto &w = node.d_bonds[k];
+  const size_t j = w & geometry::BondList::id_mask;
+  bool fs = w & geometry::BondList::state_mask;
+
+  // upper and lower bound for volume correction
+  auto check_up = node.d_horizon + 0.5 * node.d_meshSize;
+  auto check_low = node.d_horizon - 0.5 * node.d_meshSize;
+
+  const auto xj = getPoint(node.d_xRef, node.d_dim, j);
+  const auto uj = getPoint(node.d_u, node.d_dim, j);
+  const auto dx = xj - node.d_xi;
+  const auto du = uj - node.d_ui;
+  auto volj = node.d_vol[j];
+  double rji = node.d_bondLength ? node.d_bondLength[k] : dx.length();
+  double Sji = ((dx + du).length() - dx.length()) / dx.length();
+
+  if (!fs) {
+
+    // get corrected volume of node j
+    if (node.d_bondVolume)
+      volj = node.d_bondVolume[k];
+    else if (util::isGreater(rji, check_low))
+      volj *= (check_up - rji) / node.d_meshSize;
+
+    double J = node.d_bondInfFn
+                   ? node.d_bondInfFn[k]
+                   : inf_fn->getInfFn(rji / node.d_materialHorizon);
+
+    // check if fracture state of the bond need to be updated
+    if (node.d_breakBonds &&
+        util::isGreater(std::abs(Sji), node.d_sc + 1.0e-10)) {
+      fs = true;
+      w |= geometry::BondList::state_mask;
+    }
+
+    double scalar_f = fs ? 0. : J * node.d_c * Sji * volj;
+    force += scalar_f * ((dx + du) / (dx + du).length());
+  } // if bond not broken
+  else {
+    // add normal contact force
+    auto yji = xj + uj - (node.d_xi + node.d_ui);
+    auto Rji = yji.length();
+    double scalar_f = node.d_Kn * volj * (Rji - node.d_Rc) / Rji;
+    if (scalar_f > 0.)
+      scalar_f = 0.;
+    force += scalar_f * yji;
+  } // if bond is broken
+
+  // calculate damage
+  if (util::isGreater(std::abs(Sji / node.d_sc), Z))
+    Z = std::abs(Sji / node.d_sc);
+}
+
+template <class InfFnType, class RealType>
+void computeLinearBondForceScalar(const material::LinearBondForceNode<RealType> &node,
+                                  const InfFnType *inf_fn, util::Point &force,
+                                  float &Z) {
+  for (size_t k = 0; k < node.d_numBonds; k++)
+    linearBondForce(node, inf_fn, k, force, Z);
+}
+
+#ifdef PERIDEM_SIMD_AVX2
+
+/*! @brief Loads four consecutive values as doubles */
+__attribute__((target("avx2"))) inline __m256d loadPd(const double *p) {
+  return _mm256_loadu_pd(p);
+}
+
+/*! @brief Loads four consecutive floats and converts them to doubles */
+__attribute__((target("avx2"))) inline __m256d loadPd(const float *p) {
+  return _mm256_cvtps_pd(_mm_loadu_ps(p));
+}
+
+/*! @brief Vectorized version of util::isGreater() */
+__attribute__((target("avx2"))) inline __m256d isGreaterPd(__m256d a,
+                                                           __m256d b) {
+  const __m256d sign = _mm256_set1_pd(-0.);
+  auto tol = _mm256_mul_pd(
+      _mm256_max_pd(_mm256_andnot_pd(sign, a), _mm256_andnot_pd(sign, b)),
+      _mm256_set1_pd(COMPARE_EPS));
+  return _mm256_cmp_pd(_mm256_sub_pd(a, b), tol, _CMP_GT_OQ);
+}
+
+template <class InfFnType, class RealType>
+__attribute__((target("avx2"))) void
+computeLinearBondForceAvx2(const material::LinearBondForceNode<RealType> &node,
+                           const InfFnType *inf_fn, util::Point &force,
+                           float &Z) {
+
+  const size_t dim = node.d_dim;
+  const auto check_up = _mm256_set1_pd(node.d_horizon + 0.5 * node.d_meshSize);
+  const auto check_low = _mm256_set1_pd(node.d_horizon - 0.5 * node.d_meshSize);
+  const auto mesh_size = _mm256_set1_pd(node.d_meshSize);
+  const auto zero = _mm256_setzero_pd();
+  const auto sign = _mm256_set1_pd(-0.);
+  const auto id_mask = _mm_set1_epi32(int(geometry::BondList::id_mask));
+
+  __m256d xi[3], ui[3], xui[3], acc[3];
+  for (size_t d = 0; d < dim; d++) {
+    xi[d] = _mm256_set1_pd(node.d_xi[d]);
+    ui[d] = _mm256_set1_pd(node.d_ui[d]);
+    xui[d] = _mm256_set1_pd(node.d_xi[d] + node.d_ui[d]);
+    acc[d] = zero;
+  }
+
+  alignas(32) double lane[4];
+
+  size_t k = 0;
+  for (; k + 4 <= node.d_numBonds; k += 4) {
+
+    auto w = _mm_loadu_si128((const __m128i *) (node.d_bonds + k));
+    auto ids = _mm_and_si128(w, id_mask);
+
+    // lanes of bonds that were broken before this step (state is the sign
+    // bit of bond word)
+    auto fs0 = _mm256_castsi256_pd(
+        _mm256_cvtepi32_epi64(_mm_srai_epi32(w, 31)));
+
+    __m256d y[3], yc[3];
+    auto dx_sq = zero, y_sq = zero, yc_sq = zero;
+    for (size_t d = 0; d < dim; d++) {
+      auto xj = _mm256_i32gather_pd(node.d_xRef[d], ids, 8);
+      auto uj = _mm256_i32gather_pd(node.d_u[d], ids, 8);
+      auto dx = _mm256_sub_pd(xj, xi[d]);
+      y[d] = _mm256_add_pd(dx, _mm256_sub_pd(uj, ui[d]));
+      yc[d] = _mm256_sub_pd(_mm256_add_pd(xj, uj), xui[d]);
+
+      dx_sq = _mm256_add_pd(dx_sq, _mm256_mul_pd(dx, dx));
+      y_sq = _mm256_add_pd(y_sq, _mm256_mul_pd(y[d], y[d]));
+      yc_sq = _mm256_add_pd(yc_sq, _mm256_mul_pd(yc[d], yc[d]));
+    }
+    auto dx_len = _mm256_sqrt_pd(dx_sq);
+    auto y_len = _mm256_sqrt_pd(y_sq);
+    auto r = node.d_bondLength ? loadPd(node.d_bondLength + k)
+                               : dx_len;
+    auto s = _mm256_div_pd(_mm256_sub_pd(y_len, dx_len), dx_len);
+
+    // volume of neighbor and corrected volume
+    auto vol = _mm256_i32gather_pd(node.d_vol, ids, 8);
+    __m256d volc;
+    if (node.d_bondVolume)
+      volc = loadPd(node.d_bondVolume + k);
+    else
+      volc = _mm256_blendv_pd(
+          vol,
+          _mm256_mul_pd(vol, _mm256_div_pd(_mm256_sub_pd(check_up, r),
+                                           mesh_size)),
+          isGreaterPd(r, check_low));
+
+    // influence function
+    __m256d J;
+    if (node.d_bondInfFn)
+      J = loadPd(node.d_bondInfFn + k);
+    else {
+      _mm256_store_pd(lane, r);
+      for (auto &l : lane)
+        l = inf_fn->getInfFn(l / node.d_materialHorizon);
+      J = _mm256_load_pd(lane);
+    }
+
+    // update fracture state of bonds
+    auto abs_s = _mm256_andnot_pd(sign, s);
+    auto fs = fs0;
+    if (node.d_breakBonds) {
+      auto broken_now = _mm256_andnot_pd(
+          fs0, isGreaterPd(abs_s, _mm256_set1_pd(node.d_sc + 1.0e-10)));
+      auto bits = _mm256_movemask_pd(broken_now);
+      for (int l = 0; l < 4; l++)
+        if (bits & (1 << l))
+          node.d_bonds[k + l] |= geometry::BondList::state_mask;
+      fs = _mm256_or_pd(fs0, broken_now);
+    }
+
+    // bond force (zero if bond is broken)
+    auto f = _mm256_mul_pd(
+        _mm256_mul_pd(_mm256_mul_pd(J, _mm256_set1_pd(node.d_c)), s), volc);
+    f = _mm256_andnot_pd(fs, f);
+
+    // contact force for bonds that were broken
+    auto yc_len = _mm256_sqrt_pd(yc_sq);
+    auto fc = _mm256_div_pd(
+        _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(node.d_Kn), vol),
+                      _mm256_sub_pd(yc_len, _mm256_set1_pd(node.d_Rc))),
+        yc_len);
+    fc = _mm256_min_pd(fc, zero);
+
+    for (size_t d = 0; d < dim; d++)
+      acc[d] = _mm256_add_pd(
+          acc[d],
+          _mm256_blendv_pd(_mm256_mul_pd(f, _mm256_div_pd(y[d], y_len)),
+                           _mm256_mul_pd(fc, yc[d]), fs0));
+
+    // damage
+    _mm256_store_pd(
+        lane, _mm256_andnot_pd(sign,
+                               _mm256_div_pd(s, _mm256_set1_pd(node.d_sc))));
+    for (const auto &l : lane)
+      if (util::isGreater(l, Z))
+        Z = l;
+  } // loop over chunks of bonds
+
+  for (size_t d = 0; d < dim; d++) {
+    _mm256_store_pd(lane, acc[d]);
+    force[d] += (lane[0] + lane[1]) + (lane[2] + lane[3]);
+  }
+
+  // remaining bonds
+  for (; k < node.d_numBonds; k++)
+    linearBondForce(node, inf_fn, k, force, Z);
+}
+
+#endif // PERIDEM_SIMD_AVX2
+
+} // anonymous namespace
+
+bool material::isSimdBondKernelSupported() {
+#ifdef PERIDEM_SIMD_AVX2
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+#else
+  return false;
+#endif
+}
+
+template <class InfFnType, class RealType>
+void material::computeLinearBondForce(const LinearBondForceNode<RealType> &node,
+                                      const InfFnType *inf_fn,
+                                      util::Point &force, float &Z,
+                                      bool use_simd) {
+#ifdef PERIDEM_SIMD_AVX2
+  if (use_simd && isSimdBondKernelSupported()) {
+    computeLinearBondForceAvx2(node, inf_fn, force, Z);
+    return;
+  }
+#endif
+
+  computeLinearBondForceScalar(node, inf_fn, force, Z);
+}
+
+// explicit instantiations
+template void
+material::computeLinearBondForce<material::ConstInfluenceFn, double>(
+    const LinearBondForceNode<double> &node,
+    const material::ConstInfluenceFn *inf_fn, util::Point &force, float &Z,
+    bool use_simd);
+
+template void
+material::computeLinearBondForce<material::LinearInfluenceFn, double>(
+    const LinearBondForceNode<double> &node,
+    const material::LinearInfluenceFn *inf_fn, util::Point &force, float &Z,
+    bool use_simd);
+
+template void
+material::computeLinearBondForce<material::GaussianInfluenceFn, double>(
+    const LinearBondForceNode<double> &node,
+    const material::GaussianInfluenceFn *inf_fn, util::Point &force, float &Z,
+    bool use_simd);
+
+template void
+material::computeLinearBondForce<material::ConstInfluenceFn, float>(
+    const LinearBondForceNode<float> &node,
+    const material::ConstInfluenceFn *inf_fn, util::Point &force, float &Z,
+    bool use_simd);
+
+template void
+material::computeLinearBondForce<material::LinearInfluenceFn, float>(
+    const LinearBondForceNode<float> &node,
+    const material::LinearInfluenceFn *inf_fn, util::Point &force, float &Z,
+    bool use_simd);
+
+template void
+material::computeLinearBondForce<material::GaussianInfluenceFn, float>(
+    const LinearBondForceNode<float> &node,
+    const material::GaussianInfluenceFn *inf_fn, util::Point &force, float &Z,
+    bool use_simd);
@@ -0,0 +1,125 @@
+/*
+ * -------------------------------------------
+ * Copyright (c) 2021 - 2024 Prashant K. Jha
+ * -------------------------------------------
+ * PeriDEM https://github.com/prashjha/PeriDEM
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE)
+ */
+
+#ifndef MATERIAL_PDSIMDKERNEL_H
+#define MATERIAL_PDSIMDKERNEL_H
+
+#include "util/point.h"
+#include <cstdint>
+#include <cstring>
+
+namespace material {
+
+/*!
+ * @brief Data of a node needed to compute bond-based peridynamic force for
+ * materials with linear bond force (PmbMaterial and PdElastic)
+ *
+ * Pointers to bond data point to the first bond of the node. Pointers to
+ * cached bond data (see model::ModelData::d_bondsPdLength) are null if
+ * bond cache is not active.
+ *
+ * @tparam RealType Type of cached bond data (double, or float in
+ * mixed-precision mode)
+ */
+template <class RealType = double>
+struct LinearBondForceNode {
+
+  /*! @brief Dimension */
+  size_t d_dim;
+
+  /*! @brief Component arrays of reference coordinates of all nodes */
+  const double *d_xRef[3];
+
+  /*! @brief Component arrays of displacements of all nodes */
+  const double *d_u[3];
+
+  /*! @brief Nodal volumes of all nodes */
+  const double *d_vol;
+
+  /*! @brief Reference coordinate of the node */
+  util::Point d_xi;
+
+  /*! @brief Displacement of the node */
+  util::Point d_ui;
+
+  /*! @brief Bonds of the node (see geometry::BondList) */
+  uint32_t *d_bonds;
+
+  /*! @brief Number of bonds of the node */
+  size_t d_numBonds;
+
+  /*! @brief Cached reference length of bonds (or null) */
+  const RealType *d_bondLength;
+
+  /*! @brief Cached corrected volume of neighbors (or null) */
+  const RealType *d_bondVolume;
+
+  /*! @brief Cached influence function of bonds (or null) */
+  const RealType *d_bondInfFn;
+
+  /*! @brief Bond stiffness */
+  double d_c;
+
+  /*! @brief Critical strain */
+  double d_sc;
+
+  /*! @brief Flag to break bonds if bond strain exceeds critical strain */
+  bool d_breakBonds;
+
+  /*! @brief Horizon of material (used to scale argument of influence function) */
+  double d_materialHorizon;
+
+  /*! @brief Horizon of particle (used in volume correction) */
+  double d_horizon;
+
+  /*! @brief Mesh size of particle */
+  double d_meshSize;
+
+  /*! @brief Normal contact coefficient for broken bonds */
+  double d_Kn;
+
+  /*! @brief Critical distance for contact of broken bonds */
+  double d_Rc;
+};
+
+/*!
+ * @brief Returns true if explicitly vectorized (AVX2) bond kernel is
+ * supported by the CPU and by the build
+ *
+ * @return bool True if supported
+ */
+bool isSimdBondKernelSupported();
+
+/*!
+ * @brief Computes bond-based force and damage at a node with linear bond
+ * force
+ *
+ * Bond states are updated in node.d_bonds. If use_simd is true and the CPU
+ * supports AVX2, four bonds are evaluated per instruction with masks for
+ * broken bonds. Otherwise, portable scalar loop is used. Results of the two
+ * paths agree up to round-off as the order of summation differs.
+ *
+ * @tparam InfFnType Type of influence function (ConstInfluenceFn,
+ * LinearInfluenceFn, or GaussianInfluenceFn)
+ * @tparam RealType Type of cached bond data (double or float)
+ * @param node Data of node
+ * @param inf_fn Influence function
+ * @param force Peridynamic force at node
+ * @param Z Damage at node
+ * @param use_simd Flag to use vectorized kernel if supported
+ */
+template <class InfFnType, class RealType>
+void computeLinearBondForce(const LinearBondForceNode<RealType> &node,
+                            const InfFnType *inf_fn, util::Point &force,
+                            float &Z, bool use_simd);
+
+} // namespace material
+
+#endif // MATERIAL_PDSIMDKERNEL_H
@@ -13,6 +13,7 @@
 // utils
 #include "particle/baseParticle.h"
 #include "material/materialUtil.h"
+#include "material/pdSimdKernel.h"
 #include "util/function.h"
 #include "util/geomObjectsUtil.h"
 #include "util/matrix.h"
@@ -33,17 +34,258 @@
 #include "rw/vtkParticleReader.h"
 #include "fe/elemIncludes.h"
 #include "fe/meshUtil.h"
+#include "nsearch/cellListSearch.h"
 
+#include <algorithm>
 #include <fmt/format.h>
 #include <random>
+#include <tuple>
 
 #include <taskflow/taskflow/taskflow.hpp>
 #include <taskflow/taskflow/algorithm/for_each.hpp>
 
+namespace {
+
+/*!
+ * @brief Keeps entries of data indexed by bond id that are listed in map
+ * (see geometry::BondList::compact())
+ */
+template <class T>
+void compactBondData(std::vector<T> &data, const std::vector<size_t> &map) {
+  if (data.empty())
+    return;
+
+  std::vector<T> compact_data(map.size());
+  for (size_t k = 0; k < map.size(); k++)
+    compact_data[k] = data[map[k]];
+  data.swap(compact_data);
+}
+
+/*!
+ * @brief Updates velocity, displacement, current position, and velocity
+ * magnitude of a node
+ *
+ * For each free component (see ModelData::d_fix), velocity is first updated
+ * as v += dt_by_rho * f, and then displacement and current position are
+ * advanced with the updated velocity as u += dt * v and x += dt * v. Fixed
+ * components are not changed. Finally, d_vMag is set to the magnitude of
+ * the velocity of the node (all components).
+ *
+ * Templated on dimension so that the loop over components is unrolled and
+ * only the stored components of nodal vectors are read and written.
+ *
+ * @param model Model data
+ * @param i Global id of node
+ * @param dt_by_rho Factor multiplying the force in velocity update
+ * @param dt Factor multiplying the velocity in displacement and position
+ * update (zero for velocity-only update, e.g., second half step of velocity
+ * Verlet)
+ */
+template <size_t dim>
+inline void updateNodeKinematics(model::ModelData *model, size_t i,
+                                 double dt_by_rho, double dt) {
+
+  const auto &fix = model->d_fix[i];
+  double v_sq = 0.;
+  for (size_t dof = 0; dof < dim; dof++) {
+    auto &vi = model->d_v(i, dof);
+    if (util::methods::isFree(fix, dof)) {
+      vi += dt_by_rho * model->d_f(i, dof);
+      model->d_u(i, dof) += dt * vi;
+      model->d_x(i, dof) += dt * vi;
+    }
+    v_sq += vi * vi;
+  }
+
+  model->d_vMag[i] = std::sqrt(v_sq);
+}
+
+/*! @copydoc updateNodeKinematics(model::ModelData *model, size_t i, double dt_by_rho, double dt) */
+inline void updateNodeKinematics(model::ModelData *model, size_t i,
+                                 double dt_by_rho, double dt) {
+  switch (model->d_x.dim()) {
+    case 1:
+      updateNodeKinematics<1>(model, i, dt_by_rho, dt);
+      break;
+    case 2:
+      updateNodeKinematics<2>(model, i, dt_by_rho, dt);
+      break;
+    default:
+      updateNodeKinematics<3>(model, i, dt_by_rho, dt);
+  }
+}
+
+/*!
+ * @brief Returns integral of (Rc - |z|) (z.n / |z|) over the part of a half
+ * space (with inward normal n) that lies within distance Rc of a point at
+ * distance d from the boundary of the half space
+ *
+ * Multiplied by contact stiffness, this is the continuum limit of the sum of
+ * normal contact forces between a node and the nodes of a flat meshed wall.
+ * Points inside the wall (d < 0) are treated as points on its boundary.
+ *
+ * @param d Distance of point from the boundary of wall
+ * @param Rc Contact radius
+ * @param dim Dimension
+ * @return Integral Value of integral
+ */
+double wallContactIntegral(double d, double Rc, size_t dim) {
+
+  d = std::max(d, 0.);
+  if (!util::isLess(d, Rc))
+    return 0.;
+
+  if (dim == 3)
+    return M_PI * (std::pow(Rc, 4) / 12. - 0.5 * Rc * Rc * d * d +
+                   2. * Rc * d * d * d / 3. - 0.25 * std::pow(d, 4));
+
+  // 2d: 2 int_d^Rc (Rc - r) sqrt(r^2 - d^2) dr
+  double s = std::sqrt(Rc * Rc - d * d);
+  double log_term = d > 0. ? Rc * d * d * std::log((Rc + s) / d) : 0.;
+  return Rc * Rc * s - log_term - 2. * s * s * s / 3.;
+}
+
+/*!
+ * @brief Returns unit outward normal of geometry (gradient of its signed
+ * distance computed using central differences)
+ *
+ * @param geom Geometry object
+ * @param x Point
+ * @param eps Step size for finite differences
+ * @param dim Dimension
+ * @return n Unit normal (zero if gradient vanishes)
+ */
+util::Point signedDistanceNormal(const util::geometry::GeomObject *geom,
+                                 const util::Point &x, double eps,
+                                 size_t dim) {
+  util::Point n;
+  for (size_t dof = 0; dof < dim; dof++) {
+    auto e = util::Point();
+    e[dof] = eps;
+    n[dof] = (geom->signedDistance(x + e) - geom->signedDistance(x - e)) /
+             (2. * eps);
+  }
+
+  auto n_mag = n.length();
+  return util::isGreater(n_mag, 0.) ? n / n_mag : util::Point();
+}
+
+/*!
+ * @brief Rigid motion of analytic wall, i.e., translation and rotation
+ * about z-axis (see util::rotate2D()), found from current and reference
+ * position of nodes of wall
+ *
+ * Current position of a point of wall with reference position \f$ X \f$ is
+ * \f$ x = x_0 + R (X - X_0) \f$ where \f$ X_0, x_0 \f$ are reference and
+ * current position of first node of wall and \f$ R \f$ is rotation.
+ */
+struct AnalyticWallPose {
+
+  /*! @brief Reference and current position of first node of wall */
+  util::Point d_X0, d_x0;
+
+  /*! @brief Velocity of first node of wall */
+  util::Point d_v0;
+
+  /*! @brief Cosine and sine of rotation angle */
+  double d_cos, d_sin;
+
+  /*! @brief Angular velocity */
+  double d_omega;
+
+  /*!
+   * @brief Constructor
+   *
+   * Rotation is found from the node of wall farthest (in xy-plane) from
+   * the first node.
+   *
+   * @param x Current position of nodes
+   * @param xRef Reference position of nodes
+   * @param v Velocity of nodes
+   * @param start Id of first node of wall
+   * @param end Id of last node of wall plus one
+   */
+  AnalyticWallPose(const util::PointSoA &x, const util::PointSoA &xRef,
+                   const util::PointSoA &v, size_t start, size_t end)
+      : d_X0(xRef.get(start)), d_x0(x.get(start)), d_v0(v.get(start)),
+        d_cos(1.), d_sin(0.), d_omega(0.) {
+
+    double r_max = 0.;
+    size_t k = start;
+    for (size_t j = start + 1; j < end; j++) {
+      auto dX = xRef.get(j) - d_X0;
+      auto r = dX.d_x * dX.d_x + dX.d_y * dX.d_y;
+      if (r > r_max) {
+        r_max = r;
+        k = j;
+      }
+    }
+
+    if (k == start)
+      return;
+
+    auto a = xRef.get(k) - d_X0;
+    auto b = x.get(k) - d_x0;
+    auto theta = std::atan2(a.d_x * b.d_y - a.d_y * b.d_x,
+                            a.d_x * b.d_x + a.d_y * b.d_y);
+    d_cos = std::cos(theta);
+    d_sin = std::sin(theta);
+
+    // v_k - v_0 = omega e_z x (x_k - x_0)
+    auto dv = v.get(k) - d_v0;
+    d_omega = (b.d_x * dv.d_y - b.d_y * dv.d_x) / (b.d_x * b.d_x + b.d_y * b.d_y);
+  }
+
+  /*! @brief Returns reference position of given point of wall */
+  util::Point toReference(const util::Point &y) const {
+    auto dy = y - d_x0;
+    return d_X0 + util::Point(d_cos * dy.d_x + d_sin * dy.d_y,
+                              -d_sin * dy.d_x + d_cos * dy.d_y, dy.d_z);
+  }
+
+  /*! @brief Rotates given vector from reference to current configuration */
+  util::Point rotate(const util::Point &n) const {
+    return {d_cos * n.d_x - d_sin * n.d_y, d_sin * n.d_x + d_cos * n.d_y,
+            n.d_z};
+  }
+
+  /*! @brief Returns velocity of wall at given point (in current
+   * configuration) */
+  util::Point velocity(const util::Point &y) const {
+    auto dy = y - d_x0;
+    return d_v0 + d_omega * util::Point(-dy.d_y, dy.d_x, 0.);
+  }
+};
+
+/*!
+ * @brief Returns rigid motion of walls (ordered by type id of wall); motion
+ * is computed only for analytic walls and is identity for other walls
+ *
+ * @param model Pointer to model data
+ * @return poses Vector of rigid motion of walls
+ */
+std::vector<AnalyticWallPose> getAnalyticWallPoses(const model::ModelData *model) {
+
+  std::vector<AnalyticWallPose> poses;
+  for (const auto &pw : model->d_particlesListTypeWall) {
+    auto end = pw->d_analyticWall ? pw->d_globEnd : pw->d_globStart + 1;
+    poses.emplace_back(model->d_x, model->d_xRef, model->d_v,
+                       pw->d_globStart, end);
+  }
+
+  return poses;
+}
+
+} // anonymous namespace
+
 
 model::DEMModel::DEMModel(inp::Input *deck, std::string modelName)
   : ModelData(deck),
-    d_name(modelName) {
+    d_name(modelName),
+    d_stepPdTime(0.),
+    d_stepContactNeighTime(0.),
+    d_stepContactTime(0.),
+    d_stepExtfTime(0.) {
 
   // initialize logger
   util::io::initLogger(d_outputDeck_p->d_debug,
@@ -91,9 +333,7 @@ void model::DEMModel::restart(inp::Input *deck) {
   log(fmt::format("  Restart step = {}, time = {:.6f} \n", d_n, d_time));
 
   // get backup of reference configuration
-  std::vector<util::Point> x_ref(d_x.size(), util::Point());
-  for (auto &x : d_x)
-    x_ref.push_back(x);
+  auto x_ref = d_x.toVector();
 
   // read displacement and velocity from restart file
   log("  Reading data from restart file = " + d_restartDeck_p->d_file + " \n");
@@ -120,6 +360,9 @@ void model::DEMModel::init() {
     appendKeyData("debug_once", -1);
     appendKeyData("update_contact_neigh_search_params_init_call_count", 0);
     appendKeyData("tree_compute_time", 0);
+    appendKeyData("contact_neigh_rebuild_count", 0);
+    appendKeyData("contact_tree_refit_count", 0);
+    appendKeyData("contact_tree_rebuild_count", 0);
     appendKeyData("contact_compute_time", 0);
     appendKeyData("contact_neigh_update_time", 0);
     appendKeyData("peridynamics_neigh_update_time", 0);
@@ -146,6 +389,18 @@ void model::DEMModel::init() {
   log(d_name + ": Creating particles.\n");
   createParticles();
 
+  // nodal data is appended node by node while creating particles, so
+  // release memory reserved beyond number of nodes
+  d_xRef.shrink_to_fit();
+  d_x.shrink_to_fit();
+  d_u.shrink_to_fit();
+  d_v.shrink_to_fit();
+  d_f.shrink_to_fit();
+  d_vMag.shrink_to_fit();
+  d_vol.shrink_to_fit();
+  d_fix.shrink_to_fit();
+  d_ptId.shrink_to_fit();
+
   log(d_name + ": Creating maximum velocity data for particles.\n");
   d_maxVelocityParticlesListTypeAll
           = std::vector<double>(d_particlesListTypeAll.size(), 0.);
@@ -164,8 +419,49 @@ void model::DEMModel::init() {
   // create search object
   log(d_name + ": Creating neighbor search tree.\n");
 
-  // create tree object
-  d_nsearch_p = std::make_unique<NSearch>(d_x, d_outputDeck_p->d_debug);
+  // create tree object (nodes of analytic walls and nodes that do not take
+  // part in contact are not added to the tree)
+  d_analyticWallReaction.resize(d_particlesListTypeWall.size());
+  setupContactNodes();
+  std::vector<size_t> search_nodes;
+  for (size_t i = 0; i < d_x.size(); i++)
+    if (d_contNodeFlag[i])
+      search_nodes.push_back(i);
+
+  const bool cell_list =
+          d_pDeck_p->d_pNeighDeck.d_searchMethod == "cell_list";
+  const bool dim_2 = d_modelDeck_p->d_dim == 2;
+  const unsigned int n_thread_build = util::parallel::getNThreads();
+  if (search_nodes.size() < d_x.size()) {
+    log(fmt::format("{}: Excluding {} nodes from search tree.\n", d_name,
+                    d_x.size() - search_nodes.size()));
+    d_nsearchCloud_p = std::make_unique<nsearch::PointCloudSubset>(
+            d_x, std::move(search_nodes));
+    if (cell_list and dim_2)
+      d_nsearch_p = std::make_unique<
+              nsearch::CellListSearch<2, nsearch::PointCloudSubset>>(
+              *d_nsearchCloud_p, d_outputDeck_p->d_debug);
+    else if (cell_list)
+      d_nsearch_p = std::make_unique<
+              nsearch::CellListSearch<3, nsearch::PointCloudSubset>>(
+              *d_nsearchCloud_p, d_outputDeck_p->d_debug);
+    else
+      d_nsearch_p = std::make_unique<
+              nsearch::NFlannSearchKd<3, nsearch::PointCloudSubset>>(
+              *d_nsearchCloud_p, d_outputDeck_p->d_debug, 10, n_thread_build);
+  } else {
+    if (cell_list and dim_2)
+      d_nsearch_p = std::make_unique<
+              nsearch::CellListSearch<2, util::PointSoA>>(
+              d_x, d_outputDeck_p->d_debug);
+    else if (cell_list)
+      d_nsearch_p = std::make_unique<
+              nsearch::CellListSearch<3, util::PointSoA>>(
+              d_x, d_outputDeck_p->d_debug);
+    else
+      d_nsearch_p = std::make_unique<NSearch>(d_x, d_outputDeck_p->d_debug,
+                                              10, n_thread_build);
+  }
 
   // setup tree
   double set_tree_time = d_nsearch_p->setInputCloud();
@@ -177,6 +473,10 @@ void model::DEMModel::init() {
   updatePeridynamicNeighborlist();
   t2 = steady_clock::now();
   appendKeyData("peridynamics_neigh_update_time", util::methods::timeDiff(t1, t2));
+  updatePeridynamicBondCache();
+
+  // select force kernels specialized for material of each particle zone
+  setupPdKernels();
 
   if (d_input_p->isMultiParticle()) {
     log(d_name + ": Creating neighborlist for contact.\n");
@@ -188,13 +488,20 @@ void model::DEMModel::init() {
     appendKeyData("contact_neigh_update_time", util::methods::timeDiff(t1, t2));
   }
 
-  // create peridynamic bonds
-  log(d_name + ": Creating peridynamics bonds.\n");
-  d_fracture_p = std::make_unique<geometry::Fracture>(&d_x, &d_neighPd);
-
-  // compute quantities in state-based simulations
+  // compute quantities in state-based simulations (nodal m_x and theta_x
+  // are not stored if all materials are bond-based)
   log(d_name + ": Compute state-based peridynamic quantities.\n");
-  material::computeStateMx(this, true);
+  bool state_active = false;
+  for (const auto &p : d_particlesListTypeAll)
+    state_active = state_active or p->getMaterial()->isStateActive();
+
+  if (state_active) {
+    material::computeStateMx(this, true);
+    d_thetaX.assign(d_x.size(), 0.);
+  } else {
+    d_mX.clear();
+    d_thetaX.clear();
+  }
 
   // initialize loading class
   log(d_name + ": Initializing displacement loading object.\n");
@@ -231,18 +538,13 @@ void model::DEMModel::init() {
   //  force on any of its node. Later, one can have control on individual
   //  nodes of particle/wall and remove from d_fCompNodes if no force is to
   //  be computed on them
-  for (size_t i = 0; i < d_x.size(); i++) {
-    const auto &ptId = d_ptId[i];
-    const auto &pi = getParticleFromAllList(ptId);
-    if (pi->d_computeForce) {
-      d_fContCompNodes.push_back(i);
-      d_fPdCompNodes.push_back(i);
-    }
-  }
+  updateForceComputeNodes();
 
   // initialize remaining fields (if any)
   d_Z = std::vector<float>(d_x.size(), 0.);
 
+  logMemoryReport();
+
   t2 = steady_clock::now();
   log(fmt::format("{}: Total setup time (ms) = {}. \n",
                   d_name, util::methods::timeDiff(t1, t2)));
@@ -299,6 +601,11 @@ void model::DEMModel::integrate() {
 
     appendKeyData("integrate_compute_time", integrate_time, true);
 
+    // sleep or wake up particles
+    if (d_modelDeck_p->d_sleepVelocityThreshold > 0. and
+        d_n % d_modelDeck_p->d_sleepCheckInterval == 0)
+      updateSleepingParticles();
+
     log(fmt::format("  Integration time (ms) = {}\n", integrate_time), 2, d_n % d_infoN == 0, 3);
 
     if (d_pDeck_p->d_testName == "two_particle") {
@@ -329,19 +636,32 @@ void model::DEMModel::integrate() {
           "  {:22s} = {:8.2f} \n"
           "  {:22s} = {:8.2f} \n"
           "  {:22s} = {:8.2f} \n"
-          "  {:22s} = {:8.2f} \n",
+          "  {:22s} = {:8.2f} \n"
+          "  {:22s} = {:8d} \n"
+          "  {:22s} = {:8d} \n"
+          "  {:22s} = {:8d} \n",
           d_name,
           "Time integration", getKeyData("integrate_compute_time") * 1.e-6,
           "Peridynamics force", getKeyData("pd_compute_time") * 1.e-6,
           "Contact force", getKeyData("contact_compute_time") * 1.e-6,
           "Search tree update", getKeyData("tree_compute_time") * 1.e-6,
-          "External force", getKeyData("extf_compute_time") * 1.e-6)
+          "External force", getKeyData("extf_compute_time") * 1.e-6,
+          "Contact list rebuilds",
+          size_t(getKeyData("contact_neigh_rebuild_count")),
+          "Contact tree refits",
+          size_t(getKeyData("contact_tree_refit_count")),
+          "Contact tree rebuilds",
+          size_t(getKeyData("contact_tree_rebuild_count")))
           );
 }
 
 void model::DEMModel::integrateStep() {
-  if (d_modelDeck_p->d_timeDiscretization == "central_difference")
-    integrateCD();
+  if (d_modelDeck_p->d_timeDiscretization == "central_difference") {
+    if (d_modelDeck_p->d_stepTaskGraph)
+      integrateCDTaskGraph();
+    else
+      integrateCD();
+  }
   else if (d_modelDeck_p->d_timeDiscretization == "velocity_verlet")
     integrateVerlet();
 }
@@ -350,33 +670,21 @@ void model::DEMModel::integrateCD() {
 
   // update velocity and displacement
   d_currentDt = d_modelDeck_p->d_dt;
-  const auto dim = d_modelDeck_p->d_dim;
 
-  tf::Executor executor(util::parallel::getNThreads());
   tf::Taskflow taskflow;
 
   // update current position, displacement, and velocity of nodes
   taskflow.for_each_index(
     (std::size_t) 0, d_fPdCompNodes.size(), (std::size_t) 1,
-      [this, dim](std::size_t II) {
+      [this](std::size_t II) {
         auto i = this->d_fPdCompNodes[II];
 
         const auto rho = this->getDensity(i);
-        const auto &fix = this->d_fix[i];
-
-        for (int dof = 0; dof < dim; dof++) {
-          if (util::methods::isFree(fix, dof)) {
-            this->d_v[i][dof] += (this->d_currentDt / rho) * this->d_f[i][dof];
-            this->d_u[i][dof] += this->d_currentDt * this->d_v[i][dof];
-            this->d_x[i][dof] += this->d_currentDt * this->d_v[i][dof];
-          }
-        }
-
-        this->d_vMag[i] = this->d_v[i].length();
+        updateNodeKinematics(this, i, this->d_currentDt / rho, this->d_currentDt);
       } // loop over nodes
   ); // for_each
 
-  executor.run(taskflow).get();
+  util::parallel::runTaskflow(taskflow);
 
   // advance time
   d_n++;
@@ -389,38 +697,198 @@ void model::DEMModel::integrateCD() {
   computeForces();
 }
 
+void model::DEMModel::integrateCDTaskGraph() {
+
+  bool dbg_condition = d_n % d_infoN == 0;
+
+  log("  Compute step task graph \n", 2, dbg_condition, 3);
+
+  d_currentDt = d_modelDeck_p->d_dt;
+
+  if (d_stepTaskflow.empty())
+    setupStepTaskGraph();
+
+  auto t1 = steady_clock::now();
+  util::parallel::runTaskflow(d_stepTaskflow);
+  auto step_time = util::methods::timeDiff(t1, steady_clock::now());
+
+  recordComputeTimes(d_stepPdTime, d_stepContactNeighTime, d_stepContactTime,
+                     d_stepExtfTime);
+
+  log(fmt::format("    {:50s} = {:8d} \n"
+                  "    {:50s} = {:8d} \n"
+                  "    {:50s} = {:8d} \n"
+                  "    {:50s} = {:8d} \n"
+                  "    {:50s} = {:8d} \n",
+                  "Step task graph time (ms)", size_t(step_time),
+                  "Peridynamics force time (ms)", size_t(d_stepPdTime),
+                  "Contact neighborlist update time (ms)",
+                  size_t(d_stepContactNeighTime),
+                  "Contact force time (ms)", size_t(d_stepContactTime),
+                  "External force time (ms)", size_t(d_stepExtfTime)),
+      2, dbg_condition, 3);
+}
+
+void model::DEMModel::setupStepTaskGraph() {
+
+  d_stepTaskflow.clear();
+  d_stepTaskflow.name("DEMModel time step");
+
+  const auto gravity = d_pDeck_p->d_gravity;
+  const bool contact = d_input_p->isMultiParticle();
+
+  // update current position, displacement, and velocity of nodes
+  auto integrate_task = d_stepTaskflow.for_each_index(
+    (std::size_t) 0, d_fPdCompNodes.size(), (std::size_t) 1,
+      [this](std::size_t II) {
+        auto i = this->d_fPdCompNodes[II];
+
+        const auto rho = this->getDensity(i);
+        updateNodeKinematics(this, i, this->d_currentDt / rho, this->d_currentDt);
+      } // loop over nodes
+  ).name("integrate");
+
+  // advance time and update displacement bc
+  auto disp_bc_task = d_stepTaskflow.emplace([this]() {
+    this->d_n++;
+    this->d_time += this->d_currentDt;
+    this->computeExternalDisplacementBC();
+  }).name("displacement_bc");
+
+  // reset force and add gravity force (fused so that the force vector is
+  // streamed only once)
+  auto reset_task = d_stepTaskflow.for_each_index(
+    (std::size_t) 0, d_x.size(), (std::size_t) 1,
+      [this, gravity](std::size_t i) {
+        this->d_f.set(i, this->getDensity(i) * gravity);
+      } // loop over nodes
+  ).name("force_reset");
+
+  // peridynamic force (adds to force vector)
+  auto pd_task = d_stepTaskflow.emplace([this]() {
+    auto t1 = steady_clock::now();
+    this->computePeridynamicForces();
+    this->d_stepPdTime = util::methods::timeDiff(t1, steady_clock::now());
+  }).name("peridynamic_force");
+
+  // external force due to loading
+  auto extf_task = d_stepTaskflow.emplace([this]() {
+    auto t1 = steady_clock::now();
+    for (auto &p : this->d_particlesListTypeAll)
+      this->d_fLoading_p->apply(this->d_time, p);
+    this->d_stepExtfTime = util::methods::timeDiff(t1, steady_clock::now());
+  }).name("external_force");
+
+  integrate_task.precede(disp_bc_task, reset_task);
+  pd_task.succeed(disp_bc_task, reset_task);
+
+  if (contact) {
+    // contact neighborlist only depends on the current position of nodes and
+    // therefore the search tree rebuild overlaps the peridynamic force
+    auto contact_neigh_task = d_stepTaskflow.emplace([this]() {
+      auto t1 = steady_clock::now();
+      this->updateContactNeighborlist();
+      this->d_stepContactNeighTime = util::methods::timeDiff(t1, steady_clock::now());
+    }).name("contact_neighborlist");
+
+    auto contact_task = d_stepTaskflow.emplace([this]() {
+      auto t1 = steady_clock::now();
+      this->computeContactForces();
+      this->d_stepContactTime = util::methods::timeDiff(t1, steady_clock::now());
+    }).name("contact_force");
+
+    contact_neigh_task.succeed(disp_bc_task);
+    contact_task.succeed(pd_task, contact_neigh_task);
+    extf_task.succeed(contact_task);
+  } else
+    extf_task.succeed(pd_task);
+}
+
+void model::DEMModel::recordComputeTimes(double pd_time,
+                                         double contact_neigh_time,
+                                         double contact_time,
+                                         double extf_time) {
+
+  bool dbg_condition = d_n % d_infoN == 0;
+
+  appendKeyData("pd_compute_time", pd_time);
+  appendKeyData("avg_peridynamics_force_time", pd_time/d_infoN);
+  if (d_input_p->isMultiParticle()) {
+    appendKeyData("contact_neigh_update_time", contact_neigh_time);
+    appendKeyData("avg_contact_neigh_update_time",
+                  contact_neigh_time / d_infoN);
+    appendKeyData("contact_compute_time", contact_time);
+    appendKeyData("avg_contact_force_time", contact_time / d_infoN);
+  }
+  appendKeyData("extf_compute_time", extf_time);
+  appendKeyData("avg_extf_compute_time", extf_time/d_infoN);
+
+  if (dbg_condition) {
+    if (d_input_p->isMultiParticle()) {
+      log(fmt::format("    Avg time (ms): \n"
+                      "      {:48s} = {:8d}\n"
+                      "      {:48s} = {:8d}\n"
+                      "      {:48s} = {:8d}\n"
+                      "      {:48s} = {:8d}\n"
+                      "      {:48s} = {:8d}\n"
+                      "      {:48s} = {:8d}\n",
+                      "tree update", size_t(getKeyData("avg_tree_update_time")),
+                      "contact neigh update",
+                      size_t(getKeyData("avg_contact_neigh_update_time")),
+                      "contact force",
+                      size_t(getKeyData("avg_contact_force_time")),
+                      "total contact", size_t(getKeyData("avg_tree_update_time")
+                                              + getKeyData(
+                          "avg_contact_neigh_update_time")
+                                              + getKeyData(
+                          "avg_contact_force_time")),
+                      "peridynamics force",
+                      size_t(getKeyData("avg_peridynamics_force_time")),
+                      "external force",
+                      size_t(getKeyData("avg_extf_compute_time") / d_infoN)),
+          2, dbg_condition, 3);
+
+      appendKeyData("avg_tree_update_time", 0.);
+      appendKeyData("avg_contact_neigh_update_time", 0.);
+      appendKeyData("avg_contact_force_time", 0.);
+      appendKeyData("avg_peridynamics_force_time", 0.);
+      appendKeyData("avg_extf_compute_time", 0.);
+    }
+    else {
+      log(fmt::format("    Avg time (ms): \n"
+                      "      {:48s} = {:8d}\n"
+                      "      {:48s} = {:8d}\n",
+                      "peridynamics force", size_t(getKeyData("avg_peridynamics_force_time")),
+                      "external force", size_t(getKeyData("avg_extf_compute_time")/d_infoN)),
+          2, dbg_condition, 3);
+
+      appendKeyData("avg_peridynamics_force_time", 0.);
+      appendKeyData("avg_extf_compute_time", 0.);
+    }
+  }
+}
+
 void model::DEMModel::integrateVerlet() {
 
   // update velocity and displacement
   d_currentDt = d_modelDeck_p->d_dt;
-  const auto dim = d_modelDeck_p->d_dim;
 
   // update current position, displacement, and velocity of nodes
   {
-    tf::Executor executor(util::parallel::getNThreads());
     tf::Taskflow taskflow;
 
     taskflow.for_each_index(
       (std::size_t) 0, d_fPdCompNodes.size(), (std::size_t) 1,
-        [this, dim](std::size_t II) {
+        [this](std::size_t II) {
           auto i = this->d_fPdCompNodes[II];
 
           const auto rho = this->getDensity(i);
-          const auto &fix = this->d_fix[i];
-
-          for (int dof = 0; dof < dim; dof++) {
-            if (util::methods::isFree(fix, dof)) {
-              this->d_v[i][dof] += 0.5 * (this->d_currentDt / rho) * this->d_f[i][dof];
-              this->d_u[i][dof] += this->d_currentDt * this->d_v[i][dof];
-              this->d_x[i][dof] += this->d_currentDt * this->d_v[i][dof];
-            }
-
-            this->d_vMag[i] = this->d_v[i].length();
-          }
+          updateNodeKinematics(this, i, 0.5 * this->d_currentDt / rho,
+                               this->d_currentDt);
         } // loop over nodes
     ); // for_each
 
-    executor.run(taskflow).get();
+    util::parallel::runTaskflow(taskflow);
   }
 
   // advance time
@@ -435,27 +903,20 @@ void model::DEMModel::integrateVerlet() {
 
   // update velocity of nodes
   {
-    tf::Executor executor(util::parallel::getNThreads());
     tf::Taskflow taskflow;
 
     taskflow.for_each_index(
       (std::size_t) 0, d_fPdCompNodes.size(), (std::size_t) 1,
-      [this, dim](std::size_t II) {
+      [this](std::size_t II) {
         auto i = this->d_fPdCompNodes[II];
 
+        // only velocity is updated
         const auto rho = this->getDensity(i);
-        const auto &fix = this->d_fix[i];
-        for (int dof = 0; dof < dim; dof++) {
-          if (util::methods::isFree(fix, dof)) {
-            this->d_v[i][dof] += 0.5 * (this->d_currentDt / rho) * this->d_f[i][dof];
-          }
-
-          this->d_vMag[i] = this->d_v[i].length();
-        }
+        updateNodeKinematics(this, i, 0.5 * this->d_currentDt / rho, 0.);
       } // loop over nodes
     ); // for_each
 
-    executor.run(taskflow).get();
+    util::parallel::runTaskflow(taskflow);
   }
 }
 
@@ -467,96 +928,41 @@ void model::DEMModel::computeForces() {
 
   // reset force
   auto t1 = steady_clock::now();
-  tf::Executor executor(util::parallel::getNThreads());
   tf::Taskflow taskflow;
 
   taskflow.for_each_index(
     (std::size_t) 0, d_x.size(), (std::size_t) 1,
-      [this](std::size_t i) { this->d_f[i] = util::Point(); }
+      [this](std::size_t i) { this->d_f.set(i, util::Point()); }
   ); // for_each
 
-  executor.run(taskflow).get();
+  util::parallel::runTaskflow(taskflow);
   auto force_reset_time = util::methods::timeDiff(t1, steady_clock::now());
 
   // compute peridynamic forces
   t1 = steady_clock::now();
   computePeridynamicForces();
   auto pd_time = util::methods::timeDiff(t1, steady_clock::now());
-  appendKeyData("pd_compute_time", pd_time);
-  appendKeyData("avg_peridynamics_force_time", pd_time/d_infoN);
 
-  float current_contact_neigh_update_time = 0;
-  float contact_time = 0;
+  double contact_neigh_time = 0.;
+  double contact_time = 0.;
   if (d_input_p->isMultiParticle()) {
     // update contact neighborlist
     t1 = steady_clock::now();
     updateContactNeighborlist();
-    auto current_contact_neigh_update_time = util::methods::timeDiff(t1,
-                                                                     steady_clock::now());
-    appendKeyData("contact_neigh_update_time",
-                  current_contact_neigh_update_time);
-    appendKeyData("avg_contact_neigh_update_time",
-                  current_contact_neigh_update_time / d_infoN);
+    contact_neigh_time = util::methods::timeDiff(t1, steady_clock::now());
 
     // compute contact forces between particles
     t1 = steady_clock::now();
     computeContactForces();
-    auto contact_time = util::methods::timeDiff(t1, steady_clock::now());
-    appendKeyData("contact_compute_time", contact_time);
-    appendKeyData("avg_contact_force_time", contact_time / d_infoN);
+    contact_time = util::methods::timeDiff(t1, steady_clock::now());
   }
 
   // Compute external forces
   t1 = steady_clock::now();
   computeExternalForces();
   auto extf_time = util::methods::timeDiff(t1, steady_clock::now());
-  appendKeyData("extf_compute_time", extf_time);
-  appendKeyData("avg_extf_compute_time", extf_time/d_infoN);
 
-  // output avg time info
-  if (dbg_condition) {
-    if (d_input_p->isMultiParticle()) {
-      log(fmt::format("    Avg time (ms): \n"
-                      "      {:48s} = {:8d}\n"
-                      "      {:48s} = {:8d}\n"
-                      "      {:48s} = {:8d}\n"
-                      "      {:48s} = {:8d}\n"
-                      "      {:48s} = {:8d}\n"
-                      "      {:48s} = {:8d}\n",
-                      "tree update", size_t(getKeyData("avg_tree_update_time")),
-                      "contact neigh update",
-                      size_t(getKeyData("avg_contact_neigh_update_time")),
-                      "contact force",
-                      size_t(getKeyData("avg_contact_force_time")),
-                      "total contact", size_t(getKeyData("avg_tree_update_time")
-                                              + getKeyData(
-                          "avg_contact_neigh_update_time")
-                                              + getKeyData(
-                          "avg_contact_force_time")),
-                      "peridynamics force",
-                      size_t(getKeyData("avg_peridynamics_force_time")),
-                      "external force",
-                      size_t(getKeyData("avg_extf_compute_time") / d_infoN)),
-          2, dbg_condition, 3);
-
-      appendKeyData("avg_tree_update_time", 0.);
-      appendKeyData("avg_contact_neigh_update_time", 0.);
-      appendKeyData("avg_contact_force_time", 0.);
-      appendKeyData("avg_peridynamics_force_time", 0.);
-      appendKeyData("avg_extf_compute_time", 0.);
-    }
-    else {
-      log(fmt::format("    Avg time (ms): \n"
-                      "      {:48s} = {:8d}\n"
-                      "      {:48s} = {:8d}\n",
-                      "peridynamics force", size_t(getKeyData("avg_peridynamics_force_time")),
-                      "external force", size_t(getKeyData("avg_extf_compute_time")/d_infoN)),
-          2, dbg_condition, 3);
-
-      appendKeyData("avg_peridynamics_force_time", 0.);
-      appendKeyData("avg_extf_compute_time", 0.);
-    }
-  }
+  recordComputeTimes(pd_time, contact_neigh_time, contact_time, extf_time);
 
   log(fmt::format("    {:50s} = {:8d} \n",
                   "Force reset time (ms)",
@@ -586,7 +992,7 @@ void model::DEMModel::computeForces() {
 
     log(fmt::format("    {:50s} = {:8d} \n",
                     "Contact neighborlist update time (ms)",
-                    size_t(current_contact_neigh_update_time)
+                    size_t(contact_neigh_time)
         ),
         2, dbg_condition, 3);
 
@@ -603,189 +1009,125 @@ void model::DEMModel::computePeridynamicForces() {
 
   log("    Computing peridynamic force \n", 3);
 
-  const auto dim = d_modelDeck_p->d_dim;
   const bool is_state = d_particlesListTypeAll[0]->getMaterial()->isStateActive();
 
+  // move broken bonds out of the list of bonds if needed
+  if (d_modelDeck_p->d_pdBondCompactionThreshold > 0. and d_n > 0 and
+      d_n % d_modelDeck_p->d_pdBondCompactionInterval == 0)
+    compactPeridynamicBonds();
+
+  // use cached reference quantities of bonds if available
+  const bool use_cache =
+      !d_bondsPdLength.empty() or !d_bondsPdLengthF.empty();
+  const bool use_broken = d_bondsPdBroken.numBonds() > 0;
+
+  if (d_modelDeck_p->d_pdHalfBonds) {
+    computeHalfBondPeridynamicForces(use_cache);
+    return;
+  }
+
   // compute state-based helper quantities
   if (is_state) {
 
-    tf::Executor executor(util::parallel::getNThreads());
     tf::Taskflow taskflow;
 
     taskflow.for_each_index(
-      (std::size_t) 0, d_fPdCompNodes.size(), (std::size_t) 1, [this](std::size_t II) {
+      (std::size_t) 0, d_fPdCompNodes.size(), (std::size_t) 1, [this, use_cache](std::size_t II) {
         auto i = this->d_fPdCompNodes[II];
-
-        const auto rho = this->getDensity(i);
-        const auto &fix = this->d_fix[i];
-        const auto &ptId = this->getPtId(i);
-        auto &pi = this->getParticleFromAllList(ptId);
-
-        if (pi->d_material_p->isStateActive()) {
-
-          const double horizon = pi->getHorizon();
-          const double mesh_size = pi->getMeshSize();
-          const auto &xi = this->d_xRef[i];
-          const auto &ui = this->d_u[i];
-
-          // update bond state and compute thetax
-          const auto &m = this->d_mX[i];
-          double theta = 0.;
-
-          // upper and lower bound for volume correction
-          auto check_up = horizon + 0.5 * mesh_size;
-          auto check_low = horizon - 0.5 * mesh_size;
-
-          size_t k = 0;
-          for (size_t j : this->d_neighPd[i]) {
-
-            const auto &xj = this->d_xRef[j];
-            const auto &uj = this->d_u[j];
-            double rji = (xj - xi).length();
-            // double rji = std::sqrt(this->d_neighPdSqdDist[i][k]);
-            double change_length = (xj - xi + uj - ui).length() - rji;
-
-            // step 1: update the bond state
-            double s = change_length / rji;
-            double sc = pi->d_material_p->getSc(rji);
-
-            // get fracture state, modify, and set
-            auto fs = this->d_fracture_p->getBondState(i, k);
-            if (!fs && util::isGreater(std::abs(s), sc + 1.0e-10))
-              fs = true;
-            this->d_fracture_p->setBondState(i, k, fs);
-
-            if (!fs) {
-
-              // get corrected volume of node j
-              auto volj = this->d_vol[j];
-
-              if (util::isGreater(rji, check_low))
-                volj *= (check_up - rji) / mesh_size;
-
-              theta += rji * change_length * pi->d_material_p->getInfFn(rji) *
-                        volj;
-            } // if bond is not broken
-
-            k += 1;
-          } // loop over neighbors
-
-          this->d_thetaX[i] = 3. * theta / m;
-        } // if it is state-based
+        this->d_pdKernels[this->getPtId(i)].d_stateFn(this, i, use_cache);
       } // loop over nodes
     ); // for_each
 
-    executor.run(taskflow).get();
+    util::parallel::runTaskflow(taskflow);
   }
 
   // compute the internal forces
-  tf::Executor executor(util::parallel::getNThreads());
   tf::Taskflow taskflow;
 
   taskflow.for_each_index(
-    (std::size_t) 0, d_fPdCompNodes.size(), (std::size_t) 1, [this](std::size_t II) {
+    (std::size_t) 0, d_fPdCompNodes.size(), (std::size_t) 1, [this, use_cache, use_broken](std::size_t II) {
       auto i = this->d_fPdCompNodes[II];
+      const auto &kernels = this->d_pdKernels[this->getPtId(i)];
+      kernels.d_forceFn(this, i, use_cache);
+      if (use_broken)
+        kernels.d_brokenFn(this, i, use_cache);
+    }
+  ); // for_each
 
-      // local variable to hold force
-      util::Point force_i = util::Point();
-      double scalar_f = 0.;
+  util::parallel::runTaskflow(taskflow);
+}
 
-      // for damage
-      float Zi = 0.;
+void model::DEMModel::computeHalfBondPeridynamicForces(bool use_cache) {
 
-      const auto rhoi = this->getDensity(i);
-      const auto &ptIdi = this->getPtId(i);
-      auto &pi = this->getParticleFromAllList(ptIdi);
+  const auto n_nodes = d_fPdCompNodes.size();
+  if (n_nodes == 0)
+    return;
 
-      const double horizon = pi->getHorizon();
-      const double mesh_size = pi->getMeshSize();
-      const auto &xi = this->d_xRef[i];
-      const auto &ui = this->d_u[i];
-      const auto &mi = this->d_mX[i];
-      const auto &thetai = this->d_thetaX[i];
+  const size_t n_chunks =
+      std::min<size_t>(util::parallel::getNThreads(), n_nodes);
+  d_pdHalfBondBuffers.resize(n_chunks);
 
-      // upper and lower bound for volume correction
-      auto check_up = horizon + 0.5 * mesh_size;
-      auto check_low = horizon - 0.5 * mesh_size;
+  tf::Taskflow taskflow;
 
-      // loop over neighbors
-      {
-        size_t k = 0;
-        for (size_t j : this->d_neighPd[i]) {
-          auto fs = this->d_fracture_p->getBondState(i, k);
-          const auto &xj = this->d_xRef[j];
-          const auto &uj = this->d_u[j];
-          auto volj = this->d_vol[j];
-          double rji = (xj - xi).length();
-          double Sji = pi->d_material_p->getS(xj - xi, uj - ui);
-
-          if (!fs) {
-            const auto &mj = this->d_mX[j];
-            const auto &thetaj = this->d_thetaX[j];
-
-            // get corrected volume of node j
-            if (util::isGreater(rji, check_low))
-              volj *= (check_up - rji) / mesh_size;
-
-            // handle two cases differently
-            if (pi->d_material_p->isStateActive()) {
-
-              auto ef_i =
-                  pi->d_material_p->getBondEF(rji, Sji, fs, mi, thetai);
-              auto ef_j =
-                  pi->d_material_p->getBondEF(rji, Sji, fs, mj, thetaj);
-
-              // compute the contribution of bond force to force at i
-              scalar_f = (ef_i.second + ef_j.second) * volj;
-
-              force_i += scalar_f * pi->d_material_p->getBondForceDirection(
-                                        xj - xi, uj - ui);
-            } // if state-based
-            else {
-
-              // Debug
-              bool break_bonds = true;
-
-              auto ef =
-                  pi->d_material_p->getBondEF(rji, Sji, fs, break_bonds);
-              this->d_fracture_p->setBondState(i, k, fs);
-
-              // compute the contribution of bond force to force at i
-              scalar_f = ef.second * volj;
-
-              force_i += scalar_f * pi->d_material_p->getBondForceDirection(
-                                        xj - xi, uj - ui);
-            } // if bond-based
-          }   // if bond not broken
-          else {
-            // add normal contact force
-            auto yji = xj + uj - (xi + ui);
-            auto Rji = yji.length();
-            scalar_f = pi->d_Kn * volj * (Rji - pi->d_Rc) / Rji;
-            if (scalar_f > 0.)
-              scalar_f = 0.;
-            force_i += scalar_f * yji;
-          } // if bond is broken
-
-          // calculate damage
-          auto Sc = pi->d_material_p->getSc(rji);
-          if (util::isGreater(std::abs(Sji / Sc), Zi))
-            Zi = std::abs(Sji / Sc);
-
-          k++;
-        } // loop over neighbors
+  auto force_task = taskflow.for_each_index(
+    (std::size_t) 0, n_chunks, (std::size_t) 1,
+      [this, use_cache, n_nodes, n_chunks](std::size_t c) {
+
+        const auto II_start = c * n_nodes / n_chunks;
+        const auto II_end = (c + 1) * n_nodes / n_chunks;
+
+        // buffer covers nodes of chunk and their neighbors (neighbors have
+        // larger id, see updatePeridynamicNeighborlist())
+        const auto start = this->d_fPdCompNodes[II_start];
+        auto end = this->d_fPdCompNodes[II_end - 1] + 1;
+        for (auto II = II_start; II < II_end; II++) {
+          const auto i = this->d_fPdCompNodes[II];
+          for (auto b = this->d_bondsPd.begin(i); b < this->d_bondsPd.end(i); b++)
+            end = std::max(end, this->d_bondsPd.getNeighbor(b) + 1);
+          if (this->d_bondsPdBroken.numNodes() > 0)
+            for (auto b = this->d_bondsPdBroken.begin(i);
+                 b < this->d_bondsPdBroken.end(i); b++)
+              end = std::max(end, this->d_bondsPdBroken.getNeighbor(b) + 1);
+        }
+
+        auto &buffer = this->d_pdHalfBondBuffers[c];
+        buffer.d_start = start;
+        buffer.d_f.assign(end - start, util::Point());
+        buffer.d_Z.assign(end - start, 0.);
 
-      } // peridynamic force
+        for (auto II = II_start; II < II_end; II++) {
+          const auto i = this->d_fPdCompNodes[II];
+          this->d_pdKernels[this->getPtId(i)].d_halfForceFn(this, i, use_cache,
+                                                            buffer);
+        }
+      }
+  ); // for_each
 
-      // update force (we remove any force from
-      // previous steps and add peridynamics force)
-      this->d_f[i] = force_i;
+  // sum buffers in chunk order (buffers are sorted by their first node)
+  auto gather_task = taskflow.for_each_index(
+    (std::size_t) 0, n_nodes, (std::size_t) 1, [this](std::size_t II) {
+      const auto i = this->d_fPdCompNodes[II];
 
+      util::Point force_i = util::Point();
+      float Zi = 0.;
+      for (const auto &buffer : this->d_pdHalfBondBuffers) {
+        if (i < buffer.d_start)
+          break;
+        if (i - buffer.d_start < buffer.d_f.size()) {
+          force_i += buffer.d_f[i - buffer.d_start];
+          Zi = std::max(Zi, buffer.d_Z[i - buffer.d_start]);
+        }
+      }
+
+      // force is reset before this function is called
+      this->d_f.add(i, force_i);
       this->d_Z[i] = Zi;
     }
   ); // for_each
 
-  executor.run(taskflow).get();
+  force_task.precede(gather_task);
+
+  util::parallel::runTaskflow(taskflow);
 }
 
 void model::DEMModel::computeExternalForces() {
@@ -795,15 +1137,14 @@ void model::DEMModel::computeExternalForces() {
   auto gravity = d_pDeck_p->d_gravity;
 
   if (gravity.length() > 1.0E-8) {
-    tf::Executor executor(util::parallel::getNThreads());
     tf::Taskflow taskflow;
 
     taskflow.for_each_index((std::size_t) 0, d_x.size(), (std::size_t)1, [this, gravity](std::size_t i) {
-          this->d_f[i] += this->getDensity(i) * gravity;
+          this->d_f.add(i, this->getDensity(i) * gravity);
       } // loop over particles
     ); // for_each
 
-    executor.run(taskflow).get();
+    util::parallel::runTaskflow(taskflow);
   }
 
   //
@@ -826,243 +1167,520 @@ void model::DEMModel::computeContactForces() {
   // 2. Normal damping is applied between particle centers
   // 3. Normal damping is applied between nodes of particle and wall pairs
 
-  tf::Executor executor(util::parallel::getNThreads());
+  if (d_modelDeck_p->d_contactHalfPairs) {
+    computeHalfPairContactForces();
+  } else {
+    tf::Taskflow taskflow;
+
+    taskflow.for_each_index((std::size_t) 0,
+                            d_fContCompNodes.size(),
+                            (std::size_t) 1,
+                            [this](std::size_t II) {
+
+                                auto i = this->d_fContCompNodes[II];
+
+                                // local variable to hold force
+                                util::Point force_i = util::Point();
+                                double scalar_f = 0.;
+
+                                const auto &ptIdi = this->getPtId(i);
+                                auto &pi = this->getParticleFromAllList(ptIdi);
+                                double horizon = pi->d_material_p->getHorizon();
+                                double search_r = this->d_maxContactR;
+
+                                // particle data
+                                double rhoi = pi->getDensity();
+
+                                const auto yi = this->d_x.get(i); // current coordinates
+                                const auto ui = this->d_u.get(i);
+                                const auto vi = this->d_v.get(i);
+                                const auto &voli = this->d_vol[i];
+
+                                const std::vector<size_t> &neighs = this->d_neighC[i];
+
+                                if (neighs.size() > 0) {
+
+                                  for (const auto &j_id: neighs) {
+
+                                    //auto &j_id = neighs[j];
+                                    const auto yj = this->d_x.get(j_id); // current coordinates
+                                    double Rji = (yj - yi).length();
+                                    auto &ptIdj = this->d_ptId[j_id];
+                                    auto &pj = this->getParticleFromAllList(ptIdj);
+                                    double rhoj = pj->getDensity();
+
+                                    bool both_walls =
+                                            (pi->getTypeIndex() == 1 and pj->getTypeIndex() == 1);
+
+                                    if (j_id != i) {
+                                      if (ptIdj != ptIdi && !both_walls) {
+
+                                        // apply particle-particle or particle-wall contact here
+                                        const auto &contact =
+                                                d_cDeck_p->getContact(pi->d_zoneId, pj->d_zoneId);
+
+                                        if (util::isLess(Rji, contact.d_contactR)) {
+
+                                          auto yji = this->d_x.get(j_id) - yi;
+                                          auto volj = this->d_vol[j_id];
+                                          auto vji = this->d_v.get(j_id) - vi;
+
+                                          // resolve velocity vector in normal and tangential components
+                                          auto en = yji / Rji;
+                                          auto vn_mag = (vji * en);
+                                          auto et = vji - vn_mag * en;
+                                          if (util::isGreater(et.length(), 0.))
+                                            et = et / et.length();
+                                          else
+                                            et = util::Point();
+
+                                          // Formula using bulk modulus and horizon
+                                          scalar_f = contact.d_Kn * (Rji - contact.d_contactR) *
+                                                     volj; // divided by voli
+                                          if (scalar_f > 0.)
+                                            scalar_f = 0.;
+                                          force_i += scalar_f * en;
+
+                                          // compute friction force (since f < 0, |f| = -f)
+                                          force_i += contact.d_mu * scalar_f * et;
+
+                                          // if particle-wall pair, apply damping contact here <--
+                                          // doesnt seem to work
+                                          bool node_lvl_damp = false;
+                                          // if (pi->getTypeIndex() == 0 and pj->getTypeIndex() == 1)
+                                          //   node_lvl_damp = true;
+
+                                          if (node_lvl_damp) {
+                                            // apply damping at the node level
+                                            auto meq = util::equivalentMass(rhoi * voli, rhoj * volj);
+                                            auto beta_n =
+                                                    contact.d_betan *
+                                                    std::sqrt(contact.d_kappa * contact.d_contactR * meq);
+
+                                            auto &pii = this->d_particlesListTypeAll[pi->getId()];
+                                            vji = this->d_v.get(j_id) - pii->getVCenter();
+                                            vn_mag = (vji * en);
+                                            if (vn_mag > 0.)
+                                              vn_mag = 0.;
+                                            force_i += beta_n * vn_mag * en / voli;
+                                          }
+                                        } // within contact radius
+                                      }   // particle-particle contact
+                                    }     // if j_id is not i
+                                  }       // loop over neighbors
+                                }         // contact neighbor
+
+                                this->d_f.add(i, force_i);
+                            }
+    ); // for_each
+
+    util::parallel::runTaskflow(taskflow);
+  }
+
+  // contact with analytic walls
+  computeAnalyticWallContactForces();
+
+  // damping force
+  computeDampingForces();
+}
+
+void model::DEMModel::computeHalfPairContactForces() {
+
+  const auto n_pairs = d_neighCOffset.empty() ? 0 : d_neighCOffset.back();
+  d_contPairForce.resize(2 * n_pairs);
+
+  tf::Taskflow taskflow;
+
+  // force of each pair (i, j) in list of node i; force density on j is
+  // -f_ij vol_i / vol_j when force density on i is f_ij
+  auto pair_task = taskflow.for_each_index(
+    (std::size_t) 0, d_neighC.size(), (std::size_t) 1,
+      [this](std::size_t i) {
+
+        const auto &neighs = this->d_neighC[i];
+        if (neighs.empty())
+          return;
+
+        const auto &pi = this->getParticleFromAllList(this->d_ptId[i]);
+        const auto yi = this->d_x.get(i);
+        const auto vi = this->d_v.get(i);
+        const auto voli = this->d_vol[i];
+        const auto offset = this->d_neighCOffset[i];
+
+        for (size_t k = 0; k < neighs.size(); k++) {
+
+          const auto j_id = neighs[k];
+          auto &fi = this->d_contPairForce[2 * (offset + k)];
+          auto &fj = this->d_contPairForce[2 * (offset + k) + 1];
+          fi = util::Point();
+          fj = util::Point();
+
+          const auto &pj = this->getParticleFromAllList(this->d_ptId[j_id]);
+          const auto &contact =
+                  this->d_cDeck_p->getContact(pi->d_zoneId, pj->d_zoneId);
+
+          auto yji = this->d_x.get(j_id) - yi;
+          double Rji = yji.length();
+          if (!util::isLess(Rji, contact.d_contactR))
+            continue;
+
+          // resolve velocity vector in normal and tangential components
+          auto vji = this->d_v.get(j_id) - vi;
+          auto en = yji / Rji;
+          auto vn_mag = (vji * en);
+          auto et = vji - vn_mag * en;
+          if (util::isGreater(et.length(), 0.))
+            et = et / et.length();
+          else
+            et = util::Point();
+
+          // normal and friction force (without volume of other node)
+          double scalar_f = contact.d_Kn * (Rji - contact.d_contactR);
+          if (scalar_f > 0.)
+            scalar_f = 0.;
+          auto force = scalar_f * en + contact.d_mu * scalar_f * et;
+
+          fi = force * this->d_vol[j_id];
+          fj = force * (-voli);
+        } // loop over neighbors
+      }
+  ); // for_each
+
+  // gather forces of pairs at nodes
+  auto gather_task = taskflow.for_each_index(
+    (std::size_t) 0, d_fContCompNodes.size(), (std::size_t) 1,
+      [this](std::size_t II) {
+
+        auto i = this->d_fContCompNodes[II];
+
+        util::Point force_i = util::Point();
+        for (size_t p = this->d_neighCOffset[i];
+             p < this->d_neighCOffset[i + 1]; p++)
+          force_i += this->d_contPairForce[2 * p];
+
+        for (size_t k = this->d_neighCRevOffset[i];
+             k < this->d_neighCRevOffset[i + 1]; k++)
+          force_i += this->d_contPairForce[2 * this->d_neighCRev[k] + 1];
+
+        this->d_f.add(i, force_i);
+      }
+  ); // for_each
+
+  pair_task.precede(gather_task);
+
+  util::parallel::runTaskflow(taskflow);
+}
+
+void model::DEMModel::computeDampingForces() {
+
+  log("    Computing normal damping force \n", 3);
+
+  const auto np = d_particlesListTypeParticle.size();
+  const auto nw = d_particlesListTypeWall.size();
+  if (np == 0)
+    return;
+
+  // broad phase: tree over particle centers. Particles pi and pj are in
+  // contact only if |xc_j - xc_i| < Ri + Rj + 1.01 Rc, so searching within
+  // Ri + max(Rj) + 1.01 max(Rc) gives all candidates
+  std::vector<util::Point> xc(np);
+  std::vector<double> rad(np);
+  double rad_max = 0.;
+  for (size_t p = 0; p < np; p++) {
+    xc[p] = d_particlesListTypeParticle[p]->getXCenter();
+    rad[p] = d_particlesListTypeParticle[p]->d_geom_p->boundingRadius();
+    rad_max = std::max(rad_max, rad[p]);
+  }
+
+  nsearch::NFlannSearchKd<3> center_tree(xc);
+  center_tree.setInputCloud();
+
+  // damping force of each particle and reaction of each particle on analytic
+  // walls; reactions are summed after the parallel loop so that the result
+  // does not depend on the order in which particles are processed
+  std::vector<util::Point> force(np);
+  std::vector<util::Point> wall_reaction(np * nw);
+  const auto wall_pose = getAnalyticWallPoses(this);
+
   tf::Taskflow taskflow;
 
-  taskflow.for_each_index((std::size_t) 0,
-                          d_fContCompNodes.size(),
-                          (std::size_t) 1,
-                          [this](std::size_t II) {
-
-                              auto i = this->d_fContCompNodes[II];
-
-                              // local variable to hold force
-                              util::Point force_i = util::Point();
-                              double scalar_f = 0.;
-
-                              const auto &ptIdi = this->getPtId(i);
-                              auto &pi = this->getParticleFromAllList(ptIdi);
-                              double horizon = pi->d_material_p->getHorizon();
-                              double search_r = this->d_maxContactR;
-
-                              // particle data
-                              double rhoi = pi->getDensity();
-
-                              const auto &yi = this->d_x[i]; // current coordinates
-                              const auto &ui = this->d_u[i];
-                              const auto &vi = this->d_v[i];
-                              const auto &voli = this->d_vol[i];
-
-                              const std::vector<size_t> &neighs = this->d_neighC[i];
-
-                              if (neighs.size() > 0) {
-
-                                for (const auto &j_id: neighs) {
-
-                                  //auto &j_id = neighs[j];
-                                  const auto &yj = this->d_x[j_id]; // current coordinates
-                                  double Rji = (yj - yi).length();
-                                  auto &ptIdj = this->d_ptId[j_id];
-                                  auto &pj = this->getParticleFromAllList(ptIdj);
-                                  double rhoj = pj->getDensity();
-
-                                  bool both_walls =
-                                          (pi->getTypeIndex() == 1 and pj->getTypeIndex() == 1);
-
-                                  if (j_id != i) {
-                                    if (ptIdj != ptIdi && !both_walls) {
-
-                                      // apply particle-particle or particle-wall contact here
-                                      const auto &contact =
-                                              d_cDeck_p->getContact(pi->d_zoneId, pj->d_zoneId);
-
-                                      if (util::isLess(Rji, contact.d_contactR)) {
-
-                                        auto yji = this->d_x[j_id] - yi;
-                                        auto volj = this->d_vol[j_id];
-                                        auto vji = this->d_v[j_id] - vi;
-
-                                        // resolve velocity vector in normal and tangential components
-                                        auto en = yji / Rji;
-                                        auto vn_mag = (vji * en);
-                                        auto et = vji - vn_mag * en;
-                                        if (util::isGreater(et.length(), 0.))
-                                          et = et / et.length();
-                                        else
-                                          et = util::Point();
-
-                                        // Formula using bulk modulus and horizon
-                                        scalar_f = contact.d_Kn * (Rji - contact.d_contactR) *
-                                                   volj; // divided by voli
-                                        if (scalar_f > 0.)
-                                          scalar_f = 0.;
-                                        force_i += scalar_f * en;
-
-                                        // compute friction force (since f < 0, |f| = -f)
-                                        force_i += contact.d_mu * scalar_f * et;
-
-                                        // if particle-wall pair, apply damping contact here <--
-                                        // doesnt seem to work
-                                        bool node_lvl_damp = false;
-                                        // if (pi->getTypeIndex() == 0 and pj->getTypeIndex() == 1)
-                                        //   node_lvl_damp = true;
-
-                                        if (node_lvl_damp) {
-                                          // apply damping at the node level
-                                          auto meq = util::equivalentMass(rhoi * voli, rhoj * volj);
-                                          auto beta_n =
-                                                  contact.d_betan *
-                                                  std::sqrt(contact.d_kappa * contact.d_contactR * meq);
-
-                                          auto &pii = this->d_particlesListTypeAll[pi->getId()];
-                                          vji = this->d_v[j_id] - pii->getVCenter();
-                                          vn_mag = (vji * en);
-                                          if (vn_mag > 0.)
-                                            vn_mag = 0.;
-                                          force_i += beta_n * vn_mag * en / voli;
-                                        }
-                                      } // within contact radius
-                                    }   // particle-particle contact
-                                  }     // if j_id is not i
-                                }       // loop over neighbors
-                              }         // contact neighbor
-
-                              this->d_f[i] += force_i;
-                          }
-  ); // for_each
+  auto damping = taskflow.for_each_index(
+    (std::size_t) 0, np, (std::size_t) 1,
+      [this, &xc, &rad, rad_max, &center_tree, &force, &wall_reaction,
+       &wall_pose, nw](std::size_t p) {
+
+      const auto &pi = this->d_particlesListTypeParticle[p];
+      auto pi_id = pi->getId();
+
+      double Ri = rad[p];
+      double vol_pi = M_PI * Ri * Ri;
+      auto pi_xc = xc[p];
+      auto pi_vc = pi->getVCenter();
+      auto rhoi = pi->getDensity();
+      util::Point force_i = util::Point();
+
+      // particle-particle (candidates from broad phase are sorted so that
+      // forces are added in the same order as in a loop over all particles)
+      auto &buffer = nsearch::getThreadSearchBuffer();
+      auto &neighs = buffer.d_neighs;
+      center_tree.radiusSearch(pi_xc, Ri + rad_max + 1.01 * this->d_maxContactR,
+                               neighs, buffer.d_sqrDist);
+      std::sort(neighs.begin(), neighs.end());
+
+      for (auto q : neighs) {
+        if (q != p) {
+          const auto &pj = this->d_particlesListTypeParticle[q];
+          auto Rj = rad[q];
+          auto xc_ji = xc[q] - pi_xc;
+          auto dist_xcji = xc_ji.length();
+
+          const auto &contact = this->d_cDeck_p->getContact(pi->d_zoneId, pj->d_zoneId);
+
+          if (util::isLess(dist_xcji, Rj + Ri + 1.01 * contact.d_contactR)) {
+
+            auto vol_pj = M_PI * Rj * Rj;
+            auto rhoj = pj->getDensity();
+            // equivalent mass
+            auto meq = util::equivalentMass(rhoi * vol_pi, rhoj * vol_pj);
+
+            // beta_n
+            auto beta_n = contact.d_betan *
+                          std::sqrt(contact.d_kappa * contact.d_contactR * meq);
+
+            // center-center vector
+            auto hat_xc_ji = util::Point();
+            if (util::isGreater(dist_xcji, 0.))
+              hat_xc_ji = xc_ji / dist_xcji;
+            else
+              hat_xc_ji = util::Point();
+
+            // center-center velocity
+            auto vc_ji = pj->getVCenter() - pi_vc;
+            auto vc_mag = vc_ji * hat_xc_ji;
+            if (vc_mag > 0.)
+              vc_mag = 0.;
+
+            // force at node of pi
+            force_i += beta_n * vc_mag * hat_xc_ji / vol_pi;
+          } // if within contact distance
+        }   // if not same particles
+      }     // other particles
+
+      // particle-wall
+      // Step 1: Create list of wall nodes that are within the Rc distance
+      // of at least one of the particle
+      // This is done already in updateContactNeighborList()
+
+      // step 2 - condensed wall nodes into one vector
+      this->d_neighWallNodesCondensed[pi_id].clear();
+      {
+        for (size_t j=0; j<d_neighWallNodes[pi_id].size(); j++) {
+
+          const auto &j_id = pi->getNodeId(j);
+          const auto yj = this->d_x.get(j_id);
+
+          for (size_t k=0; k<d_neighWallNodes[pi_id][j].size(); k++) {
+
+            const auto &k_id = d_neighWallNodes[pi_id][j][k];
+            const auto &pk = d_particlesListTypeAll[d_ptId[k_id]];
+
+            double Rjk = (this->d_x.get(k_id) - yj).length();
+
+            const auto &contact =
+                    d_cDeck_p->getContact(pi->d_zoneId, pk->d_zoneId);
+
+            if (util::isLess(Rjk, contact.d_contactR))
+              util::methods::addToList(k_id, d_neighWallNodesCondensed[pi_id]);
+
+          } // loop over k
+        } // loop over j
+      } // step 2
+
+      // now loop over wall nodes and add force to center of particle
+      for (auto &j : d_neighWallNodesCondensed[pi_id]) {
+
+        auto &ptIdj = this->d_ptId[j];
+        auto &pj = this->d_particlesListTypeAll[ptIdj];
+        auto meq = rhoi * vol_pi;
+
+        const auto &contact
+                = d_cDeck_p->getContact(pi->d_zoneId, pj->d_zoneId);
+
+        // beta_n
+        auto beta_n = contact.d_betan *
+                      std::sqrt(contact.d_kappa * contact.d_contactR * meq);
+
+        // center-node vector
+        auto xc_ji = this->d_x.get(j) - pi_xc;
+        auto hat_xc_ji = util::Point();
+        if (util::isGreater(xc_ji.length(), 0.))
+          hat_xc_ji = xc_ji / xc_ji.length();
+
+        // center-node velocity
+        auto vc_ji = this->d_v.get(j) - pi_vc;
+        auto vc_mag = vc_ji * hat_xc_ji;
+        if (vc_mag > 0.)
+          vc_mag = 0.;
+
+        // force at node of pi
+        force_i += beta_n * vc_mag * hat_xc_ji / vol_pi;
+      }
+
+      // particle-analytic wall (damping is applied at the point of wall
+      // closest to the particle)
+      for (auto &pw : d_particlesListTypeWall) {
+        if (!pw->d_analyticWall)
+          continue;
+
+        const auto &contact = d_cDeck_p->getContact(pi->d_zoneId, pw->d_zoneId);
+        const auto *geom = pw->d_geom_p.get();
+        const auto &pose = wall_pose[pw->d_typeId];
+
+        // skip if particle is far from wall
+        if (!util::isLess(geom->signedDistance(pose.toReference(pi_xc)),
+                          Ri + contact.d_contactR))
+          continue;
+
+        // node of particle closest to wall
+        double sd_min = contact.d_contactR;
+        size_t j_min = pi->d_globEnd;
+        for (size_t j = pi->d_globStart; j < pi->d_globEnd; j++) {
+          auto sd = geom->signedDistance(pose.toReference(d_x.get(j)));
+          if (sd < sd_min) {
+            sd_min = sd;
+            j_min = j;
+          }
+        }
 
-  executor.run(taskflow).get();
+        if (j_min == pi->d_globEnd)
+          continue;
+
+        auto yj = pose.toReference(d_x.get(j_min));
+        auto n = pose.rotate(signedDistanceNormal(
+                geom, yj, 1.0e-3 * contact.d_contactR, d_modelDeck_p->d_dim));
+
+        // equivalent mass and beta_n
+        auto meq = rhoi * vol_pi;
+        auto beta_n = contact.d_betan *
+                      std::sqrt(contact.d_kappa * contact.d_contactR * meq);
+
+        // center-wall vector
+        auto x_w = d_x.get(j_min) - sd_min * n;
+        auto xc_ji = x_w - pi_xc;
+        auto hat_xc_ji = util::Point();
+        if (util::isGreater(xc_ji.length(), 0.))
+          hat_xc_ji = xc_ji / xc_ji.length();
+
+        // center-wall velocity
+        auto vc_ji = pose.velocity(x_w) - pi_vc;
+        auto vc_mag = vc_ji * hat_xc_ji;
+        if (vc_mag > 0.)
+          vc_mag = 0.;
+
+        auto force_w = beta_n * vc_mag * hat_xc_ji / vol_pi;
+        force_i += force_w;
+
+        // reaction on wall (force_w is applied to all nodes of particle)
+        double vol_nodes = 0.;
+        for (size_t j = pi->d_globStart; j < pi->d_globEnd; j++)
+          vol_nodes += d_vol[j];
+        wall_reaction[p * nw + pw->d_typeId] = force_w * (-vol_nodes);
+      }
 
+      force[p] = force_i;
+    }
+  ); // for_each
 
-  // damping force
-  log("    Computing normal damping force \n", 3);
-  for (auto &pi : d_particlesListTypeParticle) {
+  // distribute damping force of particle to all its nodes
+  auto distribute = taskflow.for_each_index(
+    (std::size_t) 0, np, (std::size_t) 1,
+      [this, &force](std::size_t p) {
+        const auto &pi = this->d_particlesListTypeParticle[p];
+        for (size_t i = 0; i < pi->getNumNodes(); i++)
+          this->d_f.add(pi->getNodeId(i), force[p]);
+      }
+  ); // for_each
 
-    auto pi_id = pi->getId();
+  distribute.succeed(damping);
 
-    double Ri = pi->d_geom_p->boundingRadius();
-    double vol_pi = M_PI * Ri * Ri;
-    auto pi_xc = pi->getXCenter();
-    auto pi_vc = pi->getVCenter();
-    auto rhoi = pi->getDensity();
-    util::Point force_i = util::Point();
+  util::parallel::runTaskflow(taskflow);
 
-    // particle-particle
-    for (auto &pj : this->d_particlesListTypeParticle) {
-      if (pj->getId() != pi->getId()) {
-        auto Rj = pj->d_geom_p->boundingRadius();
-        auto xc_ji = pj->getXCenter() - pi_xc;
-        auto dist_xcji = xc_ji.length();
+  // reaction on analytic walls
+  for (size_t p = 0; p < np; p++)
+    for (size_t w = 0; w < nw; w++)
+      d_analyticWallReaction[w] += wall_reaction[p * nw + w];
+}
 
-        const auto &contact = d_cDeck_p->getContact(pi->d_zoneId, pj->d_zoneId);
+void model::DEMModel::computeAnalyticWallContactForces() {
 
-        if (util::isLess(dist_xcji, Rj + Ri + 1.01 * contact.d_contactR)) {
+  const auto dim = d_modelDeck_p->d_dim;
 
-          auto vol_pj = M_PI * Rj * Rj;
-          auto rhoj = pj->getDensity();
-          // equivalent mass
-          auto meq = util::equivalentMass(rhoi * vol_pi, rhoj * vol_pj);
+  for (auto &pw : d_particlesListTypeWall) {
+    if (!pw->d_analyticWall)
+      continue;
 
-          // beta_n
-          auto beta_n = contact.d_betan *
-                        std::sqrt(contact.d_kappa * contact.d_contactR * meq);
+    auto &reaction = d_analyticWallReaction[pw->d_typeId];
+    reaction = util::Point();
 
-          // center-center vector
-          auto hat_xc_ji = util::Point();
-          if (util::isGreater(dist_xcji, 0.))
-            hat_xc_ji = xc_ji / dist_xcji;
-          else
-            hat_xc_ji = util::Point();
-
-          // center-center velocity
-          auto vc_ji = pj->getVCenter() - pi_vc;
-          auto vc_mag = vc_ji * hat_xc_ji;
-          if (vc_mag > 0.)
-            vc_mag = 0.;
-
-          // force at node of pi
-          force_i += beta_n * vc_mag * hat_xc_ji / vol_pi;
-        } // if within contact distance
-      }   // if not same particles
-    }     // other particles
-
-    // particle-wall
-    // Step 1: Create list of wall nodes that are within the Rc distance
-    // of at least one of the particle
-    // This is done already in updateContactNeighborList()
-
-    // step 2 - condensed wall nodes into one vector (has to be done serially
-    d_neighWallNodesCondensed[pi->getId()].clear();
-    {
-      for (size_t j=0; j<d_neighWallNodes[pi_id].size(); j++) {
+    // wall is rigid, so its motion is translation and rotation found from
+    // its nodes
+    const auto *geom = pw->d_geom_p.get();
+    const auto pose = AnalyticWallPose(d_x, d_xRef, d_v, pw->d_globStart,
+                                       pw->d_globEnd);
 
-        const auto &j_id = pi->getNodeId(j);
-        const auto &yj = this->d_x[j_id];
+    std::vector<util::Point> force(d_fContCompNodes.size());
 
-        for (size_t k=0; k<d_neighWallNodes[pi_id][j].size(); k++) {
+    tf::Taskflow taskflow;
 
-          const auto &k_id = d_neighWallNodes[pi_id][j][k];
-          const auto &pk = d_particlesListTypeAll[d_ptId[k_id]];
+    taskflow.for_each_index(
+      (std::size_t) 0, d_fContCompNodes.size(), (std::size_t) 1,
+        [this, &pw, &force, geom, &pose, dim](std::size_t II) {
 
-          double Rjk = (this->d_x[k_id] - yj).length();
+          auto i = this->d_fContCompNodes[II];
+          const auto &pi = this->d_particlesListTypeAll[this->d_ptId[i]];
+          if (pi->getTypeIndex() == 1)
+            return;
 
           const auto &contact =
-                  d_cDeck_p->getContact(pi->d_zoneId, pk->d_zoneId);
-
-          if (util::isLess(Rjk, contact.d_contactR))
-            util::methods::addToList(k_id, d_neighWallNodesCondensed[pi_id]);
-
-        } // loop over k
-      } // loop over j
-    } // step 2
-
-    // now loop over wall nodes and add force to center of particle
-    for (auto &j : d_neighWallNodesCondensed[pi_id]) {
-
-      auto &ptIdj = this->d_ptId[j];
-      auto &pj = this->d_particlesListTypeAll[ptIdj];
-      auto rhoj = pj->getDensity();
-      auto volj = this->d_vol[j];
-      auto meq = rhoi * vol_pi;
-      //auto meq = util::equivalentMass(rhoi * vol_pi, rhoj * volj);
-
-      const auto &contact
-              = d_cDeck_p->getContact(pi->d_zoneId, pj->d_zoneId);
-
-      // beta_n
-      auto beta_n = contact.d_betan *
-                    std::sqrt(contact.d_kappa * contact.d_contactR * meq);
-
-      // center-node vector
-      auto xc_ji = this->d_x[j] - pi_xc;
-      auto hat_xc_ji = util::Point();
-      if (util::isGreater(xc_ji.length(), 0.))
-        hat_xc_ji = xc_ji / xc_ji.length();
-
-      // center-node velocity
-      auto vc_ji = this->d_v[j] - pi_vc;
-      auto vc_mag = vc_ji * hat_xc_ji;
-      if (vc_mag > 0.)
-        vc_mag = 0.;
-
-      // force at node of pi
-      force_i += beta_n * vc_mag * hat_xc_ji / vol_pi;
-    }
+                  this->d_cDeck_p->getContact(pi->d_zoneId, pw->d_zoneId);
+
+          // position of node relative to wall in reference configuration
+          auto yi = pose.toReference(this->d_x.get(i));
+          auto sd = geom->signedDistance(yi);
+          if (!util::isLess(sd, contact.d_contactR))
+            return;
+
+          auto n = pose.rotate(signedDistanceNormal(
+                  geom, yi, 1.0e-3 * contact.d_contactR, dim));
+
+          // sum of normal contact forces from nodes of wall (divided by
+          // volume of node i, see computeContactForces())
+          double scalar_f = -contact.d_Kn *
+                            wallContactIntegral(sd, contact.d_contactR, dim);
+          auto force_i = -scalar_f * n;
+
+          // friction force
+          auto vji = pose.velocity(this->d_x.get(i) - sd * n) - this->d_v.get(i);
+          auto et = vji - (vji * n) * n;
+          if (util::isGreater(et.length(), 0.))
+            et = et / et.length();
+          else
+            et = util::Point();
+          force_i += contact.d_mu * scalar_f * et;
 
-    // distribute force_i to all nodes of particle pi
-    {
-      tf::Executor executor(util::parallel::getNThreads());
-      tf::Taskflow taskflow;
+          force[II] = force_i;
+        } // loop over nodes
+    ); // for_each
 
-      taskflow.for_each_index((std::size_t) 0, pi->getNumNodes(), (std::size_t) 1,
-                              [this, pi, force_i](std::size_t i) {
-                                  this->d_f[pi->getNodeId(i)] += force_i;
-                              }
-      ); // for_each
+    util::parallel::runTaskflow(taskflow);
 
-      executor.run(taskflow).get();
+    // add force to nodes and sum the reaction on wall
+    for (size_t II = 0; II < d_fContCompNodes.size(); II++) {
+      auto i = d_fContCompNodes[II];
+      d_f.add(i, force[II]);
+      reaction -= force[II] * d_vol[i];
     }
-  } // loop over particle for damping
+  } // loop over walls
 }
 
 void model::DEMModel::applyInitialCondition() {
@@ -1076,7 +1694,6 @@ void model::DEMModel::applyInitialCondition() {
   const auto ic_p_list = d_pDeck_p->d_icDeck.d_pList;
 
   // add specified velocity to particle
-  tf::Executor executor(util::parallel::getNThreads());
   tf::Taskflow taskflow;
 
   taskflow.for_each_index((std::size_t) 0,
@@ -1091,7 +1708,7 @@ void model::DEMModel::applyInitialCondition() {
     } // loop over particles
   ); // for_each
 
-  executor.run(taskflow).get();
+  util::parallel::runTaskflow(taskflow);
 }
 
 void model::DEMModel::createParticles() {
@@ -1175,6 +1792,24 @@ void model::DEMModel::createParticles() {
       }
     }
 
+    // element data is needed to find nodes near boundary
+    if (d_pDeck_p->d_pNeighDeck.d_contBoundaryNodesOnly and
+        mesh->getElementConnectivities().empty() and
+        !mesh->d_filename.empty() and
+        util::io::getExtensionFromFile(mesh->d_filename) != "csv")
+      mesh->readElementData(mesh->d_filename);
+
+    // renumber nodes so that nodes close in space are close in memory (all
+    // particles created from this mesh inherit the order)
+    if (!pz.d_meshDeck.d_nodeOrdering.empty()) {
+      log(d_name + ": Renumbering nodes of mesh in zone = " +
+          std::to_string(z_id) + " using " + pz.d_meshDeck.d_nodeOrdering +
+          " curve\n");
+      auto order = fe::getSpaceFillingCurveOrder(
+          mesh->getNodes(), mesh->getDimension(), pz.d_meshDeck.d_nodeOrdering);
+      fe::renumberNodes(mesh.get(), order);
+    }
+
     // create the reference particle
     log(d_name + ": Creating reference particle in zone = " +
         std::to_string(z_id) + "\n");
@@ -1191,6 +1826,9 @@ void model::DEMModel::createParticles() {
 
     d_referenceParticles.emplace_back(ref_p);
 
+    if (d_pDeck_p->d_pNeighDeck.d_contBoundaryNodesOnly)
+      ref_p->setupBoundaryNodes();
+
     // check the particle generation method
     log(d_name + ": Creating particles in zone = " +
                   std::to_string(z_id) + "\n");
@@ -1253,6 +1891,8 @@ void model::DEMModel::createParticleUsingParticleZoneGeomObject(
           pz.d_matDeck,
           true);
 
+  p->d_analyticWall = pz.d_analyticWall;
+
   // push p to list
   if (pz.d_isWall)
     d_particlesListTypeWall.push_back(p);
@@ -1363,6 +2003,8 @@ void model::DEMModel::createParticlesFromFile(
             pz.d_matDeck,
             true);
 
+    p->d_analyticWall = pz.d_analyticWall;
+
     // push p to list
     if (pz.d_isWall)
       d_particlesListTypeWall.push_back(p);
@@ -1567,6 +2209,7 @@ void model::DEMModel::setupContact() {
     bulk_modulus.push_back(kappa_i);
   }
 
+  d_zoneMaxContactR.assign(d_cDeck_p->d_data.size(), 0.);
   for (size_t i = 0; i < d_cDeck_p->d_data.size(); i++) {
     for (size_t j = 0; j < d_cDeck_p->d_data.size(); j++) {
 
@@ -1578,6 +2221,9 @@ void model::DEMModel::setupContact() {
       if (d_maxContactR < deck->d_contactR)
         d_maxContactR = deck->d_contactR;
 
+      if (d_zoneMaxContactR[i] < deck->d_contactR)
+        d_zoneMaxContactR[i] = deck->d_contactR;
+
       // get effective bulk modulus for pair of zones and store it
       deck->d_kappa = util::equivalentMass(bulk_modulus[i], bulk_modulus[j]);
 
@@ -1658,39 +2304,463 @@ void model::DEMModel::setupQuadratureData() {
 
 void model::DEMModel::updatePeridynamicNeighborlist() {
 
-  d_neighPd.resize(d_x.size());
-  // d_neighPdSqdDist.resize(d_x.size());
+  // collect neighbors per node and then compress them into d_bondsPd
+  std::vector<std::vector<size_t>> neigh_pd(d_x.size());
+  auto t1 = steady_clock::now();
+
+  // contact search tree leaves out some nodes if it is built on subset of
+  // nodes, so we use tree over all nodes
+  std::unique_ptr<nsearch::BaseNSearch> all_nsearch;
+  auto *nsearch = d_nsearch_p.get();
+  if (d_nsearchCloud_p) {
+    all_nsearch = std::make_unique<NSearch>(d_x, d_outputDeck_p->d_debug,
+                                            10, util::parallel::getNThreads());
+    all_nsearch->setInputCloud();
+    nsearch = all_nsearch.get();
+  }
+
+  // in half-bond mode, bond is stored only in list of node with smaller id
+  const bool half_bonds = d_modelDeck_p->d_pdHalfBonds;
+
+  // particles with same reference particle, zone, scale, and horizon have
+  // same neighborhoods up to shift of node ids, so only first of them is
+  // searched and the result is copied to others
+  d_pdRefParticle.clear();
+  if (d_modelDeck_p->d_pdShareRefNeighbors) {
+    std::map<std::tuple<const particle::RefParticle *, size_t, double, double>,
+             size_t> ref_ids;
+    d_pdRefParticle.resize(d_particlesListTypeAll.size());
+    for (size_t p = 0; p < d_particlesListTypeAll.size(); p++) {
+      const auto &pi = d_particlesListTypeAll[p];
+      auto key = std::make_tuple(pi->d_rp_p.get(), pi->d_zoneId,
+                                 pi->d_tform.d_scale, pi->getHorizon());
+      d_pdRefParticle[p] = ref_ids.emplace(key, p).first->second;
+    }
+
+    log(fmt::format("{}: Particles copying peridynamic neighborhoods = {}, "
+                    "distinct neighborhoods = {}\n",
+                    d_name, d_particlesListTypeAll.size() - ref_ids.size(),
+                    ref_ids.size()), 2);
+  }
+
+  // queries are all nodes except nodes of analytic walls and nodes whose
+  // neighborhood is copied (queries are batched and processed in spatial
+  // order)
+  std::vector<size_t> query_nodes, query_tags;
+  std::vector<util::Point> query_x;
+  std::vector<double> query_r;
+  for (size_t i = 0; i < d_x.size(); i++) {
+    const auto &pi = d_particlesListTypeAll[d_ptId[i]];
+    if (pi->d_analyticWall or getPdRefNode(i) != i)
+      continue;
+
+    query_nodes.push_back(i);
+    query_tags.push_back(d_ptId[i]);
+    query_x.push_back(d_x.get(i));
+    query_r.push_back(pi->d_material_p->getHorizon());
+  }
+
+  nsearch->radiusSearchBatch(
+          query_x, query_r,
+          [this, &neigh_pd, &query_nodes, half_bonds](
+                  size_t q, const nsearch::SearchBuffer &buffer) {
+            const auto i = query_nodes[q];
+            const auto &pi = this->d_ptId[i];
+            const auto &neighs = buffer.d_neighs;
+            neigh_pd[i].reserve(neighs.size());
+            for (std::size_t j = 0; j < neighs.size(); ++j)
+              if (neighs[j] != i && this->d_ptId[neighs[j]] == pi &&
+                  (!half_bonds || neighs[j] > i))
+                neigh_pd[i].push_back(size_t(neighs[j]));
+          },
+          nsearch::SearchTagFilter::include, query_tags, d_ptId);
+
+  // copy shifted neighborhoods to nodes whose search was skipped
+  if (!d_pdRefParticle.empty()) {
+    tf::Taskflow taskflow;
+
+    taskflow.for_each_index((std::size_t) 0, d_x.size(), (std::size_t) 1,
+                            [this, &neigh_pd](std::size_t i) {
+      const auto r = this->getPdRefNode(i);
+      if (r == i)
+        return;
+
+      const auto &neighs = neigh_pd[r];
+      neigh_pd[i].resize(neighs.size());
+      for (size_t k = 0; k < neighs.size(); k++)
+        neigh_pd[i][k] = neighs[k] - r + i;
+    }
+    ); // for_each
+
+    util::parallel::runTaskflow(taskflow);
+  }
+
+  // create peridynamic bonds (all bonds are unbroken)
+  d_bondsPd.build(neigh_pd);
+  d_bondsPdBroken.clear();
+
+  auto t2 = steady_clock::now();
+  log(fmt::format("{}: Peridynamics neighbor update time = {}\n",
+                  d_name, util::methods::timeDiff(t1, t2)), 2);
+  log(fmt::format("{}: Peridynamics bonds = {}, memory = {} bytes\n",
+                  d_name, d_bondsPd.numBonds(), d_bondsPd.memorySize()), 2);
+}
+
+void model::DEMModel::setupPdKernels() {
+
+  // kernels are selected once per zone and shared by particles in the zone
+  std::map<size_t, material::PdKernels> zone_kernels;
+
+  bool use_simd = d_modelDeck_p->d_pdSimdKernel;
+  if (use_simd and !material::isSimdBondKernelSupported()) {
+    log(d_name + ": SIMD bond kernel is not supported on this CPU. Using "
+                 "scalar kernel.\n");
+    use_simd = false;
+  }
+
+  d_pdKernels.resize(d_particlesListTypeAll.size());
+  for (size_t p = 0; p < d_particlesListTypeAll.size(); p++) {
+    const auto &pi = d_particlesListTypeAll[p];
+    if (d_modelDeck_p->d_pdHalfBonds and pi->getMaterial()->isStateActive()) {
+      std::cerr << "Error: PD_Half_Bonds is only supported for bond-based "
+                   "materials. Zone " << pi->d_zoneId
+                << " uses state-based material.\n";
+      exit(1);
+    }
+
+    auto it = zone_kernels.find(pi->d_zoneId);
+    if (it == zone_kernels.end()) {
+      it = zone_kernels.emplace(pi->d_zoneId,
+                                material::getPdKernels(pi->getMaterial(), use_simd,
+                                                       d_modelDeck_p->d_mixedPrecision)).first;
+      log(fmt::format("{}: Peridynamics force kernel for zone {} = {}\n",
+                      d_name, pi->d_zoneId, it->second.d_name), 2);
+    }
+
+    d_pdKernels[p] = it->second;
+  }
+}
+
+void model::DEMModel::logMemoryReport() {
+
+  auto bytes = [](const auto &v) {
+    return v.capacity() * sizeof(typename std::decay_t<decltype(v)>::value_type);
+  };
+
+  // immutable nodal data (reference configuration and particle data)
+  const size_t nodal_ref = d_xRef.memorySize() + bytes(d_vol) + bytes(d_ptId)
+                           + bytes(d_fix) + bytes(d_mX);
+
+  // evolving nodal data
+  const size_t nodal_state = d_x.memorySize() + d_u.memorySize()
+                             + d_v.memorySize() + d_f.memorySize()
+                             + bytes(d_vMag) + bytes(d_thetaX) + bytes(d_Z);
+
+  const size_t bonds = d_bondsPd.memorySize() + d_bondsPdBroken.memorySize()
+                       + bytes(d_bondsPdLength) + bytes(d_bondsPdVolume)
+                       + bytes(d_bondsPdInfFn) + bytes(d_bondsPdSc)
+                       + bytes(d_bondsPdLengthF) + bytes(d_bondsPdVolumeF)
+                       + bytes(d_bondsPdInfFnF) + bytes(d_bondsPdScF);
+
+  size_t contact = bytes(d_neighC) + bytes(d_neighCOffset)
+                   + bytes(d_neighCRevOffset) + bytes(d_neighCRev)
+                   + bytes(d_contPairForce);
+  for (const auto &neighs : d_neighC)
+    contact += bytes(neighs);
+
+  const size_t total = nodal_ref + nodal_state + bonds + contact;
+  setKeyData("memory_total", double(total));
+
+  log(fmt::format(
+          "{}: Memory information (bytes) \n"
+          "  {:32s} = {:12d} \n"
+          "  {:32s} = {:12d} \n"
+          "  {:32s} = {:12d} \n"
+          "  {:32s} = {:12d} \n"
+          "  {:32s} = {:12d} \n",
+          d_name,
+          "Nodal reference data", nodal_ref,
+          "Nodal state", nodal_state,
+          "Peridynamic bonds", bonds,
+          "Contact neighborlist", contact,
+          "Total", total));
+}
+
+void model::DEMModel::updatePeridynamicBondCache() {
+
+  d_bondsPdLength.clear();
+  d_bondsPdVolume.clear();
+  d_bondsPdInfFn.clear();
+  d_bondsPdSc.clear();
+  d_bondsPdLengthF.clear();
+  d_bondsPdVolumeF.clear();
+  d_bondsPdInfFnF.clear();
+  d_bondsPdScF.clear();
+
+  // mixed-precision mode stores bond cache in float
+  const bool use_float = d_modelDeck_p->d_mixedPrecision;
+  if (!d_modelDeck_p->d_pdBondCache and !use_float)
+    return;
+
   auto t1 = steady_clock::now();
 
-  tf::Executor executor(util::parallel::getNThreads());
+  const auto nb = d_bondsPd.numBonds();
+  if (use_float) {
+    d_bondsPdLengthF.resize(nb);
+    d_bondsPdVolumeF.resize(nb);
+    d_bondsPdInfFnF.resize(nb);
+    d_bondsPdScF.resize(nb);
+  } else {
+    d_bondsPdLength.resize(nb);
+    d_bondsPdVolume.resize(nb);
+    d_bondsPdInfFn.resize(nb);
+    d_bondsPdSc.resize(nb);
+  }
+
   tf::Taskflow taskflow;
 
-  taskflow.for_each_index((std::size_t) 0, d_x.size(), (std::size_t) 1, [this](std::size_t i) {
-      const auto &pi = this->d_ptId[i];
-      double search_r = this->d_particlesListTypeAll[pi]->d_material_p->getHorizon();
-
-      std::vector<size_t> neighs;
-      std::vector<double> sqr_dist;
-      if (this->d_nsearch_p->radiusSearchIncludeTag(this->d_x[i],
-                                                    search_r,
-                                                    neighs,
-                                                    sqr_dist,
-                                                    this->d_ptId[i],
-                                                    this->d_ptId) > 0) {
-        for (std::size_t j = 0; j < neighs.size(); ++j)
-          if (neighs[j] != i && this->d_ptId[neighs[j]] == pi) {
-            this->d_neighPd[i].push_back(size_t(neighs[j]));
-            // this->d_neighPdSqdDist[i].push_back(sqr_dist[j]);
-          }
+  taskflow.for_each_index((std::size_t) 0, d_bondsPd.numNodes(), (std::size_t) 1, [this, use_float](std::size_t i) {
+      // nodes whose neighborhood is copied from other node copy its bond
+      // data below
+      if (this->getPdRefNode(i) != i)
+        return;
+
+      const auto &pi = this->getParticleFromAllList(this->getPtId(i));
+      const auto *material = pi->getMaterial();
+      const double horizon = pi->getHorizon();
+      const double mesh_size = pi->getMeshSize();
+      const auto xi = this->d_xRef.get(i);
+
+      // upper and lower bound for volume correction
+      auto check_up = horizon + 0.5 * mesh_size;
+      auto check_low = horizon - 0.5 * mesh_size;
+
+      for (size_t b = this->d_bondsPd.begin(i); b < this->d_bondsPd.end(i); b++) {
+        const auto j = this->d_bondsPd.getNeighbor(b);
+        double rji = (this->d_xRef.get(j) - xi).length();
+
+        // get corrected volume of node j
+        auto volj = this->d_vol[j];
+        if (util::isGreater(rji, check_low))
+          volj *= (check_up - rji) / mesh_size;
+
+        if (use_float) {
+          this->d_bondsPdLengthF[b] = float(rji);
+          this->d_bondsPdVolumeF[b] = float(volj);
+          this->d_bondsPdInfFnF[b] = float(material->getInfFn(rji));
+          this->d_bondsPdScF[b] = float(material->getSc(rji));
+        } else {
+          this->d_bondsPdLength[b] = rji;
+          this->d_bondsPdVolume[b] = volj;
+          this->d_bondsPdInfFn[b] = material->getInfFn(rji);
+          this->d_bondsPdSc[b] = material->getSc(rji);
+        }
       }
     }
   ); // for_each
 
-  executor.run(taskflow).get();
+  util::parallel::runTaskflow(taskflow);
+
+  // bonds of node whose neighborhood is copied are in the same order as
+  // bonds of the node it is copied from (see updatePeridynamicNeighborlist())
+  if (!d_pdRefParticle.empty()) {
+    tf::Taskflow copy_taskflow;
+
+    copy_taskflow.for_each_index((std::size_t) 0, d_bondsPd.numNodes(), (std::size_t) 1, [this, use_float](std::size_t i) {
+        const auto r = this->getPdRefNode(i);
+        if (r == i)
+          return;
+
+        const auto br = this->d_bondsPd.begin(r);
+        for (size_t b = this->d_bondsPd.begin(i); b < this->d_bondsPd.end(i); b++) {
+          const auto b_r = br + b - this->d_bondsPd.begin(i);
+          if (use_float) {
+            this->d_bondsPdLengthF[b] = this->d_bondsPdLengthF[b_r];
+            this->d_bondsPdVolumeF[b] = this->d_bondsPdVolumeF[b_r];
+            this->d_bondsPdInfFnF[b] = this->d_bondsPdInfFnF[b_r];
+            this->d_bondsPdScF[b] = this->d_bondsPdScF[b_r];
+          } else {
+            this->d_bondsPdLength[b] = this->d_bondsPdLength[b_r];
+            this->d_bondsPdVolume[b] = this->d_bondsPdVolume[b_r];
+            this->d_bondsPdInfFn[b] = this->d_bondsPdInfFn[b_r];
+            this->d_bondsPdSc[b] = this->d_bondsPdSc[b_r];
+          }
+        }
+      }
+    ); // for_each
+
+    util::parallel::runTaskflow(copy_taskflow);
+  }
 
   auto t2 = steady_clock::now();
-  log(fmt::format("{}: Peridynamics neighbor update time = {}\n",
-                  d_name, util::methods::timeDiff(t1, t2)), 2);
+  log(fmt::format("{}: Peridynamics bond cache time = {}, memory = {} bytes\n",
+                  d_name, util::methods::timeDiff(t1, t2),
+                  4 * nb * (use_float ? sizeof(float) : sizeof(double))), 2);
+}
+
+void model::DEMModel::compactPeridynamicBonds() {
+
+  const auto nb = d_bondsPd.numBonds();
+  if (nb == 0)
+    return;
+
+  const auto nb_broken = d_bondsPd.numBrokenBonds();
+  if (util::isLess(double(nb_broken),
+                   d_modelDeck_p->d_pdBondCompactionThreshold * double(nb)))
+    return;
+
+  auto t1 = steady_clock::now();
+
+  auto map = d_bondsPd.compact(d_bondsPdBroken);
+
+  compactBondData(d_bondsPdLength, map);
+  compactBondData(d_bondsPdVolume, map);
+  compactBondData(d_bondsPdInfFn, map);
+  compactBondData(d_bondsPdSc, map);
+  compactBondData(d_bondsPdLengthF, map);
+  compactBondData(d_bondsPdVolumeF, map);
+  compactBondData(d_bondsPdInfFnF, map);
+  compactBondData(d_bondsPdScF, map);
+
+  auto t2 = steady_clock::now();
+  log(fmt::format("{}: Peridynamics bond compaction at step {} moved {} broken "
+                  "bonds, bonds = {}, broken bonds = {}, time = {}\n",
+                  d_name, d_n, nb_broken, d_bondsPd.numBonds(),
+                  d_bondsPdBroken.numBonds(), util::methods::timeDiff(t1, t2)),
+      2);
+}
+
+void model::DEMModel::updateForceComputeNodes() {
+
+  d_fPdCompNodes.clear();
+  d_fContCompNodes.clear();
+  for (size_t i = 0; i < d_x.size(); i++) {
+    const auto &ptId = d_ptId[i];
+    const auto &pi = getParticleFromAllList(ptId);
+    if (pi->d_computeForce and !pi->d_sleeping) {
+      d_fContCompNodes.push_back(i);
+      d_fPdCompNodes.push_back(i);
+    }
+  }
+
+  // step task graph captures the size of node lists, so rebuild it
+  d_stepTaskflow.clear();
+}
+
+void model::DEMModel::updateSleepingParticles() {
+
+  const auto v_tol = d_modelDeck_p->d_sleepVelocityThreshold;
+  const auto f_tol = d_modelDeck_p->d_sleepForceThreshold;
+  const auto check_interval = d_modelDeck_p->d_sleepCheckInterval;
+
+  // maximum nodal speed and force density in each particle (velocity of
+  // walls may be prescribed without time integration, so use d_v directly)
+  std::vector<double> max_f(d_particlesListTypeAll.size(), 0.);
+  for (auto &pi : d_particlesListTypeAll) {
+    double v_max = 0.;
+    double f_max = 0.;
+    for (size_t i = pi->d_globStart; i < pi->d_globEnd; i++) {
+      v_max = std::max(v_max, d_v.get(i).length());
+      f_max = std::max(f_max, d_f.get(i).length());
+    }
+    d_maxVelocityParticlesListTypeAll[pi->getId()] = v_max;
+    max_f[pi->getId()] = f_max;
+  }
+
+  // wake up sleeping particles in contact with moving particles or walls
+  // (pair of nodes may be listed only by one of the nodes, see
+  // updateContactHalfPairs(), so both nodes of pair are checked)
+  std::vector<uint8_t> moving(d_particlesListTypeAll.size(), 0);
+  for (const auto &pi : d_particlesListTypeAll)
+    moving[pi->getId()] =
+            !pi->d_sleeping and
+            util::isGreater(d_maxVelocityParticlesListTypeAll[pi->getId()],
+                            v_tol);
+
+  std::vector<uint8_t> wake(d_particlesListTypeAll.size(), 0);
+  for (size_t i = 0; i < d_neighC.size(); i++) {
+    const auto &pi = d_particlesListTypeAll[d_ptId[i]];
+    for (const auto &j : d_neighC[i]) {
+      const auto &pj = d_particlesListTypeAll[d_ptId[j]];
+      if (pi->d_sleeping and moving[pj->getId()])
+        wake[pi->getId()] = 1;
+      if (pj->d_sleeping and moving[pi->getId()])
+        wake[pj->getId()] = 1;
+    }
+  }
+
+  // nodes of analytic walls are not in contact neighborlist, so check
+  // signed distance of nodes of sleeping particles to moving analytic walls
+  const auto wall_pose = getAnalyticWallPoses(this);
+  for (const auto &pw : d_particlesListTypeWall) {
+    if (!pw->d_analyticWall or !moving[pw->getId()])
+      continue;
+
+    const auto *geom = pw->d_geom_p.get();
+    const auto &pose = wall_pose[pw->d_typeId];
+    for (const auto &pi : d_particlesListTypeParticle) {
+      if (!pi->d_sleeping or wake[pi->getId()])
+        continue;
+
+      const auto rc = d_cDeck_p->getContact(pi->d_zoneId, pw->d_zoneId).d_contactR;
+      if (!util::isLess(geom->signedDistance(pose.toReference(pi->getXCenter())),
+                        pi->d_geom_p->boundingRadius() + rc))
+        continue;
+
+      for (size_t i = pi->d_globStart; i < pi->d_globEnd; i++)
+        if (util::isLess(geom->signedDistance(pose.toReference(d_x.get(i))),
+                         rc)) {
+          wake[pi->getId()] = 1;
+          break;
+        }
+    }
+  }
+
+  size_t n_woken = 0;
+  for (auto &pi : d_particlesListTypeParticle) {
+    if (pi->d_sleeping and wake[pi->getId()]) {
+      pi->d_sleeping = false;
+      pi->d_restSteps = 0;
+      n_woken++;
+    }
+  }
+
+  // put particles at rest to sleep
+  size_t n_slept = 0;
+  for (auto &pi : d_particlesListTypeParticle) {
+    if (pi->d_sleeping or !pi->d_computeForce)
+      continue;
+
+    if (util::isLess(d_maxVelocityParticlesListTypeAll[pi->getId()], v_tol) and
+        util::isLess(max_f[pi->getId()], f_tol))
+      pi->d_restSteps += check_interval;
+    else
+      pi->d_restSteps = 0;
+
+    if (pi->d_restSteps >= d_modelDeck_p->d_sleepSteps) {
+      pi->d_sleeping = true;
+      for (size_t i = pi->d_globStart; i < pi->d_globEnd; i++) {
+        d_v.set(i, util::Point());
+        d_vMag[i] = 0.;
+      }
+      d_maxVelocityParticlesListTypeAll[pi->getId()] = 0.;
+      n_slept++;
+    }
+  }
+
+  size_t n_sleeping = 0;
+  for (const auto &pi : d_particlesListTypeParticle)
+    n_sleeping += pi->d_sleeping;
+  setKeyData("sleeping_particles", n_sleeping);
+
+  if (n_slept > 0 or n_woken > 0) {
+    updateForceComputeNodes();
+    log(fmt::format("{}: Sleeping particles at step {}: slept = {}, woken = {}, "
+                    "sleeping = {}, total = {}\n",
+                    d_name, d_n, n_slept, n_woken, n_sleeping,
+                    d_particlesListTypeParticle.size()),
+        2);
+  }
 }
 
 void model::DEMModel::updateContactNeighborlist() {
@@ -1701,9 +2771,20 @@ void model::DEMModel::updateContactNeighborlist() {
     return;
 
   // update contact neighborlist
+  appendKeyData("contact_neigh_rebuild_count", 1);
+  if (d_pDeck_p->d_pNeighDeck.d_skinFactor > 0.)
+    d_xContBuild = d_x;
 
   // update the point cloud (make sure that d_x is updated along with displacement)
-  auto pt_cloud_update_time = d_nsearch_p->setInputCloud();
+  d_nsearch_p->setSearchRadius(d_contNeighSearchRadius);
+  double pt_cloud_update_time = 0.;
+  if (d_pDeck_p->d_pNeighDeck.d_treeRefit) {
+    bool rebuilt = true;
+    pt_cloud_update_time = d_nsearch_p->refitInputCloud(rebuilt);
+    appendKeyData(rebuilt ? "contact_tree_rebuild_count"
+                          : "contact_tree_refit_count", 1);
+  } else
+    pt_cloud_update_time = d_nsearch_p->setInputCloud();
   setKeyData("pt_cloud_update_time", pt_cloud_update_time);
   appendKeyData("tree_compute_time", pt_cloud_update_time);
   appendKeyData("avg_tree_update_time", pt_cloud_update_time/d_infoN);
@@ -1711,50 +2792,84 @@ void model::DEMModel::updateContactNeighborlist() {
   if (d_neighC.size() != d_x.size())
     d_neighC.resize(d_x.size());
 
-  tf::Executor executor(util::parallel::getNThreads());
-  tf::Taskflow taskflow;
-
-  taskflow.for_each_index((std::size_t) 0, d_x.size(), (std::size_t) 1,
-                          [this](std::size_t i) {
+  // broad phase over bounding spheres of particles
+  updateContactBroadPhase(d_contNeighSearchRadius);
 
-    const auto &pi = this->d_ptId[i];
-    const auto &pi_particle = this->d_particlesListTypeAll[pi];
-
-    // search?
-    bool perform_search_based_on_particle = true;
-    if (pi_particle->d_typeIndex == 1) // wall
-      perform_search_based_on_particle = false;
-
-    if (pi_particle->d_allDofsConstrained or !pi_particle->d_computeForce)
-      perform_search_based_on_particle = false;
+  // narrow phase: node needs search only if it is within search radius of
+  // bounding sphere of one of the candidates (small tolerance is added so
+  // that the test never drops a node that search would find)
+  std::vector<uint8_t> search_flag(d_x.size(), 0);
+  {
+    tf::Taskflow taskflow;
 
-    if (perform_search_based_on_particle) {
+    taskflow.for_each_index((std::size_t) 0, d_x.size(), (std::size_t) 1,
+                            [this, &search_flag](std::size_t i) {
 
-      std::vector<size_t> neighs;
-      std::vector<double> sqr_dist;
+      const auto &pi = this->d_ptId[i];
+      const auto &pi_particle = this->d_particlesListTypeAll[pi];
 
       this->d_neighC[i].clear();
 
-      auto n = this->d_nsearch_p->radiusSearchExcludeTag(
-              this->d_x[i],
-              this->d_contNeighSearchRadius,
-              neighs,
-              sqr_dist,
-              this->d_ptId[i],
-              this->d_ptId);
-
-      if (n > 0) {
-        for (auto neigh: neighs) {
-          if (neigh != i)
-            this->d_neighC[i].push_back(neigh);
+      // search?
+      if (!this->isContactSearchNode(i))
+        return;
+
+      const auto yi = this->d_x.get(i);
+      const auto zi = pi_particle->d_zoneId;
+      for (auto q : this->d_contCandidates[pi]) {
+        const auto zq = this->d_particlesListTypeAll[q]->d_zoneId;
+        if ((yi - this->d_contBoundCenter[q]).length()
+            < (1. + 1.0e-8) * (this->d_contBoundRadius[q]
+                               + this->getContactSearchRadius(zi, zq))) {
+          search_flag[i] = 1;
+          break;
         }
       }
     }
-}
-  ); // for_each
+    ); // for_each
 
-  executor.run(taskflow).get();
+    util::parallel::runTaskflow(taskflow);
+  }
+
+  // search with the largest radius of zone of node (queries are batched and
+  // processed in spatial order)
+  std::vector<size_t> query_nodes, query_tags;
+  std::vector<util::Point> query_x;
+  std::vector<double> query_r;
+  for (size_t i = 0; i < d_x.size(); i++) {
+    if (!search_flag[i])
+      continue;
+
+    const auto zi = d_particlesListTypeAll[d_ptId[i]]->d_zoneId;
+    query_nodes.push_back(i);
+    query_tags.push_back(d_ptId[i]);
+    query_x.push_back(d_x.get(i));
+    query_r.push_back(d_zoneMaxContactR[zi] + d_contNeighSearchRadius
+                      - d_maxContactR);
+  }
 
+  // keep nodes within search radius of pair of zones (d_neighC[i] keeps its
+  // memory, so no allocation is needed once buffers have grown)
+  d_nsearch_p->radiusSearchBatch(
+          query_x, query_r,
+          [this, &query_nodes](size_t q, const nsearch::SearchBuffer &buffer) {
+            const auto i = query_nodes[q];
+            const auto zi =
+                    this->d_particlesListTypeAll[this->d_ptId[i]]->d_zoneId;
+            const auto &neighs = buffer.d_neighs;
+            const auto &sqr_dist = buffer.d_sqrDist;
+            for (size_t k = 0; k < neighs.size(); k++) {
+              const auto neigh = neighs[k];
+              const auto zj = this->d_particlesListTypeAll[this->d_ptId[neigh]]->d_zoneId;
+              const auto r = this->getContactSearchRadius(zi, zj);
+              if (neigh != i and sqr_dist[k] < r * r)
+                this->d_neighC[i].push_back(neigh);
+            }
+          },
+          nsearch::SearchTagFilter::exclude, query_tags, d_ptId);
+
+  if (d_modelDeck_p->d_contactHalfPairs)
+    updateContactHalfPairs();
 
   // handle particle-wall neighborlist (based on the d_neighC that we already computed)
   d_neighWallNodes.resize(d_particlesListTypeAll.size());
@@ -1768,7 +2883,6 @@ void model::DEMModel::updateContactNeighborlist() {
 
     // get all wall nodes that are within contact distance to the nodes of this particle
     {
-      tf::Executor executor(util::parallel::getNThreads());
       tf::Taskflow taskflow;
 
       taskflow.for_each_index((std::size_t) 0,
@@ -1777,7 +2891,7 @@ void model::DEMModel::updateContactNeighborlist() {
                               [this, &pi](std::size_t i) {
 
             auto i_glob = pi->getNodeId(i);
-            auto yi = this->d_x[i_glob];
+            auto yi = this->d_x.get(i_glob);
 
             const std::vector<size_t> &neighs = this->d_neighC[i_glob];
 
@@ -1799,14 +2913,238 @@ void model::DEMModel::updateContactNeighborlist() {
         }
       ); // for_each
 
-      executor.run(taskflow).get();
+      util::parallel::runTaskflow(taskflow);
     }
   } // loop over particles
 
 }
 
+bool model::DEMModel::isContactSearchNode(size_t i) const {
+
+  const auto &pi = d_particlesListTypeAll[d_ptId[i]];
+  if (pi->d_typeIndex == 1) // wall
+    return false;
+
+  if (pi->d_allDofsConstrained or !pi->d_computeForce)
+    return false;
+
+  return d_contNodeFlag[i];
+}
+
+void model::DEMModel::updateContactHalfPairs() {
+
+  const auto n = d_x.size();
+
+  std::vector<uint8_t> search_node(n);
+  for (size_t i = 0; i < n; i++)
+    search_node[i] = isContactSearchNode(i);
+
+  // pair (i, j) of nodes that both search is found from both nodes (search
+  // radius of pair of zones is symmetric), so drop it from list of larger id
+  tf::Taskflow taskflow;
+
+  taskflow.for_each_index((std::size_t) 0, n, (std::size_t) 1,
+                          [this, &search_node](std::size_t i) {
+    auto &neighs = this->d_neighC[i];
+    neighs.erase(std::remove_if(neighs.begin(), neighs.end(),
+                                [i, &search_node](size_t j) {
+                                  return j < i and search_node[j];
+                                }),
+                 neighs.end());
+  }
+  ); // for_each
+
+  util::parallel::runTaskflow(taskflow);
+
+  // offset of pairs of each node and pairs grouped by second node; second
+  // node receives force only if it searches, as in full neighborlist
+  d_neighCOffset.assign(n + 1, 0);
+  d_neighCRevOffset.assign(n + 1, 0);
+  for (size_t i = 0; i < n; i++) {
+    d_neighCOffset[i + 1] = d_neighCOffset[i] + d_neighC[i].size();
+    for (const auto &j : d_neighC[i])
+      if (search_node[j])
+        d_neighCRevOffset[j + 1]++;
+  }
+
+  for (size_t i = 0; i < n; i++)
+    d_neighCRevOffset[i + 1] += d_neighCRevOffset[i];
+
+  d_neighCRev.resize(d_neighCRevOffset[n]);
+  std::vector<size_t> count(d_neighCRevOffset.begin(),
+                            d_neighCRevOffset.end() - 1);
+  for (size_t i = 0; i < n; i++) {
+    for (size_t k = 0; k < d_neighC[i].size(); k++) {
+      const auto j = d_neighC[i][k];
+      if (search_node[j])
+        d_neighCRev[count[j]++] = d_neighCOffset[i] + k;
+    }
+  }
+
+  setKeyData("contact_pairs", d_neighCOffset[n]);
+}
+
+void model::DEMModel::setupContactNodes() {
+
+  d_contNodeFlag.assign(d_x.size(), 1);
+
+  for (const auto &pi : d_particlesListTypeAll) {
+
+    // nodes of analytic walls are not in contact search
+    if (pi->d_analyticWall) {
+      for (size_t i = pi->d_globStart; i < pi->d_globEnd; i++)
+        d_contNodeFlag[i] = 0;
+      continue;
+    }
+
+    if (!d_pDeck_p->d_pNeighDeck.d_contBoundaryNodesOnly)
+      continue;
+
+    // boundary nodes are vertices of mesh and distance from boundary node
+    // may exceed distance from boundary by mesh size
+    double dist = d_zoneMaxContactR[pi->d_zoneId] + pi->getMeshSize();
+    for (size_t i = 0; i < pi->getNumNodes(); i++)
+      if (pi->d_rp_p->getBoundaryDistance(i) * pi->d_tform.d_scale >= dist)
+        d_contNodeFlag[pi->getNodeId(i)] = 0;
+  }
+
+  if (d_pDeck_p->d_pNeighDeck.d_contBoundaryNodesOnly) {
+    size_t n = 0;
+    for (auto f : d_contNodeFlag)
+      n += f;
+    log(fmt::format("{}: Number of nodes in contact search = {} out of {}.\n",
+                    d_name, n, d_x.size()));
+  }
+}
+
+void model::DEMModel::updateContactBroadPhase(double search_r) {
+
+  const auto n_all = d_particlesListTypeAll.size();
+  d_contBoundCenter.resize(n_all);
+  d_contBoundRadius.resize(n_all);
+  d_contCandidates.resize(n_all);
+
+  // bounding spheres in current configuration
+  {
+    tf::Taskflow taskflow;
+
+    taskflow.for_each_index((std::size_t) 0, n_all, (std::size_t) 1,
+                            [this](std::size_t p) {
+        const auto &pi = this->d_particlesListTypeAll[p];
+
+        // center of particle (walls do not have a center node so we use the
+        // center of box enclosing nodes)
+        auto xc = util::Point();
+        if (pi->d_typeIndex == 0)
+          xc = pi->getXCenter();
+        else {
+          auto x_min = this->d_x.get(pi->d_globStart);
+          auto x_max = x_min;
+          for (size_t j = pi->d_globStart; j < pi->d_globEnd; j++) {
+            auto xj = this->d_x.get(j);
+            for (size_t d = 0; d < 3; d++) {
+              x_min[d] = std::min(x_min[d], xj[d]);
+              x_max[d] = std::max(x_max[d], xj[d]);
+            }
+          }
+          xc = 0.5 * (x_min + x_max);
+        }
+
+        double r = 0.;
+        for (size_t j = pi->d_globStart; j < pi->d_globEnd; j++)
+          r = std::max(r, (this->d_x.get(j) - xc).length());
+
+        this->d_contBoundCenter[p] = xc;
+        this->d_contBoundRadius[p] = r;
+      }
+    ); // for_each
+
+    util::parallel::runTaskflow(taskflow);
+  }
+
+  // tree over centers of particles (walls are few and are checked directly)
+  const auto np = d_particlesListTypeParticle.size();
+  std::vector<util::Point> xc(np);
+  double r_max = 0.;
+  for (size_t p = 0; p < np; p++) {
+    const auto pi_id = d_particlesListTypeParticle[p]->getId();
+    xc[p] = d_contBoundCenter[pi_id];
+    r_max = std::max(r_max, d_contBoundRadius[pi_id]);
+  }
+
+  nsearch::NFlannSearchKd<3> center_tree(xc);
+  center_tree.setInputCloud();
+
+  // search radius of pair of zones is contact radius of pair plus margin
+  // (search_r is search radius for largest contact radius); spheres are
+  // enlarged by small tolerance so that no pair is missed due to round-off
+  const double margin = search_r - d_maxContactR;
+  const double tol = 1. + 1.0e-8;
+
+  tf::Taskflow taskflow;
+
+  taskflow.for_each_index((std::size_t) 0, np, (std::size_t) 1,
+                          [this, &xc, &center_tree, r_max, margin, tol](std::size_t p) {
+      const auto &pi = this->d_particlesListTypeParticle[p];
+      const auto pi_id = pi->getId();
+      auto &candidates = this->d_contCandidates[pi_id];
+      candidates.clear();
+
+      if (pi->d_allDofsConstrained or !pi->d_computeForce)
+        return;
+
+      const auto &xi = this->d_contBoundCenter[pi_id];
+      const auto ri = this->d_contBoundRadius[pi_id];
+      const auto zi = pi->d_zoneId;
+
+      // particles
+      auto &buffer = nsearch::getThreadSearchBuffer();
+      center_tree.radiusSearch(xi,
+                               tol * (ri + r_max + this->d_zoneMaxContactR[zi]
+                                      + margin),
+                               buffer.d_neighs, buffer.d_sqrDist);
+      for (auto q : buffer.d_neighs) {
+        const auto &pq = this->d_particlesListTypeParticle[q];
+        const auto q_id = pq->getId();
+        const auto r = this->d_cDeck_p->getContact(zi, pq->d_zoneId).d_contactR
+                       + margin;
+        if (q_id != pi_id
+            and (this->d_contBoundCenter[q_id] - xi).length()
+                < tol * (ri + this->d_contBoundRadius[q_id] + r))
+          candidates.push_back(q_id);
+      }
+
+      // walls (nodes of analytic walls are not in contact search)
+      for (const auto &pw : this->d_particlesListTypeWall) {
+        const auto w_id = pw->getId();
+        const auto r = this->d_cDeck_p->getContact(zi, pw->d_zoneId).d_contactR
+                       + margin;
+        if (!pw->d_analyticWall
+            and (this->d_contBoundCenter[w_id] - xi).length()
+                < tol * (ri + this->d_contBoundRadius[w_id] + r))
+          candidates.push_back(w_id);
+      }
+
+      std::sort(candidates.begin(), candidates.end());
+    }
+  ); // for_each
+
+  util::parallel::runTaskflow(taskflow);
+
+  if (d_n % d_infoN == 0) {
+    size_t num_pairs = 0;
+    for (const auto &c : d_contCandidates)
+      num_pairs += c.size();
+    setKeyData("contact_broad_phase_pairs", num_pairs);
+  }
+}
+
 bool model::DEMModel::updateContactNeighborSearchParameters() {
 
+  // skin-based neighborlist
+  if (d_pDeck_p->d_pNeighDeck.d_skinFactor > 0.)
+    return checkContactNeighborSkin();
+
   // initialize parameters
   if (d_contNeighUpdateInterval == 0 and
       util::isLess(d_contNeighSearchRadius, 1.e-16)) {
@@ -1954,6 +3292,48 @@ bool model::DEMModel::updateContactNeighborSearchParameters() {
   return (d_contNeighTimestepCounter - 1) % d_contNeighUpdateInterval == 0;
 }
 
+double model::DEMModel::getContactSearchRadius(size_t zone_i,
+                                               size_t zone_j) const {
+  return d_cDeck_p->getContact(zone_i, zone_j).d_contactR
+         + d_contNeighSearchRadius - d_maxContactR;
+}
+
+bool model::DEMModel::checkContactNeighborSkin() {
+
+  const double skin = d_pDeck_p->d_pNeighDeck.d_skinFactor * d_maxContactR;
+  d_contNeighSearchRadius = d_maxContactR + skin;
+
+  // first build (or restart)
+  if (d_xContBuild.size() != d_x.size())
+    return true;
+
+  // maximum displacement of nodes since last build; nodes of analytic walls
+  // are not in contact search and are skipped
+  std::vector<double> max_disp(d_particlesListTypeAll.size(), 0.);
+
+  tf::Taskflow taskflow;
+
+  taskflow.for_each_index((std::size_t) 0, d_particlesListTypeAll.size(),
+                          (std::size_t) 1,
+                          [this, &max_disp](std::size_t p) {
+      const auto &pi = this->d_particlesListTypeAll[p];
+      if (pi->d_analyticWall)
+        return;
+
+      double d = 0.;
+      for (size_t i = pi->d_globStart; i < pi->d_globEnd; i++)
+        d = std::max(d, (this->d_x.get(i) - this->d_xContBuild.get(i)).lengthSq());
+      max_disp[p] = std::sqrt(d);
+    }
+  ); // for_each
+
+  util::parallel::runTaskflow(taskflow);
+
+  // two nodes can approach each other by at most twice the maximum
+  // displacement, so the list is valid as long as it is below half of skin
+  return util::methods::max(max_disp) > 0.5 * skin;
+}
+
 void model::DEMModel::updateNeighborlistCombine() {
   // Not used
   return;
@@ -2035,18 +3415,22 @@ void model::DEMModel::output() {
         }
       }
 
+      // fe utilities work with list of points
+      const auto xRef = d_xRef.toVector();
+      const auto u = d_u.toVector();
+
       for (auto &p: d_particlesListTypeAll) {
 
         const auto particle_mesh_p = p->getMeshP();
 
-        fe::getCurrentQuadPoints(particle_mesh_p.get(), d_xRef, d_u, d_xQuadCur,
+        fe::getCurrentQuadPoints(particle_mesh_p.get(), xRef, u, d_xQuadCur,
                                  p->d_globStart,
                                  p->d_globQuadStart,
                                  d_modelDeck_p->d_quadOrder);
 
         auto p_z_id = p->d_zoneId;
         auto isPlaneStrain = d_pDeck_p->d_particleZones[p_z_id].d_matDeck.d_isPlaneStrain;
-        fe::getStrainStress(particle_mesh_p.get(), d_xRef, d_u,
+        fe::getStrainStress(particle_mesh_p.get(), xRef, u,
                             isPlaneStrain,
                             d_strain, d_stress,
                             p->d_globStart,
@@ -2177,7 +3561,7 @@ void model::DEMModel::checkStop() {
     //    }
     //exit(EXIT_FAILURE);
     auto max_pt_and_index = util::methods::maxLengthAndMaxLengthIndex(d_x);
-    auto max_x = d_x[max_pt_and_index.second];
+    auto max_x = d_x.get(max_pt_and_index.second);
 
     // check
     if (util::isGreater(max_pt_and_index.first,
@@ -2219,8 +3603,12 @@ std::string model::DEMModel::ppCompressiveTest() {
 
   // get the total reaction force on wall along the direction of loading
   double tot_reaction_force = 0.;
-  for (size_t i = 0; i < wall->getNumNodes(); i++) {
-    tot_reaction_force += wall->getFLocal(i)[f_dir] * wall->getVolLocal(i);
+  if (wall->d_analyticWall)
+    tot_reaction_force = d_analyticWallReaction[wall->d_typeId][f_dir];
+  else {
+    for (size_t i = 0; i < wall->getNumNodes(); i++) {
+      tot_reaction_force += wall->getFLocal(i)[f_dir] * wall->getVolLocal(i);
+    }
   }
 
   // open file and write
@@ -12,6 +12,9 @@
 #define MODEL_FASTDEMMODEL_H
 
 #include "../modelData.h"
+#include "material/pdForceKernel.h"
+
+#include <taskflow/taskflow/taskflow.hpp>
 
 namespace model {
 
@@ -41,6 +44,28 @@ public:
   /*! @brief Name of the model for logging purposes (useful if other classes are built on top of this class) */
   std::string d_name;
 
+  /*! @brief Task graph of one central-difference time step (built once in setupStepTaskGraph() and reused) */
+  tf::Taskflow d_stepTaskflow;
+
+  /*! @brief Time (ms) spent in peridynamic force task in the last step of task graph */
+  double d_stepPdTime;
+
+  /*! @brief Time (ms) spent in contact neighborlist update task in the last step of task graph */
+  double d_stepContactNeighTime;
+
+  /*! @brief Time (ms) spent in contact force task in the last step of task graph */
+  double d_stepContactTime;
+
+  /*! @brief Time (ms) spent in external force task in the last step of task graph */
+  double d_stepExtfTime;
+
+  /*! @brief Peridynamic force kernels of each particle (selected once per zone in setupPdKernels()) */
+  std::vector<material::PdKernels> d_pdKernels;
+
+  /*! @brief Accumulation buffers of half-bond peridynamic kernel, one for
+   * each chunk of nodes (see inp::ModelDeck::d_pdHalfBonds) */
+  std::vector<material::PdHalfBondBuffer> d_pdHalfBondBuffers;
+
   /*! @brief Prints message if any of these two conditions are true
    * 1. if check_condition == true and dbg_lvl > priority
    * OR
@@ -121,6 +146,34 @@ public:
   /*! @brief Perform time integration using velocity verlet scheme */
   virtual void integrateVerlet();
 
+  /*!
+   * @brief Perform time integration using central-difference scheme where
+   * the full time step is executed as a single task graph
+   *
+   * Produces the same update as integrateCD() but without barriers between
+   * the phases; see setupStepTaskGraph() for the dependencies. Used when
+   * Model->Step_Task_Graph is true in the input deck.
+   *
+   * Note: computeForces() and computeExternalForces() are not called in this
+   * scheme, so models that override them should use integrateCD().
+   */
+  virtual void integrateCDTaskGraph();
+
+  /*!
+   * @brief Builds the task graph of one central-difference time step
+   *
+   * Tasks and their dependencies are:
+   * - integrate: update velocity, displacement, and position of nodes
+   * - advance time and apply displacement bc (after integrate)
+   * - force reset and gravity force (after integrate)
+   * - peridynamic force (after displacement bc and force reset)
+   * - contact neighborlist update (after displacement bc; runs concurrently
+   * with peridynamic force)
+   * - contact force (after peridynamic force and contact neighborlist update)
+   * - external force from loading (after contact force)
+   */
+  virtual void setupStepTaskGraph();
+
   /** @}*/
 
   /**
@@ -131,9 +184,33 @@ public:
   /*! @brief Computes peridynamic forces and contact forces */
   virtual void computeForces();
 
+  /*!
+   * @brief Records compute times of a time step in key data (total and
+   * average over output interval) and logs the averages at output steps.
+   * Used by both default and task graph time steps.
+   *
+   * @param pd_time Peridynamic force time
+   * @param contact_neigh_time Contact neighborlist update time
+   * @param contact_time Contact force time
+   * @param extf_time External force time
+   */
+  void recordComputeTimes(double pd_time, double contact_neigh_time,
+                          double contact_time, double extf_time);
+
   /*! @brief Computes peridynamic forces */
   virtual void computePeridynamicForces();
 
+  /*!
+   * @brief Computes peridynamic forces when each bond is stored once (see
+   * inp::ModelDeck::d_pdHalfBonds). Nodes are split into one chunk per
+   * thread, each chunk accumulates forces of its bonds in its own buffer, and
+   * buffers are summed in chunk order, so result is deterministic for fixed
+   * number of threads
+   *
+   * @param use_cache True if reference quantities of bonds are cached
+   */
+  virtual void computeHalfBondPeridynamicForces(bool use_cache);
+
   /*! @brief Computes external/boundary condition forces */
   virtual void computeExternalForces();
 
@@ -143,6 +220,21 @@ public:
   /*! @brief Computes contact forces */
   virtual void computeContactForces();
 
+  /*! @brief Computes contact forces using half-pair contact neighborlist
+   * (see inp::ModelDeck::d_contactHalfPairs). Force of each pair is computed
+   * once and stored, and forces are then gathered at nodes in fixed order, so
+   * result does not depend on number of threads */
+  virtual void computeHalfPairContactForces();
+
+  /*! @brief Computes contact force between particles and analytic walls
+   * (see inp::ParticleZone::d_analyticWall) */
+  virtual void computeAnalyticWallContactForces();
+
+  /*! @brief Computes normal damping force between particles and between
+   * particles and walls. Particle-particle candidates are found using a
+   * tree over particle centers and the loop over particles is in parallel */
+  virtual void computeDampingForces();
+
   /*! @brief Applies initial condition */
   virtual void applyInitialCondition();
 
@@ -190,9 +282,63 @@ public:
   /*! @brief Update neighborlist for contact */
   virtual void updateContactNeighborlist();
 
+  /*! @brief Sets flags of nodes that take part in contact search. All nodes
+   * take part unless only nodes near boundary are used for contact (see
+   * inp::PNeighborDeck::d_contBoundaryNodesOnly) */
+  virtual void setupContactNodes();
+
+  /*!
+   * @brief Returns true if node searches for its contact neighbors, i.e.,
+   * node belongs to particle (not wall) that is free and computes force and
+   * node takes part in contact search (see d_contNodeFlag)
+   *
+   * @param i Id of node
+   * @return bool True if node searches for contact neighbors
+   */
+  bool isContactSearchNode(size_t i) const;
+
+  /*! @brief Converts contact neighborlist into half-pair list. Pair of nodes
+   * that both search for contact neighbors is kept only in the list of node
+   * with smaller id, and for each node the pairs in which it is the second
+   * node are recorded (see inp::ModelDeck::d_contactHalfPairs) */
+  virtual void updateContactHalfPairs();
+
+  /*! @brief Broad phase of contact search. Computes bounding sphere of each
+   * particle and wall in current configuration and finds candidate pairs
+   * whose spheres are within search radius of each other
+   *
+   * @param search_r Contact search radius for the largest contact radius
+   * (see getContactSearchRadius() for radius of pair of zones)
+   */
+  virtual void updateContactBroadPhase(double search_r);
+
   /*! @brief Update neighborlist for peridynamics force */
   virtual void updatePeridynamicNeighborlist();
 
+  /*! @brief Select peridynamic force kernels for each particle based on
+   * material of its zone */
+  virtual void setupPdKernels();
+
+  /*! @brief Compute and cache reference quantities of peridynamic bonds
+   * (only if enabled in model deck) */
+  virtual void updatePeridynamicBondCache();
+
+  /*! @brief Move broken peridynamic bonds out of the list of bonds if their
+   * fraction exceeds the threshold in model deck */
+  virtual void compactPeridynamicBonds();
+
+  /*! @brief Log memory used by nodal data, peridynamic bonds, and contact
+   * neighborlist */
+  virtual void logMemoryReport();
+
+  /*! @brief Put particles at rest to sleep and wake up sleeping particles
+   * near moving particles (only if enabled in model deck) */
+  virtual void updateSleepingParticles();
+
+  /*! @brief Update list of nodes on which force is computed and which are
+   * integrated in time (nodes of sleeping particles are excluded) */
+  virtual void updateForceComputeNodes();
+
   /*! @brief Update neighborlist for contact and peridynamics force*/
   virtual void updateNeighborlistCombine();
 
@@ -205,6 +351,25 @@ public:
   /*! @brief Update contact neighbor search parameters */
   virtual bool updateContactNeighborSearchParameters();
 
+  /*!
+   * @brief Returns contact search radius for pair of zones. It is the contact
+   * radius of pair plus the margin d_contNeighSearchRadius - d_maxContactR
+   * that accounts for motion of nodes between updates of neighborlist
+   *
+   * @param zone_i Id of first zone
+   * @param zone_j Id of second zone
+   * @return Radius Search radius
+   */
+  double getContactSearchRadius(size_t zone_i, size_t zone_j) const;
+
+  /*! @brief Sets search radius to contact radius plus skin and checks if
+   * maximum displacement of nodes since last build of contact neighborlist
+   * exceeds half of skin
+   *
+   * @return bool True if contact neighborlist needs to be rebuilt
+   */
+  virtual bool checkContactNeighborSkin();
+
   /** @}*/
 
   /**
@@ -10,10 +10,47 @@
 
 #include "modelData.h"
 #include "particle/baseParticle.h"
+#include "inp/decks/modelDeck.h"
+
+model::ModelData::ModelData(inp::Input *deck)
+  : d_n(0),
+    d_time(0.),
+    d_currentDt(0.),
+    d_infoN(1),
+    d_input_p(deck),
+    d_modelDeck_p(deck->getModelDeck()),
+    d_restartDeck_p(deck->getRestartDeck()),
+    d_outputDeck_p(deck->getOutputDeck()),
+    d_pDeck_p(deck->getParticleDeck()), d_cDeck_p(deck->getContactDeck()),
+    d_stop(false), d_hMax(0.), d_hMin(0.), d_maxContactR(0.),
+    d_contNeighUpdateInterval(0),
+    d_contNeighTimestepCounter(0),
+    d_contNeighSearchRadius(0.),
+    d_xContBuild(deck->getModelDeck()->d_dim),
+    d_uLoading_p(nullptr), d_fLoading_p(nullptr),
+    d_nsearch_p(nullptr),
+    d_nsearchCloud_p(nullptr),
+    d_xRef(deck->getModelDeck()->d_dim),
+    d_x(deck->getModelDeck()->d_dim),
+    d_u(deck->getModelDeck()->d_dim),
+    d_v(deck->getModelDeck()->d_dim),
+    d_f(deck->getModelDeck()->d_dim) {}
 
 double model::ModelData::getDensity(size_t i) {
   return d_particlesListTypeAll[d_ptId[i]]->getDensity();
 };
 double model::ModelData::getHorizon(size_t i) {
   return d_particlesListTypeAll[d_ptId[i]]->getHorizon();
+};
+size_t model::ModelData::getPdRefNode(size_t i) const {
+  if (d_pdRefParticle.empty())
+    return i;
+
+  const auto &p = d_ptId[i];
+  const auto &r = d_pdRefParticle[p];
+  if (r == p)
+    return i;
+
+  return i - d_particlesListTypeAll[p]->getNodeId(0)
+         + d_particlesListTypeAll[r]->getNodeId(0);
 };
\ No newline at end of file
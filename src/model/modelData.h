@@ -12,6 +12,7 @@
 #define MODEL_MODELDATA_H
 
 #include "util/point.h"
+#include "util/pointSoA.h"
 #include "util/matrix.h"
 #include "util/methods.h"
 #include "material/mparticle/material.h"
@@ -19,6 +20,7 @@
 #include "loading/particleFLoading.h"
 #include "loading/particleULoading.h"
 #include "nsearch/nsearch.h"
+#include "geometry/bondList.h"
 #include "geometry/fracture.h"
 #include <cstdint> // uint8_t type
 #include <cstring> // string and size_t type
@@ -27,7 +29,7 @@
 #include <fstream>
 #include <iostream>
 
-typedef nsearch::NFlannSearchKd<3> NSearch;
+typedef nsearch::NFlannSearchKd<3, util::PointSoA> NSearch;
 
 // forward declare particle and wall
 namespace particle {
@@ -51,22 +53,7 @@ public:
    * @brief Constructor
    * @param deck Input deck
    */
-  ModelData(inp::Input *deck)
-      : d_n(0),
-        d_time(0.),
-        d_currentDt(0.),
-        d_infoN(1),
-        d_input_p(deck),
-        d_modelDeck_p(deck->getModelDeck()),
-        d_restartDeck_p(deck->getRestartDeck()),
-        d_outputDeck_p(deck->getOutputDeck()),
-        d_pDeck_p(deck->getParticleDeck()), d_cDeck_p(deck->getContactDeck()),
-        d_stop(false), d_hMax(0.), d_hMin(0.), d_maxContactR(0.),
-        d_contNeighUpdateInterval(0),
-        d_contNeighTimestepCounter(0),
-        d_contNeighSearchRadius(0.),
-        d_uLoading_p(nullptr), d_fLoading_p(nullptr),
-        d_fracture_p(nullptr), d_nsearch_p(nullptr)  {}
+  ModelData(inp::Input *deck);
 
   /*!
    * @brief Get pointer to base particle
@@ -118,6 +105,15 @@ public:
    */
   double getHorizon(size_t i);
 
+  /*!
+   * @brief Get node whose peridynamic neighborhood is shared by the node
+   * (see inp::ModelDeck::d_pdShareRefNeighbors)
+   * @param i Nodal id
+   * @return j Id of corresponding node in particle whose neighborhoods are
+   * shared (i if node does not share neighborhood)
+   */
+  size_t getPdRefNode(size_t i) const;
+
   /*!
    * @brief Get particle id given the location in particle list
    * @param i Location in the particle list
@@ -174,32 +170,36 @@ public:
    * @param i Global id of node
    * @return x Reference coordinate
    */
-  util::Point &getXRef(size_t i) { return d_xRef[i]; };
-
-  /*! @copydoc getXRef(size_t i) */
-  const util::Point &getXRef(size_t i) const { return d_xRef[i]; };
+  util::Point getXRef(size_t i) const { return d_xRef.get(i); };
 
   /*!
    * @brief Set reference coordinate of the node
    * @param i Global id of node
    * @param x Reference coordinate to set
    */
-  void setXRef(size_t i, const util::Point &x) { d_xRef[i] = x; };
+  void setXRef(size_t i, const util::Point &x) { d_xRef.set(i, x); };
 
   /*!
    * @brief Add reference coordinate of the node
    * @param i Global id of node
    * @param x Reference coordinate to add
    */
-  void addXRef(size_t i, const util::Point &x) { d_xRef[i] += x; };
+  void addXRef(size_t i, const util::Point &x) { d_xRef.add(i, x); };
 
   /*!
    * @brief Set specific reference coordinate of the node
+   *
+   * Components beyond the dimension of the model are not stored and
+   * therefore are ignored.
+   *
    * @param i Global id of node
    * @param dof Direction or degree of freedom to be modified
    * @param x Reference coordinate to set
    */
-  void setXRef(size_t i, int dof, double x) { d_xRef[i][dof] = x; };
+  void setXRef(size_t i, int dof, double x) {
+    if (size_t(dof) < d_xRef.dim())
+      d_xRef(i, dof) = x;
+  };
 
   /*!
    * @brief Add specific reference coordinate of the node
@@ -207,7 +207,10 @@ public:
    * @param dof Direction or degree of freedom to be modified
    * @param x Reference coordinate to add
    */
-  void addXRef(size_t i, int dof, double x) { d_xRef[i][dof] += x; };
+  void addXRef(size_t i, int dof, double x) {
+    if (size_t(dof) < d_xRef.dim())
+      d_xRef(i, dof) += x;
+  };
 
   /** @}*/
 
@@ -221,24 +224,21 @@ public:
    * @param i Global id of node
    * @return x Current coordinate
    */
-  util::Point &getX(size_t i) { return d_x[i]; };
-
-  /*! @copydoc getX(size_t i) */
-  const util::Point &getX(size_t i) const { return d_x[i]; };
+  util::Point getX(size_t i) const { return d_x.get(i); };
 
   /*!
    * @brief Set current coordinate of the node
    * @param i Global id of node
    * @param x Current coordinate to set
    */
-  void setX(size_t i, const util::Point &x) { d_x[i] = x; };
+  void setX(size_t i, const util::Point &x) { d_x.set(i, x); };
 
   /*!
    * @brief Add current coordinate of the node
    * @param i Global id of node
    * @param x Current coordinate to add
    */
-  void addX(size_t i, const util::Point &x) { d_x[i] += x; };
+  void addX(size_t i, const util::Point &x) { d_x.add(i, x); };
 
   /*!
    * @brief Set specific current coordinate of the node
@@ -246,7 +246,10 @@ public:
    * @param dof Direction or degree of freedom to be modified
    * @param x Current coordinate to set
    */
-  void setX(size_t i, int dof, double x) { d_x[i][dof] = x; };
+  void setX(size_t i, int dof, double x) {
+    if (size_t(dof) < d_x.dim())
+      d_x(i, dof) = x;
+  };
 
   /*!
    * @brief Add to specific current coordinate of the node
@@ -254,7 +257,10 @@ public:
    * @param dof Direction or degree of freedom to be modified
    * @param x Current coordinate to add
    */
-  void addX(size_t i, int dof, double x) { d_x[i][dof] += x; };
+  void addX(size_t i, int dof, double x) {
+    if (size_t(dof) < d_x.dim())
+      d_x(i, dof) += x;
+  };
 
   /** @}*/
 
@@ -268,24 +274,21 @@ public:
    * @param i Global id of node
    * @return u Displacement
    */
-  util::Point &getU(size_t i) { return d_u[i]; };
-
-  /*! @copydoc getU(size_t i) */
-  const util::Point &getU(size_t i) const { return d_u[i]; };
+  util::Point getU(size_t i) const { return d_u.get(i); };
 
   /*!
    * @brief Set displacement of the node
    * @param i Global id of node
    * @param u Displacement to set
    */
-  void setU(size_t i, const util::Point &u) { d_u[i] = u; };
+  void setU(size_t i, const util::Point &u) { d_u.set(i, u); };
 
   /*!
    * @brief Add to displacement of the node
    * @param i Global id of node
    * @param u Displacement to add
    */
-  void addU(size_t i, const util::Point &u) { d_u[i] += u; };
+  void addU(size_t i, const util::Point &u) { d_u.add(i, u); };
 
   /*!
    * @brief Set displacement of the node
@@ -293,7 +296,10 @@ public:
    * @param dof Direction or degree of freedom to be modified
    * @param u Displacement to set
    */
-  void setU(size_t i, int dof, double u) { d_u[i][dof] = u; };
+  void setU(size_t i, int dof, double u) {
+    if (size_t(dof) < d_u.dim())
+      d_u(i, dof) = u;
+  };
 
   /*!
   * @brief Add to displacement of the node
@@ -301,7 +307,10 @@ public:
   * @param dof Direction or degree of freedom to be modified
   * @param u Displacement to add
   */
-  void addU(size_t i, int dof, double u) { d_u[i][dof] += u; };
+  void addU(size_t i, int dof, double u) {
+    if (size_t(dof) < d_u.dim())
+      d_u(i, dof) += u;
+  };
 
   /** @}*/
 
@@ -315,24 +324,21 @@ public:
    * @param i Global id of node
    * @return v Velocity
    */
-  util::Point &getV(size_t i) { return d_v[i]; };
-
-  /*! @copydoc getV(size_t i) */
-  const util::Point &getV(size_t i) const { return d_v[i]; };
+  util::Point getV(size_t i) const { return d_v.get(i); };
 
   /*!
    * @brief Set velocity of the node
    * @param i Global id of node
    * @param v Velocity to set
    */
-  void setV(size_t i, const util::Point &v) { d_v[i] = v; };
+  void setV(size_t i, const util::Point &v) { d_v.set(i, v); };
 
   /*!
    * @brief Add to velocity of the node
    * @param i Global id of node
    * @param v Velocity to add
    */
-  void addV(size_t i, const util::Point &v) { d_v[i] += v; };
+  void addV(size_t i, const util::Point &v) { d_v.add(i, v); };
 
   /*!
    * @brief Set velocity of the node
@@ -340,7 +346,10 @@ public:
    * @param dof Direction or degree of freedom to be modified
    * @param v Velocity to set
    */
-  void setV(size_t i, int dof, double v) { d_v[i][dof] = v; };
+  void setV(size_t i, int dof, double v) {
+    if (size_t(dof) < d_v.dim())
+      d_v(i, dof) = v;
+  };
 
   /*!
    * @brief Add to velocity of the node
@@ -348,7 +357,10 @@ public:
    * @param dof Direction or degree of freedom to be modified
    * @param v Velocity to add
    */
-  void addV(size_t i, int dof, double v) { d_v[i][dof] += v; };
+  void addV(size_t i, int dof, double v) {
+    if (size_t(dof) < d_v.dim())
+      d_v(i, dof) += v;
+  };
 
   /** @}*/
 
@@ -362,24 +374,21 @@ public:
    * @param i Global id of node
    * @return f Force
    */
-  util::Point &getF(size_t i) { return d_f[i]; };
-
-  /*! @copydoc getF(size_t i) */
-  const util::Point &getF(size_t i) const { return d_f[i]; };
+  util::Point getF(size_t i) const { return d_f.get(i); };
 
   /*!
    * @brief Set force of the node
    * @param i Global id of node
    * @param f Force to set
    */
-  void setF(size_t i, const util::Point &f) { d_f[i] = f; };
+  void setF(size_t i, const util::Point &f) { d_f.set(i, f); };
 
   /*!
    * @brief Add to force of the node
    * @param i Global id of node
    * @param f Force to add
    */
-  void addF(size_t i, const util::Point &f) { d_f[i] += f; };
+  void addF(size_t i, const util::Point &f) { d_f.add(i, f); };
 
   /*!
    * @brief Set force of the node
@@ -387,7 +396,10 @@ public:
    * @param dof Direction or degree of freedom to be modified
    * @param f Force to set
    */
-  void setF(size_t i, int dof, double f) { d_f[i][dof] = f; };
+  void setF(size_t i, int dof, double f) {
+    if (size_t(dof) < d_f.dim())
+      d_f(i, dof) = f;
+  };
 
   /*!
    * @brief Add to force of the node
@@ -395,7 +407,10 @@ public:
    * @param dof Direction or degree of freedom to be modified
    * @param f Force to add
    */
-  void addF(size_t i, int dof, double f) { d_f[i][dof] += f; };
+  void addF(size_t i, int dof, double f) {
+    if (size_t(dof) < d_f.dim())
+      d_f(i, dof) += f;
+  };
 
   /** @}*/
 
@@ -576,6 +591,9 @@ public:
   /*! @brief Maximum contact radius between over pairs of particles and walls */
   double d_maxContactR;
 
+  /*! @brief Maximum contact radius of each zone over pairs with all zones */
+  std::vector<double> d_zoneMaxContactR;
+
   /*! @brief Neighborlist update interval */
   size_t d_contNeighUpdateInterval;
 
@@ -585,6 +603,11 @@ public:
   /*! @brief Neighborlist contact search radius (multiple of d_maxContactR). This variable will be updated during simulation based on maximum velocity */
   double d_contNeighSearchRadius;
 
+  /*! @brief Current positions of the nodes when contact neighborlist was
+   * last built (only used if skin-based neighborlist is enabled, see
+   * inp::PNeighborDeck::d_skinFactor) */
+  util::PointSoA d_xContBuild;
+
   /*! @brief Pointer to reference particle */
   std::vector<std::shared_ptr<particle::RefParticle>> d_referenceParticles;
 
@@ -620,29 +643,41 @@ public:
   /*! @brief Pointer to force Loading object */
   std::unique_ptr<loading::ParticleFLoading> d_fLoading_p;
 
-  /*! @brief Fracture state of bonds */
-  std::unique_ptr<geometry::Fracture> d_fracture_p;
-
   /*! @brief Pointer to nsearch */
-  std::unique_ptr<NSearch> d_nsearch_p;
+  std::unique_ptr<nsearch::BaseNSearch> d_nsearch_p;
+
+  /*! @brief Nodes used in contact search if some walls are analytic (nodes
+   * of analytic walls are left out), otherwise null */
+  std::unique_ptr<nsearch::PointCloudSubset> d_nsearchCloud_p;
 
-  /*! @brief reference positions of the nodes */
-  std::vector<util::Point> d_xRef;
+  /*! @brief Total contact force of particles on each analytic wall (indexed
+   * by id of wall in d_particlesListTypeWall) */
+  std::vector<util::Point> d_analyticWallReaction;
+
+  /*!
+   * @brief reference positions of the nodes
+   *
+   * Nodal vectors (d_xRef, d_x, d_u, d_v, d_f) are stored as
+   * structure-of-arrays with only the components up to the dimension of
+   * the model, so that loops over nodes can stream them contiguously. Use
+   * getX(), setX(), etc. to access them as util::Point.
+   */
+  util::PointSoA d_xRef;
 
   /*! @brief Current positions of the nodes */
-  std::vector<util::Point> d_x;
+  util::PointSoA d_x;
 
   /*! @brief Displacement of the nodes */
-  std::vector<util::Point> d_u;
+  util::PointSoA d_u;
 
   /*! @brief Velocity of the nodes */
-  std::vector<util::Point> d_v;
+  util::PointSoA d_v;
 
   /*! @brief Magnitude of velocity of the nodes */
   std::vector<double> d_vMag;
 
   /*! @brief Total force on the nodes */
-  std::vector<util::Point> d_f;
+  util::PointSoA d_f;
 
   /*! @brief Nodal volumes */
   std::vector<double> d_vol;
@@ -654,11 +689,73 @@ public:
   /*! @brief Neighbor data for contact forces */
   std::vector<std::vector<size_t>> d_neighC;
 
-  /*! @brief Neighbor data for peridynamic forces */
-  std::vector<std::vector<size_t>> d_neighPd;
+  /*! @brief Index of first pair of each node in the flattened d_neighC
+   * (only used if half-pair contact is enabled, see
+   * inp::ModelDeck::d_contactHalfPairs) */
+  std::vector<size_t> d_neighCOffset;
+
+  /*! @brief Index of first entry of each node in d_neighCRev */
+  std::vector<size_t> d_neighCRevOffset;
+
+  /*! @brief Index of pairs in the flattened d_neighC grouped by the second
+   * node of pair */
+  std::vector<size_t> d_neighCRev;
+
+  /*! @brief Contact force density on first (even entries) and second (odd
+   * entries) node of each pair in the flattened d_neighC */
+  std::vector<util::Point> d_contPairForce;
+
+  /*! @brief Neighbor data and fracture state of bonds for peridynamic forces
+   * (stored in compressed-sparse-row format) */
+  geometry::BondList d_bondsPd;
+
+  /*! @brief Id of particle whose peridynamic neighborhoods are shared by
+   * each particle in d_particlesListTypeAll (empty unless sharing is enabled,
+   * see inp::ModelDeck::d_pdShareRefNeighbors); bonds are copied, not
+   * shared */
+  std::vector<size_t> d_pdRefParticle;
+
+  /*! @brief Broken bonds moved out of d_bondsPd by compaction (only used for
+   * contact between broken bonds and for damage; empty unless compaction is
+   * enabled, see inp::ModelDeck::d_pdBondCompactionThreshold) */
+  geometry::BondList d_bondsPdBroken;
+
+  /*!
+   * @name Reference quantities of peridynamic bonds
+   *
+   * Indexed by global bond id of d_bondsPd. These are empty unless bond
+   * cache is enabled (see inp::ModelDeck::d_pdBondCache). In mixed-precision
+   * mode (see inp::ModelDeck::d_mixedPrecision), quantities are stored in
+   * single precision arrays with suffix F and double precision arrays are
+   * empty. Positions, displacements, and forces are always double.
+   */
+  /**@{*/
+
+  /*! @brief Reference length of bonds */
+  std::vector<double> d_bondsPdLength;
 
-  /*! @brief Square distance neighbor data for peridynamic forces */
-  std::vector<std::vector<float>> d_neighPdSqdDist;
+  /*! @brief Volume of neighbor node corrected for partial overlap with horizon */
+  std::vector<double> d_bondsPdVolume;
+
+  /*! @brief Influence function evaluated at reference length of bonds */
+  std::vector<double> d_bondsPdInfFn;
+
+  /*! @brief Critical strain of bonds */
+  std::vector<double> d_bondsPdSc;
+
+  /*! @brief Reference length of bonds (mixed-precision mode) */
+  std::vector<float> d_bondsPdLengthF;
+
+  /*! @brief Corrected volume of neighbor node (mixed-precision mode) */
+  std::vector<float> d_bondsPdVolumeF;
+
+  /*! @brief Influence function of bonds (mixed-precision mode) */
+  std::vector<float> d_bondsPdInfFnF;
+
+  /*! @brief Critical strain of bonds (mixed-precision mode) */
+  std::vector<float> d_bondsPdScF;
+
+  /** @}*/
 
   /*! @brief Neighbor data for contact between particle and walls */
   std::vector<std::vector<std::vector<size_t>>> d_neighWallNodes;
@@ -669,6 +766,22 @@ public:
   /*! @brief Neighbor data for contact between particle and walls condensed into single vector for each particle */
   std::vector<std::vector<size_t>> d_neighWallNodesCondensed;
 
+  /*! @brief Center of sphere bounding the nodes of particle in current
+   * configuration (indexed by id of particle in d_particlesListTypeAll) */
+  std::vector<util::Point> d_contBoundCenter;
+
+  /*! @brief Radius of sphere bounding the nodes of particle in current
+   * configuration */
+  std::vector<double> d_contBoundRadius;
+
+  /*! @brief Candidate particles and walls for contact of each particle
+   * found in the broad phase of contact search */
+  std::vector<std::vector<size_t>> d_contCandidates;
+
+  /*! @brief Flag for each node: 1 if node takes part in contact search and 0
+   * otherwise (see inp::PNeighborDeck::d_contBoundaryNodesOnly) */
+  std::vector<uint8_t> d_contNodeFlag;
+
   /*! @brief Vector of fixity mask of each node
    *
    * First bit represents x-dof, second represents y-dof, and third
@@ -679,19 +792,17 @@ public:
    */
   std::vector<uint8_t> d_fix;
 
-  /*! @brief Vector of fixity mask of each node for force */
-  std::vector<uint8_t> d_forceFixity;
-
   /*! @brief Dilation
    *
    * In case of nonlinear peridynamic state based model, this will be the
-   * spherical (hydrostatic) strain
+   * spherical (hydrostatic) strain. Empty if no material is state-based.
    */
   std::vector<double> d_thetaX;
 
   /*! @brief Weighted volume
    *
-   * In case of nonlinear peridynamic state based model, this data is not required
+   * In case of nonlinear peridynamic state based model, this data is not
+   * required. Empty if no material is state-based.
    */
   std::vector<double> d_mX;
 
@@ -0,0 +1,474 @@
+/*
+ * -------------------------------------------
+ * Copyright (c) 2021 - 2024 Prashant K. Jha
+ * -------------------------------------------
+ * PeriDEM https://github.com/prashjha/PeriDEM
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE)
+ */
+
+#ifndef NSEARCH_CELLLISTSEARCH_H
+#define NSEARCH_CELLLISTSEARCH_H
+
+#include "nsearch.h"
+#include "util/parallelUtil.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include <taskflow/taskflow/taskflow.hpp>
+#include <taskflow/taskflow/algorithm/for_each.hpp>
+
+namespace nsearch {
+
+/*!
+ * @brief A class for nearest neighbor search using uniform grid of cells
+ *
+ * Points are sorted by the cell they belong to (counting sort), so that
+ * setInputCloud() is O(N) and the coordinates of points in a cell are
+ * contiguous in memory. Radius search loops over the cells overlapping the
+ * box around the search point. This is efficient when search radius is
+ * close to the cell size, e.g., contact search, and when the point cloud
+ * changes every few steps.
+ *
+ * PointCloudType is the type of list of points, either PointCloud (vector of
+ * points), util::PointSoA, or PointCloudSubset.
+ */
+template <int dim = 3, class PointCloudType = PointCloud>
+class CellListSearch : public BaseNSearch {
+
+public:
+  /*!
+   * @brief Constructor
+   *
+   * @param x Point cloud
+   * @param debug Debug level to print information
+   * @param cell_size Size of cell (if zero, it is computed from the bounding
+   * box and the number of points)
+   */
+  explicit CellListSearch(const PointCloudType &x, size_t debug = 0,
+                          double cell_size = 0.)
+      : BaseNSearch("cell_list", debug), d_cloud(x), d_cellSize(cell_size),
+        d_h(0.), d_xMin(), d_nCells({1, 1, 1}) {};
+
+  /*!
+   * @brief Sets size of cell (used in the next call to setInputCloud())
+   * @param search_r Search radius
+   */
+  void setSearchRadius(double search_r) override { d_cellSize = search_r; };
+
+  /*!
+   * @brief Set input cloud (bins the points in cells)
+   * @return double Time taken to update the point cloud
+   */
+  double setInputCloud() override {
+    auto t1 = steady_clock::now();
+
+    const size_t N = d_cloud.size();
+    d_cellStart.clear();
+    d_cellPoints.resize(N);
+    d_sortedX.resize(N * dim);
+    if (N == 0) {
+      d_cellStart.resize(2, 0);
+      return util::methods::timeDiff(t1, steady_clock::now());
+    }
+
+    // bounding box (each thread computes the box of a chunk of points)
+    const size_t num_chunks = std::min<size_t>(util::parallel::getNThreads(), N);
+    std::vector<std::array<double, 3>> chunk_min(num_chunks), chunk_max(num_chunks);
+    {
+      tf::Taskflow taskflow;
+      taskflow.for_each_index((std::size_t) 0, num_chunks, (std::size_t) 1,
+                              [this, N, num_chunks, &chunk_min,
+                               &chunk_max](std::size_t k) {
+        const size_t i0 = k * N / num_chunks, i1 = (k + 1) * N / num_chunks;
+        auto &c_min = chunk_min[k];
+        auto &c_max = chunk_max[k];
+        for (size_t d = 0; d < dim; d++) {
+          c_min[d] = getCoord(this->d_cloud, i0, d);
+          c_max[d] = c_min[d];
+        }
+        for (size_t i = i0; i < i1; i++)
+          for (size_t d = 0; d < dim; d++) {
+            auto xd = getCoord(this->d_cloud, i, d);
+            c_min[d] = std::min(c_min[d], xd);
+            c_max[d] = std::max(c_max[d], xd);
+          }
+      }); // for_each
+
+      util::parallel::runTaskflow(taskflow);
+    }
+
+    std::array<double, 3> x_max = {0., 0., 0.};
+    for (size_t d = 0; d < dim; d++) {
+      d_xMin[d] = chunk_min[0][d];
+      x_max[d] = chunk_max[0][d];
+      for (size_t k = 1; k < num_chunks; k++) {
+        d_xMin[d] = std::min(d_xMin[d], chunk_min[k][d]);
+        x_max[d] = std::max(x_max[d], chunk_max[k][d]);
+      }
+    }
+
+    // cell size
+    double vol = 1., ext_max = 0.;
+    for (size_t d = 0; d < dim; d++) {
+      ext_max = std::max(ext_max, x_max[d] - d_xMin[d]);
+      vol *= x_max[d] - d_xMin[d];
+    }
+
+    d_h = d_cellSize;
+    if (d_h <= 0.)
+      d_h = vol > 0. ? 2. * std::pow(vol / double(N), 1. / dim) : ext_max;
+    if (d_h <= 0.)
+      d_h = 1.;
+
+    // limit number of cells to few times number of points (e.g., when a
+    // large wall is in the point cloud)
+    const double max_cells = 8. * double(N) + 1.;
+    for (size_t iter = 0; iter < 4; iter++) {
+      double num_cells = 1.;
+      for (size_t d = 0; d < dim; d++) {
+        d_nCells[d] = size_t((x_max[d] - d_xMin[d]) / d_h) + 1;
+        num_cells *= double(d_nCells[d]);
+      }
+
+      if (num_cells <= max_cells)
+        break;
+
+      d_h *= std::pow(num_cells / max_cells, 1. / dim) * 1.01;
+    }
+
+    // counting sort of points by cell id; cell of each point and sorted
+    // coordinates are computed in parallel, while counting and placing ids
+    // of points is serial so that points in a cell are in increasing order
+    // (this keeps the order of search results independent of number of
+    // threads) and because per-thread counts would need memory of size
+    // number of cells for each thread
+    size_t num_cells = 1;
+    for (size_t d = 0; d < dim; d++)
+      num_cells *= d_nCells[d];
+
+    std::vector<size_t> cell_of_point(N);
+    d_cellStart.resize(num_cells + 1, 0);
+    {
+      tf::Taskflow taskflow;
+      taskflow.for_each_index((std::size_t) 0, N, (std::size_t) 1,
+                              [this, &cell_of_point](std::size_t i) {
+        std::array<size_t, 3> c = {0, 0, 0};
+        for (size_t d = 0; d < dim; d++)
+          c[d] = std::min(size_t((getCoord(this->d_cloud, i, d) - this->d_xMin[d])
+                                 / this->d_h),
+                          this->d_nCells[d] - 1);
+        cell_of_point[i] = this->cellId(c);
+      }); // for_each
+
+      util::parallel::runTaskflow(taskflow);
+    }
+
+    for (size_t i = 0; i < N; i++)
+      d_cellStart[cell_of_point[i] + 1]++;
+
+    for (size_t c = 0; c < num_cells; c++)
+      d_cellStart[c + 1] += d_cellStart[c];
+
+    std::vector<size_t> fill(d_cellStart.begin(), d_cellStart.end() - 1);
+    for (size_t i = 0; i < N; i++)
+      d_cellPoints[fill[cell_of_point[i]]++] = i;
+
+    {
+      tf::Taskflow taskflow;
+      taskflow.for_each_index((std::size_t) 0, N, (std::size_t) 1,
+                              [this](std::size_t s) {
+        for (size_t d = 0; d < dim; d++)
+          this->d_sortedX[s * dim + d] =
+                  getCoord(this->d_cloud, this->d_cellPoints[s], d);
+      }); // for_each
+
+      util::parallel::runTaskflow(taskflow);
+    }
+
+    auto t2 = steady_clock::now();
+    return util::methods::timeDiff(t1, t2);
+  };
+
+  /*!
+   * @brief Rebuilds the cell list after points have moved
+   *
+   * Cell list keeps a reference to the point cloud given in the constructor
+   * and reads positions from it, so x should be the updated positions of
+   * the same points. The cell list is rebuilt (see setInputCloud()).
+   *
+   * @param x Vector of positions of points
+   * @param parallel Specify if this is done in parallel (not used, binning
+   * is always done in parallel)
+   * @return double Time taken to update the point cloud
+   */
+  double updatePointCloud(const std::vector<util::Point> &x,
+                          bool parallel = true) override {
+    if (x.size() != d_cloud.size()) {
+      std::cerr << "Error: Number of points = " << x.size()
+                << " in updatePointCloud() does not match the number of "
+                   "points = " << d_cloud.size()
+                << " in point cloud of CellListSearch.\n";
+      exit(1);
+    }
+
+    return setInputCloud();
+  };
+
+  /*!
+   * @copydoc BaseNSearch::radiusSearch(
+      const util::Point &searchPoint, const double &search_r,
+      std::vector<size_t> &neighs,
+      std::vector<double> &sqr_dist) = 0
+   */
+  size_t radiusSearch(
+      const util::Point &searchPoint, const double &search_r,
+      std::vector<size_t> &neighs,
+      std::vector<double> &sqr_dist) override {
+
+    TreeSearchRes resultSet(search_r * search_r, neighs, sqr_dist);
+    return cellSearch(searchPoint, search_r, resultSet);
+  };
+
+  /*!
+   * @copydoc BaseNSearch::radiusSearch(
+      const util::Point &searchPoint, const double &search_r,
+      std::vector<int> &neighs,
+      std::vector<float> &sqr_dist) = 0
+   */
+  size_t radiusSearch(
+      const util::Point &searchPoint, const double &search_r,
+      std::vector<int> &neighs,
+      std::vector<float> &sqr_dist) override {
+
+    auto &buffer = getThreadInternalSearchBuffer();
+    auto N = this->radiusSearch(searchPoint, search_r, buffer.d_neighs,
+                                buffer.d_sqrDist);
+
+    copySearchResults(buffer, neighs, sqr_dist);
+    return N;
+  };
+
+  /*!
+   * @copydoc BaseNSearch::radiusSearchExcludeTag(
+          const util::Point &searchPoint,
+          const double &search_r,
+          std::vector<size_t> &neighs,
+          std::vector<double> &sqr_dist,
+          const size_t &searchPointTag,
+          std::vector<size_t> &dataTags) = 0
+   */
+  size_t radiusSearchExcludeTag(
+          const util::Point &searchPoint,
+          const double &search_r,
+          std::vector<size_t> &neighs,
+          std::vector<double> &sqr_dist,
+          const size_t &searchPointTag,
+          const std::vector<size_t> &dataTags) override {
+
+    TreeSearchCheckIDExcludeRes resultSet(search_r * search_r,
+                                          neighs, sqr_dist, searchPointTag,
+                                          dataTags);
+    return cellSearch(searchPoint, search_r, resultSet);
+  };
+
+  /*!
+   * @copydoc BaseNSearch::radiusSearchExcludeTag(
+          const util::Point &searchPoint,
+          const double &search_r,
+          std::vector<size_t> &neighs,
+          std::vector<double> &sqr_dist,
+          const size_t &searchPointTag,
+          std::vector<size_t> &dataTags) = 0
+   */
+  size_t radiusSearchExcludeTag(
+          const util::Point &searchPoint,
+          const double &search_r,
+          std::vector<int> &neighs,
+          std::vector<float> &sqr_dist,
+          const size_t &searchPointTag,
+          const std::vector<size_t> &dataTags) override {
+
+    auto &buffer = getThreadInternalSearchBuffer();
+    auto N = this->radiusSearchExcludeTag(searchPoint, search_r, buffer.d_neighs,
+                                          buffer.d_sqrDist, searchPointTag,
+                                          dataTags);
+
+    copySearchResults(buffer, neighs, sqr_dist);
+    return N;
+  };
+
+  /*!
+   * @copydoc BaseNSearch::radiusSearchIncludeTag(
+          const util::Point &searchPoint,
+          const double &search_r,
+          std::vector<size_t> &neighs,
+          std::vector<double> &sqr_dist,
+          const size_t &searchPointTag,
+          std::vector<size_t> &dataTags) = 0
+   */
+  size_t radiusSearchIncludeTag(
+          const util::Point &searchPoint,
+          const double &search_r,
+          std::vector<size_t> &neighs,
+          std::vector<double> &sqr_dist,
+          const size_t &searchPointTag,
+          const std::vector<size_t> &dataTags) override {
+
+    TreeSearchCheckIDIncludeRes resultSet(search_r * search_r,
+                                          neighs, sqr_dist, searchPointTag,
+                                          dataTags);
+    return cellSearch(searchPoint, search_r, resultSet);
+  };
+
+  /*!
+   * @copydoc BaseNSearch::radiusSearchIncludeTag(
+          const util::Point &searchPoint,
+          const double &search_r,
+          std::vector<size_t> &neighs,
+          std::vector<double> &sqr_dist,
+          const size_t &searchPointTag,
+          std::vector<size_t> &dataTags) = 0
+   */
+  size_t radiusSearchIncludeTag(
+          const util::Point &searchPoint,
+          const double &search_r,
+          std::vector<int> &neighs,
+          std::vector<float> &sqr_dist,
+          const size_t &searchPointTag,
+          const std::vector<size_t> &dataTags) override {
+
+    auto &buffer = getThreadInternalSearchBuffer();
+    auto N = this->radiusSearchIncludeTag(searchPoint, search_r, buffer.d_neighs,
+                                          buffer.d_sqrDist, searchPointTag,
+                                          dataTags);
+
+    copySearchResults(buffer, neighs, sqr_dist);
+    return N;
+  };
+
+  /*!
+   * @copydoc BaseNSearch::closestPoint(
+          const util::point &searchPoint,
+          int &neigh,
+          float &sqrDistNeigh) = 0
+   */
+  void closestPoint(
+          const util::Point &searchPoint,
+          size_t &neigh,
+          double &sqrDistNeigh) override {
+
+    neigh = 0;
+    sqrDistNeigh = std::numeric_limits<double>::max();
+    if (d_cellPoints.empty())
+      return;
+
+    // search in balls of increasing radius until a point is found; the
+    // closest point in the ball is the closest point in the cloud
+    auto &buffer = getThreadInternalSearchBuffer();
+    auto &neighs = buffer.d_neighs;
+    auto &sqr_dist = buffer.d_sqrDist;
+    double r = d_h;
+    while (true) {
+      TreeSearchRes resultSet(r * r, neighs, sqr_dist);
+      if (cellSearch(searchPoint, r, resultSet) > 0) {
+        for (size_t i = 0; i < neighs.size(); i++)
+          if (sqr_dist[i] < sqrDistNeigh) {
+            sqrDistNeigh = sqr_dist[i];
+            neigh = neighs[i];
+          }
+        return;
+      }
+      r *= 2.;
+    }
+  };
+
+private:
+  /*!
+   * @brief Returns id of cell
+   * @param c Index of cell along each direction
+   * @return id Id of cell
+   */
+  size_t cellId(const std::array<size_t, 3> &c) const {
+    return c[0] + d_nCells[0] * (c[1] + d_nCells[1] * c[2]);
+  };
+
+  /*!
+   * @brief Adds points in cells overlapping the box around search point to
+   * the result (result adds the points within search radius)
+   *
+   * @param searchPoint Search point
+   * @param search_r Search radius
+   * @param resultSet Result of search
+   * @return N Number of points found
+   */
+  template <class ResultType>
+  size_t cellSearch(const util::Point &searchPoint, const double &search_r,
+                    ResultType &resultSet) const {
+
+    if (d_cellPoints.empty())
+      return 0;
+
+    std::array<size_t, 3> lo = {0, 0, 0}, hi = {0, 0, 0};
+    for (size_t d = 0; d < dim; d++) {
+      auto a = (searchPoint[d] - search_r - d_xMin[d]) / d_h;
+      auto b = (searchPoint[d] + search_r - d_xMin[d]) / d_h;
+      if (b < 0. or a >= double(d_nCells[d]))
+        return resultSet.size();
+
+      lo[d] = a < 0. ? 0 : size_t(a);
+      hi[d] = std::min(size_t(b), d_nCells[d] - 1);
+    }
+
+    for (size_t k = lo[2]; k <= hi[2]; k++)
+      for (size_t j = lo[1]; j <= hi[1]; j++) {
+        // cells along first direction are contiguous
+        auto c0 = cellId({lo[0], j, k});
+        auto c1 = cellId({hi[0], j, k});
+        for (size_t s = d_cellStart[c0]; s < d_cellStart[c1 + 1]; s++) {
+          double dist = 0.;
+          for (size_t d = 0; d < dim; d++) {
+            auto dx = d_sortedX[s * dim + d] - searchPoint[d];
+            dist += dx * dx;
+          }
+          resultSet.addPoint(dist, getId(d_cloud, d_cellPoints[s]));
+        }
+      }
+
+    return resultSet.size();
+  };
+
+public:
+  /*! @brief Coordinates of the points */
+  const PointCloudType &d_cloud;
+
+  /*! @brief Size of cell set by user (zero if it is computed) */
+  double d_cellSize;
+
+  /*! @brief Size of cell used in current grid */
+  double d_h;
+
+  /*! @brief Corner of the grid */
+  std::array<double, 3> d_xMin;
+
+  /*! @brief Number of cells along each direction */
+  std::array<size_t, 3> d_nCells;
+
+  /*! @brief Position of first point of each cell in d_cellPoints (size is
+   * number of cells + 1) */
+  std::vector<size_t> d_cellStart;
+
+  /*! @brief Ids of points sorted by cell */
+  std::vector<size_t> d_cellPoints;
+
+  /*! @brief Coordinates of points sorted by cell */
+  std::vector<double> d_sortedX;
+};
+
+} // namespace nsearch
+
+#endif // NSEARCH_CELLLISTSEARCH_H
@@ -12,6 +12,7 @@
 #define NSEARCH_NFLANNSETUP_H
 
 #include "util/point.h" // definition of Point
+#include "util/pointSoA.h" // definition of PointSoA
 #include "nanoflann/include/nanoflann.hpp"
 
 namespace nsearch {
@@ -19,30 +20,104 @@ namespace nsearch {
 /*! @brief Define list of points for tree search using nanoflann lib */
 typedef std::vector<util::Point> PointCloud;
 
+/*!
+ * @brief Get specific coordinate of a point in list of points
+ *
+ * @param x List of points
+ * @param idx Id of a point
+ * @param dim Coordinate id (e.g. 0, 1, 2)
+ * @return Coord Coordinate of a point
+ */
+inline double getCoord(const PointCloud &x, const size_t idx, const size_t dim) {
+  return x[idx][dim];
+}
+
+/*! @copydoc getCoord(const PointCloud &x, const size_t idx, const size_t dim) */
+inline double getCoord(const util::PointSoA &x, const size_t idx, const size_t dim) {
+  return x(idx, dim);
+}
+
+/*!
+ * @brief Subset of points of a list of points given by their ids
+ *
+ * Tree built on the subset only contains points of the subset, while the
+ * search results are ids of points in the full list (see getId()). E.g.,
+ * nodes of analytic walls are left out of the contact search tree.
+ */
+struct PointCloudSubset {
+
+  /*! @brief Const reference to full list of points */
+  const util::PointSoA &d_x;
+
+  /*! @brief Ids of points in the subset */
+  std::vector<size_t> d_ids;
+
+  /*!
+   * @brief Constructor
+   *
+   * @param x Full list of points
+   * @param ids Ids of points in the subset
+   */
+  PointCloudSubset(const util::PointSoA &x, std::vector<size_t> ids)
+      : d_x(x), d_ids(std::move(ids)) {}
+
+  /*!
+   * @brief Get number of points in the subset
+   *
+   * @return N Number of points
+   */
+  size_t size() const { return d_ids.size(); }
+};
+
+/*! @copydoc getCoord(const PointCloud &x, const size_t idx, const size_t dim) */
+inline double getCoord(const PointCloudSubset &x, const size_t idx, const size_t dim) {
+  return x.d_x(x.d_ids[idx], dim);
+}
+
+/*!
+ * @brief Get id of a point in the full list of points from its id in tree
+ *
+ * @param x List of points
+ * @param idx Id of a point in tree
+ * @return Id Id of a point in the full list
+ */
+inline size_t getId(const PointCloud &x, const size_t idx) { return idx; }
+
+/*! @copydoc getId(const PointCloud &x, const size_t idx) */
+inline size_t getId(const util::PointSoA &x, const size_t idx) { return idx; }
+
+/*! @copydoc getId(const PointCloud &x, const size_t idx) */
+inline size_t getId(const PointCloudSubset &x, const size_t idx) {
+  return x.d_ids[idx];
+}
+
 /*!
  * @brief Allows custom point cloud data structure to interface with nanoflann.
  * See https://github.com/jlblancoc/nanoflann for more details.
+ *
+ * PointCloudType can be PointCloud (vector of points) or util::PointSoA.
  */
+template <class PointCloudType = PointCloud>
 struct PointCloudAdaptor {
   /*! @brief Define coordinate type */
   typedef double coord_t;
 
   /*! @brief Const reference to list of points */
-  const PointCloud &d_obj;
+  const PointCloudType &d_obj;
 
   /*!
    * @brief Constructor
    *
    * @param obj Vector of points
    */
-  PointCloudAdaptor(const PointCloud &obj) : d_obj(obj) {}
+  PointCloudAdaptor(const PointCloudType &obj) : d_obj(obj) {}
 
   /*!
    * @brief Get vector of points
    *
    * @return Vector Vector of points
    */
-  inline const PointCloud &pointCloud() const { return d_obj; }
+  inline const PointCloudType &pointCloud() const { return d_obj; }
 
   /*!
    * @brief Get number of points in point cloud
@@ -60,7 +135,7 @@ struct PointCloudAdaptor {
    * @return Coord Coordinate of a point
    */
   inline coord_t kdtree_get_pt(const size_t idx, const size_t dim) const {
-    return pointCloud()[idx][dim];
+    return getCoord(pointCloud(), idx, dim);
   }
 
   /*!
@@ -424,6 +499,67 @@ public:
 };
 
 
+/*!
+ * @brief To collect results of nanoflann tree search when ids of points in
+ * tree differ from ids of points in the full list (see PointCloudSubset).
+ * Ids are converted using getId() before they are passed to the wrapped
+ * result, so that tags of points are also checked with correct ids.
+ */
+template <class ResultType, class PointCloudType>
+class TreeSearchIdMapResult {
+public:
+  /*! @brief Distance type (double, float, etc) */
+  typedef typename ResultType::DistanceType DistanceType;
+
+  /*! @brief Index type (int, size_t, etc) */
+  typedef typename ResultType::IndexType IndexType;
+
+  /*! @brief Wrapped result */
+  ResultType &d_res;
+
+  /*! @brief List of points on which tree is built */
+  const PointCloudType &d_cloud;
+
+  /*!
+   * @brief Constructor
+   *
+   * @param res Result to which points are added
+   * @param cloud List of points on which tree is built
+   */
+  inline TreeSearchIdMapResult(ResultType &res, const PointCloudType &cloud)
+      : d_res(res), d_cloud(cloud) {}
+
+  /*!
+  * @brief Get the size of currently stored (found so far) indices
+  *
+  * @return size Size of indices data
+  */
+  inline size_t size() const { return d_res.size(); }
+
+  /*!
+  * @brief Check (not implemented)
+   * @return bool Status
+  */
+  inline bool full() const { return d_res.full(); }
+
+  /*!
+  * @brief Called during search to add an element matching the criteria.
+  *
+  * @param dist Distance of point from the search point
+   * @param index Id of point in tree
+   * @return True True if continue the search further
+  */
+  inline bool addPoint(DistanceType dist, IndexType index) {
+    return d_res.addPoint(dist, getId(d_cloud, index));
+  }
+
+  /*!
+  * @brief Return maximum distance for search
+   * @return Radius Maximum distance for search
+  */
+  inline DistanceType worstDist() const { return d_res.worstDist(); }
+};
+
 /*! @brief Define result attributes */
 typedef TreeSearchResult<double, size_t> TreeSearchRes;
 typedef TreeSearchCheckIDIncludeResult<double, size_t> TreeSearchCheckIDIncludeRes;
@@ -432,21 +568,21 @@ typedef TreeSearchCheckIDExcludeResult<double, size_t> TreeSearchCheckIDExcludeR
 
 /*! @brief Define tree data type for nanoflann */
 typedef nanoflann::KDTreeSingleIndexAdaptor<
-    nanoflann::L2_Simple_Adaptor<double, PointCloudAdaptor>, PointCloudAdaptor,
+    nanoflann::L2_Simple_Adaptor<double, PointCloudAdaptor<>>, PointCloudAdaptor<>,
     3 /* dim */
 >
 NFlannKdTree;
 
 /*! @brief Define tree data type for nanoflann (3D) */
 typedef nanoflann::KDTreeSingleIndexAdaptor<
-        nanoflann::L2_Simple_Adaptor<double, PointCloudAdaptor>, PointCloudAdaptor,
+        nanoflann::L2_Simple_Adaptor<double, PointCloudAdaptor<>>, PointCloudAdaptor<>,
         3 /* dim */
 >
 NFlannKdTree3D;
 
 /*! @brief Define tree data type for nanoflann (2D) */
 typedef nanoflann::KDTreeSingleIndexAdaptor<
-  nanoflann::L2_Simple_Adaptor<double, PointCloudAdaptor>, PointCloudAdaptor,
+  nanoflann::L2_Simple_Adaptor<double, PointCloudAdaptor<>>, PointCloudAdaptor<>,
   2 /* dim */
 >
 NFlannKdTree2D;
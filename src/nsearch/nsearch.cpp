@@ -8,4 +8,122 @@
  * file LICENSE)
  */
 
-#include "nsearch.h"
\ No newline at end of file
+#include "nsearch.h"
+#include "util/parallelUtil.h"
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+#include <taskflow/taskflow/taskflow.hpp>
+#include <taskflow/taskflow/algorithm/for_each.hpp>
+
+namespace {
+
+/*! @brief Number of bits per direction in Morton index */
+const int morton_bits = 21;
+
+/*! @brief Spreads lower 21 bits of integer so that there are two zero bits
+ * between consecutive bits */
+uint64_t spreadBits(uint64_t x) {
+  x &= 0x1fffff;
+  x = (x | x << 32) & 0x1f00000000ffff;
+  x = (x | x << 16) & 0x1f0000ff0000ff;
+  x = (x | x << 8) & 0x100f00f00f00f00f;
+  x = (x | x << 4) & 0x10c30c30c30c30c3;
+  x = (x | x << 2) & 0x1249249249249249;
+  return x;
+}
+
+} // anonymous namespace
+
+std::vector<size_t> nsearch::getMortonOrder(
+        std::span<const util::Point> points) {
+
+  std::vector<size_t> order(points.size());
+  std::iota(order.begin(), order.end(), 0);
+  if (points.empty())
+    return order;
+
+  // bounding box (same scaling along all directions)
+  util::Point x_min = points[0], x_max = points[0];
+  for (const auto &x : points)
+    for (size_t d = 0; d < 3; d++) {
+      x_min[d] = std::min(x_min[d], x[d]);
+      x_max[d] = std::max(x_max[d], x[d]);
+    }
+
+  double L = 0.;
+  for (size_t d = 0; d < 3; d++)
+    L = std::max(L, x_max[d] - x_min[d]);
+
+  const double scale =
+          L > 0. ? double((uint64_t(1) << morton_bits) - 1) / L : 0.;
+
+  std::vector<uint64_t> keys(points.size());
+  for (size_t i = 0; i < points.size(); i++) {
+    uint64_t key = 0;
+    for (size_t d = 0; d < 3; d++)
+      key |= spreadBits(uint64_t((points[i][d] - x_min[d]) * scale)) << d;
+    keys[i] = key;
+  }
+
+  std::sort(order.begin(), order.end(),
+            [&keys](const size_t &a, const size_t &b) {
+              return keys[a] < keys[b] or (keys[a] == keys[b] and a < b);
+            });
+
+  return order;
+}
+
+void nsearch::BaseNSearch::radiusSearchBatch(
+        std::span<const util::Point> searchPoints,
+        std::span<const double> search_r,
+        const SearchBatchFn &fn,
+        SearchTagFilter filter,
+        std::span<const size_t> searchPointTags,
+        const std::vector<size_t> &dataTags) {
+
+  const size_t n = searchPoints.size();
+  if (search_r.size() != n or
+      (filter != SearchTagFilter::none and searchPointTags.size() != n)) {
+    std::cerr << "Error: Size of search radius or tag vector does not match "
+                 "number of search points in radiusSearchBatch().\n";
+    exit(1);
+  }
+
+  if (n == 0)
+    return;
+
+  const auto order = getMortonOrder(searchPoints);
+  const size_t chunk = std::max(d_batchChunkSize, size_t(1));
+  const size_t num_chunks = (n + chunk - 1) / chunk;
+
+  tf::Taskflow taskflow;
+
+  taskflow.for_each_index((std::size_t) 0, num_chunks, (std::size_t) 1,
+                          [this, &order, &searchPoints, &search_r, &fn,
+                           filter, &searchPointTags, &dataTags, chunk,
+                           n](std::size_t c) {
+
+    auto &buffer = getThreadSearchBuffer();
+    for (size_t k = c * chunk; k < std::min(n, (c + 1) * chunk); k++) {
+      const auto q = order[k];
+      if (filter == SearchTagFilter::exclude)
+        this->radiusSearchExcludeTag(searchPoints[q], search_r[q],
+                                     buffer.d_neighs, buffer.d_sqrDist,
+                                     searchPointTags[q], dataTags);
+      else if (filter == SearchTagFilter::include)
+        this->radiusSearchIncludeTag(searchPoints[q], search_r[q],
+                                     buffer.d_neighs, buffer.d_sqrDist,
+                                     searchPointTags[q], dataTags);
+      else
+        this->radiusSearch(searchPoints[q], search_r[q], buffer.d_neighs,
+                           buffer.d_sqrDist);
+
+      fn(q, buffer);
+    }
+  }
+  ); // for_each
+
+  util::parallel::runTaskflow(taskflow);
+}
@@ -14,6 +14,9 @@
 #include "util/point.h" // definition of Point
 #include "util/methods.h"
 #include <cstdint> // uint8_t type
+#include <functional>
+#include <limits>
+#include <span>
 #include <string> // size_t type
 #include <vector>
 
@@ -22,6 +25,94 @@
 /*! @brief Methods for performing efficient search of neighboring points */
 namespace nsearch {
 
+/*!
+ * @brief Reusable vectors holding results of radius search
+ *
+ * Result sets clear the vectors they are given without releasing memory, so
+ * a buffer that is reused for many queries stops allocating once it has
+ * grown to the size of the largest neighborhood.
+ */
+struct SearchBuffer {
+
+  /*! @brief Indices of points in neighborhood */
+  std::vector<size_t> d_neighs;
+
+  /*! @brief Squared distance of points in neighborhood */
+  std::vector<double> d_sqrDist;
+};
+
+/*!
+ * @brief Returns search buffer owned by the calling thread
+ *
+ * Buffer is shared by all queries of the thread, so results should be used
+ * before the next query of the thread that uses this buffer.
+ *
+ * @return buffer Search buffer of thread
+ */
+inline SearchBuffer &getThreadSearchBuffer() {
+  static thread_local SearchBuffer buffer;
+  return buffer;
+}
+
+/*!
+ * @brief Returns buffer owned by the calling thread that is used internally
+ * by search methods (e.g., by int and float versions of radius search). It
+ * is different from getThreadSearchBuffer() so that callers can pass that
+ * buffer to search methods.
+ *
+ * @return buffer Internal search buffer of thread
+ */
+inline SearchBuffer &getThreadInternalSearchBuffer() {
+  static thread_local SearchBuffer buffer;
+  return buffer;
+}
+
+/*!
+ * @brief Copies results of search into int and float vectors
+ *
+ * @param buffer Results of search
+ * @param neighs Indices of points (int)
+ * @param sqr_dist Squared distance of points (float)
+ */
+inline void copySearchResults(const SearchBuffer &buffer,
+                              std::vector<int> &neighs,
+                              std::vector<float> &sqr_dist) {
+  neighs.resize(buffer.d_neighs.size());
+  sqr_dist.resize(buffer.d_neighs.size());
+  for (size_t i = 0; i < buffer.d_neighs.size(); i++) {
+    neighs[i] = int(buffer.d_neighs[i]);
+    sqr_dist[i] = float(buffer.d_sqrDist[i]);
+  }
+}
+
+/*!
+ * @brief Returns order of points along Morton (Z-order) curve
+ *
+ * Points are mapped to an integer grid (21 bits per direction) covering
+ * their bounding box. Points close along the curve are close in space.
+ *
+ * @param points Coordinates of points
+ * @return order Index of point for each position along curve
+ */
+std::vector<size_t> getMortonOrder(std::span<const util::Point> points);
+
+/*! @brief Filter on tags of points in batched radius search (see
+ * BaseNSearch::radiusSearchBatch()) */
+enum class SearchTagFilter {
+  /*! @brief All points within search radius */
+  none,
+  /*! @brief Points with tag different from tag of query */
+  exclude,
+  /*! @brief Points with tag same as tag of query */
+  include
+};
+
+/*!
+ * @brief Function called for each query of batched radius search with index
+ * of query in batch and buffer holding its results
+ */
+typedef std::function<void(size_t, const SearchBuffer &)> SearchBatchFn;
+
 /*!
  * @brief A class for nearest neighbor search
  */
@@ -34,7 +125,7 @@ public:
    * @param debug Debug level to print information
    */
   BaseNSearch(std::string name, size_t debug = 0)
-      : d_debug(debug), d_treeType(name) {}
+      : d_debug(debug), d_treeType(name), d_batchChunkSize(64) {}
 
   /*!
    * @brief Function to implement point cloud update
@@ -51,6 +142,26 @@ public:
    */
   virtual double setInputCloud() = 0;
 
+  /*!
+   * @brief Update search structure after points of cloud have moved. Search
+   * methods that can do so keep their structure and only update the bounds,
+   * otherwise structure is rebuilt. Default is to rebuild.
+   * @param rebuilt Set to true if structure was rebuilt
+   * @return double Time taken to update the point cloud
+   */
+  virtual double refitInputCloud(bool &rebuilt) {
+    rebuilt = true;
+    return setInputCloud();
+  };
+
+  /*!
+   * @brief Set typical search radius. Search methods whose data depends on
+   * it (e.g. cell size in CellListSearch) use it in next call to
+   * setInputCloud(). Default is to ignore it.
+   * @param search_r Search radius
+   */
+  virtual void setSearchRadius(double search_r) {};
+
   /*!
    * @brief Perform radius search to find points in a point cloud within specified distance from a given point
    * @param searchPoint Point near which we want neighbors
@@ -152,6 +263,32 @@ public:
             const std::vector<size_t> &dataTags) = 0;
 
 
+    /*!
+     * @brief Perform radius search for a batch of points
+     *
+     * Queries are sorted along Morton curve of search points and split in
+     * chunks of consecutive queries that are processed in parallel, so that
+     * consecutive searches of a thread visit nearby parts of the search
+     * structure. Results of each query are written in search buffer of the
+     * thread (see getThreadSearchBuffer()) and passed to fn together with
+     * index of query in batch, so caller stores them in original order. fn
+     * is called concurrently for different queries.
+     *
+     * @param searchPoints Points near which we want neighbors
+     * @param search_r Search radius of each point
+     * @param fn Function to call with results of each query
+     * @param filter Filter on tags of points
+     * @param searchPointTags Tag of each search point (if filter is used)
+     * @param dataTags Vector of tags for each point in the pointcloud (if
+     * filter is used)
+     */
+    void radiusSearchBatch(std::span<const util::Point> searchPoints,
+                           std::span<const double> search_r,
+                           const SearchBatchFn &fn,
+                           SearchTagFilter filter = SearchTagFilter::none,
+                           std::span<const size_t> searchPointTags = {},
+                           const std::vector<size_t> &dataTags = {});
+
     /*!
      * @brief Find the closest points to the specified point
      * @param searchPoint Point near which we want neighbors
@@ -169,12 +306,19 @@ public:
 
   /*! @brief name of tree: nflann_kdtree */
   std::string d_treeType;
+
+  /*! @brief Number of consecutive queries processed by a task in
+   * radiusSearchBatch() */
+  size_t d_batchChunkSize;
 };
 
 /*!
  * @brief A class for nearest neighbor search using nanoflann library
+ *
+ * PointCloudType is the type of list of points, either PointCloud (vector of
+ * points) or util::PointSoA.
  */
-template <int dim = 3>
+template <int dim = 3, class PointCloudType = PointCloud>
 class NFlannSearchKd : public BaseNSearch {
 
 public:
@@ -184,12 +328,20 @@ public:
    * @param x Point cloud
    * @param debug Debug level to print information
    * @param max_leaf Maximum number of leafs
+   * @param n_thread_build Number of threads used to build the tree
    */
-  explicit NFlannSearchKd(const PointCloud &x, size_t debug = 0, size_t max_leafs = 10)
+  explicit NFlannSearchKd(const PointCloudType &x, size_t debug = 0,
+                          size_t max_leafs = 10,
+                          unsigned int n_thread_build = 1)
           : BaseNSearch("nflann_kdtree", debug),
             d_cloud(x),
             d_tree(dim, d_cloud,
-                   nanoflann::KDTreeSingleIndexAdaptorParams(max_leafs /* max leaf */)) {
+                   nanoflann::KDTreeSingleIndexAdaptorParams(
+                           max_leafs /* max leaf */,
+                           nanoflann::KDTreeSingleIndexAdaptorFlags::None,
+                           n_thread_build)),
+            d_maxRefitGrowth(2.),
+            d_refitLeafExtent(0.) {
     d_params.sorted = false;
   };
 
@@ -200,6 +352,38 @@ public:
   double setInputCloud() override  {
     auto t1 = steady_clock::now();
     d_tree.buildIndex();
+    d_refitLeafExtent = leafExtent(d_tree.root_node_);
+    auto t2 = steady_clock::now();
+    return util::methods::timeDiff(t1, t2);
+  };
+
+  /*!
+   * @brief Update tree after points of cloud have moved
+   *
+   * Topology of tree is kept and split bounds of nodes are recomputed from
+   * current coordinates. Tree is rebuilt if the number of points changed,
+   * if bounds of children of a node overlap along its split dimension (the
+   * search would then miss points), or if the sum of extents of leaf boxes
+   * exceeds d_maxRefitGrowth times the value after the last build.
+   *
+   * @param rebuilt Set to true if tree was rebuilt
+   * @return double Time taken to update the point cloud
+   */
+  double refitInputCloud(bool &rebuilt) override {
+    auto t1 = steady_clock::now();
+    rebuilt = true;
+    if (d_tree.root_node_ != nullptr and
+        d_tree.size_ == d_cloud.kdtree_get_point_count()) {
+      double leaf_extent = 0.;
+      if (refitNode(d_tree.root_node_, d_tree.root_bbox_, leaf_extent) and
+          leaf_extent <= d_maxRefitGrowth * d_refitLeafExtent)
+        rebuilt = false;
+    }
+
+    if (rebuilt) {
+      d_tree.buildIndex();
+      d_refitLeafExtent = leafExtent(d_tree.root_node_);
+    }
     auto t2 = steady_clock::now();
     return util::methods::timeDiff(t1, t2);
   };
@@ -232,7 +416,7 @@ public:
     double query_pt[3] = {searchPoint[0], searchPoint[1], searchPoint[2]};
 
     TreeSearchRes resultSet(search_r * search_r, neighs, sqr_dist);
-    return d_tree.radiusSearchCustomCallback(&query_pt[0], resultSet, d_params);
+    return treeSearch(&query_pt[0], resultSet);
   };
 
   /*!
@@ -246,21 +430,11 @@ public:
       std::vector<int> &neighs,
       std::vector<float> &sqr_dist) override {
 
-    // ugly but quick fix
-    // first, get results using int and float and then convert
-    std::vector<size_t> neighs_temp;
-    std::vector<double> sqr_dist_temp;
-    auto N =
-            this->radiusSearch(searchPoint, search_r, neighs_temp, sqr_dist_temp);
-
-    if (N > 0) {
-      neighs.resize(N);
-      sqr_dist.resize(N);
-      for (size_t i=0; i<N; i++) {
-        neighs.push_back(int(neighs_temp[i]));
-        sqr_dist.push_back(float(sqr_dist_temp[i]));
-      }
-    }
+    // search into buffer of thread and convert
+    auto &buffer = getThreadInternalSearchBuffer();
+    auto N = this->radiusSearch(searchPoint, search_r, buffer.d_neighs,
+                                buffer.d_sqrDist);
+    copySearchResults(buffer, neighs, sqr_dist);
 
     return N;
   };
@@ -288,7 +462,7 @@ public:
       TreeSearchCheckIDExcludeRes resultSet(search_r * search_r,
                             neighs, sqr_dist, searchPointTag, dataTags);
 
-      return d_tree.radiusSearchCustomCallback(&query_pt[0], resultSet, d_params);
+      return treeSearch(&query_pt[0], resultSet);
     };
 
     /*!
@@ -308,22 +482,12 @@ public:
             const size_t &searchPointTag,
             const std::vector<size_t> &dataTags) override {
 
-      // first, get results using int and float and then convert
-      std::vector<size_t> neighs_temp;
-      std::vector<double> sqr_dist_temp;
-      auto N =
-              this->radiusSearchExcludeTag(searchPoint, search_r,
-                                           neighs_temp, sqr_dist_temp,
-                                           searchPointTag, dataTags);
-
-      if (N > 0) {
-        neighs.resize(N);
-        sqr_dist.resize(N);
-        for (size_t i=0; i<N; i++) {
-          neighs.push_back(int(neighs_temp[i]));
-          sqr_dist.push_back(float(sqr_dist_temp[i]));
-        }
-      }
+      // search into buffer of thread and convert
+      auto &buffer = getThreadInternalSearchBuffer();
+      auto N = this->radiusSearchExcludeTag(searchPoint, search_r, buffer.d_neighs,
+                                           buffer.d_sqrDist, searchPointTag,
+                                           dataTags);
+      copySearchResults(buffer, neighs, sqr_dist);
 
       return N;
     };
@@ -351,7 +515,7 @@ public:
                                             neighs, sqr_dist,
                                             searchPointTag, dataTags);
 
-      return d_tree.radiusSearchCustomCallback(&query_pt[0], resultSet, d_params);
+      return treeSearch(&query_pt[0], resultSet);
     };
 
     /*!
@@ -371,22 +535,12 @@ public:
             const size_t &searchPointTag,
             const std::vector<size_t> &dataTags) override {
 
-      // first, get results using int and float and then convert
-      std::vector<size_t> neighs_temp;
-      std::vector<double> sqr_dist_temp;
-      auto N =
-              this->radiusSearchIncludeTag(searchPoint, search_r,
-                                           neighs_temp, sqr_dist_temp,
-                                           searchPointTag, dataTags);
-
-      if (N > 0) {
-        neighs.resize(N);
-        sqr_dist.resize(N);
-        for (size_t i=0; i<N; i++) {
-          neighs.push_back(int(neighs_temp[i]));
-          sqr_dist.push_back(float(sqr_dist_temp[i]));
-        }
-      }
+      // search into buffer of thread and convert
+      auto &buffer = getThreadInternalSearchBuffer();
+      auto N = this->radiusSearchIncludeTag(searchPoint, search_r, buffer.d_neighs,
+                                           buffer.d_sqrDist, searchPointTag,
+                                           dataTags);
+      copySearchResults(buffer, neighs, sqr_dist);
 
       return N;
     };
@@ -405,21 +559,143 @@ public:
       double query_pt[3] = {searchPoint[0], searchPoint[1], searchPoint[2]};
       unsigned int neigh_temp = 0;
       d_tree.knnSearch(&query_pt[0], 1, &neigh_temp, &sqrDistNeigh);
-      neigh = neigh_temp;
+      neigh = getId(d_cloud.pointCloud(), neigh_temp);
     };
 
+private:
+  /*! @brief Type of tree */
+  typedef nanoflann::KDTreeSingleIndexAdaptor<
+          nanoflann::L2_Simple_Adaptor<double, PointCloudAdaptor<PointCloudType>>,
+          PointCloudAdaptor<PointCloudType>,
+          dim
+  > TreeType;
+
+  /*!
+   * @brief Returns sum of extents of boxes of leafs of a node computed from
+   * current coordinates of points (tree is not modified)
+   *
+   * @param node Node of tree
+   * @return extent Sum of extents of boxes of leafs
+   */
+  double leafExtent(typename TreeType::NodePtr node) const {
+
+    if (node == nullptr)
+      return 0.;
+
+    if (node->child1 != nullptr or node->child2 != nullptr)
+      return leafExtent(node->child1) + leafExtent(node->child2);
+
+    const auto left = node->node_type.lr.left;
+    const auto right = node->node_type.lr.right;
+    if (left == right)
+      return 0.;
+
+    double extent = 0.;
+    for (int d = 0; d < dim; d++) {
+      double low = std::numeric_limits<double>::max();
+      double high = std::numeric_limits<double>::lowest();
+      for (auto k = left; k < right; k++) {
+        const double val = d_cloud.kdtree_get_pt(d_tree.vAcc_[k], d);
+        low = std::min(low, val);
+        high = std::max(high, val);
+      }
+      extent += high - low;
+    }
+
+    return extent;
+  };
+
+  /*!
+   * @brief Recomputes bounds of a node and its children from current
+   * coordinates of points
+   *
+   * @param node Node of tree
+   * @param bbox Bounding box of points in node
+   * @param leaf_extent Sum of extents of boxes of leafs (accumulated)
+   * @return bool False if bounds of children of some node overlap (nodes
+   * are then left partially updated)
+   */
+  bool refitNode(typename TreeType::NodePtr node,
+                 typename TreeType::BoundingBox &bbox, double &leaf_extent) {
+
+    if (node->child1 == nullptr and node->child2 == nullptr) {
+      const auto left = node->node_type.lr.left;
+      const auto right = node->node_type.lr.right;
+      for (int d = 0; d < dim; d++) {
+        bbox[d].low = std::numeric_limits<double>::max();
+        bbox[d].high = std::numeric_limits<double>::lowest();
+      }
+
+      // empty leaf keeps inverted box so that it is never visited
+      if (left == right)
+        return true;
+
+      for (auto k = left; k < right; k++) {
+        for (int d = 0; d < dim; d++) {
+          const double val = d_cloud.kdtree_get_pt(d_tree.vAcc_[k], d);
+          if (val < bbox[d].low)
+            bbox[d].low = val;
+          if (val > bbox[d].high)
+            bbox[d].high = val;
+        }
+      }
+
+      for (int d = 0; d < dim; d++)
+        leaf_extent += bbox[d].high - bbox[d].low;
+
+      return true;
+    }
+
+    // tree is rebuilt if refit fails so there is no need to continue
+    typename TreeType::BoundingBox left_bbox(bbox), right_bbox(bbox);
+    if (!refitNode(node->child1, left_bbox, leaf_extent) or
+        !refitNode(node->child2, right_bbox, leaf_extent))
+      return false;
+
+    const auto cutfeat = node->node_type.sub.divfeat;
+    node->node_type.sub.divlow = left_bbox[cutfeat].high;
+    node->node_type.sub.divhigh = right_bbox[cutfeat].low;
+
+    for (int d = 0; d < dim; d++) {
+      bbox[d].low = std::min(left_bbox[d].low, right_bbox[d].low);
+      bbox[d].high = std::max(left_bbox[d].high, right_bbox[d].high);
+    }
+
+    return node->node_type.sub.divlow <= node->node_type.sub.divhigh;
+  };
+
+  /*!
+   * @brief Performs radius search and adds points with their ids in the
+   * full list of points to the result
+   *
+   * @param query_pt Coordinates of search point
+   * @param resultSet Result of search
+   * @return N Number of points found
+   */
+  template <class ResultType>
+  size_t treeSearch(const double *query_pt, ResultType &resultSet) {
+    TreeSearchIdMapResult<ResultType, PointCloudType> mapped(
+            resultSet, d_cloud.pointCloud());
+    return d_tree.radiusSearchCustomCallback(query_pt, mapped, d_params);
+  };
+
 public:
   /*! @brief coordinates of the points */
-  PointCloudAdaptor d_cloud;
+  PointCloudAdaptor<PointCloudType> d_cloud;
 
   /*! @brief Tree */
-  nanoflann::KDTreeSingleIndexAdaptor<
-          nanoflann::L2_Simple_Adaptor<double, PointCloudAdaptor>, PointCloudAdaptor,
-          dim
-  > d_tree;
+  TreeType d_tree;
 
   /*! @brief Tree search parameters */
   nanoflann::SearchParameters d_params;
+
+  /*! @brief Maximum growth of sum of extents of leaf boxes, relative to
+   * the tree after build, before refitInputCloud() rebuilds the tree */
+  double d_maxRefitGrowth;
+
+private:
+  /*! @brief Sum of extents of leaf boxes when tree was last built */
+  double d_refitLeafExtent;
 };
 
 } // namespace nsearch
@@ -34,6 +34,9 @@ particle::BaseParticle::BaseParticle(std::string particle_type)
       d_density(0.),
       d_allDofsConstrained(false),
       d_computeForce(true),
+      d_sleeping(false),
+      d_restSteps(0),
+      d_analyticWall(false),
       d_material_p(nullptr),
       d_Rc(0.),
       d_Kn(0.),
@@ -88,6 +91,9 @@ particle::BaseParticle::BaseParticle(std::string particle_type,
           d_density(0),
           d_allDofsConstrained(are_all_dofs_constrained),
           d_computeForce(true),
+          d_sleeping(false),
+          d_restSteps(0),
+          d_analyticWall(false),
           d_material_p(nullptr),
           d_Rc(0.),
           d_Kn(0.),
@@ -136,9 +142,6 @@ particle::BaseParticle::BaseParticle(std::string particle_type,
           d_rp_p->getNodalVolume(i) *
           std::pow(d_tform.d_scale, d_rp_p->getDimension()));
       d_modelData_p->d_fix.push_back(uint8_t(0));
-      d_modelData_p->d_forceFixity.push_back(uint8_t(0));
-      d_modelData_p->d_thetaX.push_back(0.);
-      d_modelData_p->d_mX.push_back(0.);
       d_modelData_p->d_ptId.push_back(id); // id of this particle
     }
   }
@@ -208,6 +211,8 @@ std::string particle::BaseParticle::printStr(int nt, int lvl) const {
   oss << tabS << "d_h = " << d_h << std::endl;
   oss << tabS << "d_allDofsConstrained = " << d_allDofsConstrained << std::endl;
   oss << tabS << "d_computeForce = " << d_computeForce << std::endl;
+  oss << tabS << "d_sleeping = " << d_sleeping << std::endl;
+  oss << tabS << "d_analyticWall = " << d_analyticWall << std::endl;
   oss << tabS << "d_horizon = " << d_horizon << std::endl;
   oss << tabS << "d_density = " << d_density << std::endl;
   oss << tabS << "d_Rc = " << d_Rc << std::endl;
@@ -177,8 +177,7 @@ public:
    * @param i Global id of node
    * @return x Reference coordinate
    */
-  util::Point &getXRef(size_t i) { return d_modelData_p->getXRef(i); };
-  const util::Point &getXRef(size_t i) const { return d_modelData_p->getXRef(i); };
+  util::Point getXRef(size_t i) const { return d_modelData_p->getXRef(i); };
 
   /*!
    * @brief Set reference coordinate of the node
@@ -219,8 +218,7 @@ public:
    * @param i Local id of node
    * @return x Reference coordinate
    */
-  util::Point &getXRefLocal(size_t i) { return d_modelData_p->getXRef(i+d_globStart); };
-  const util::Point &getXRefLocal(size_t i) const { return d_modelData_p->getXRef(i+d_globStart); };
+  util::Point getXRefLocal(size_t i) const { return d_modelData_p->getXRef(i+d_globStart); };
 
   /*!
    * @brief Set reference coordinate of the node given node's local id
@@ -267,8 +265,7 @@ public:
    * @param i Global id of node
    * @return x Current coordinate
    */
-  util::Point &getX(size_t i) { return d_modelData_p->getX(i); };
-  const util::Point &getX(size_t i) const { return d_modelData_p->getX(i); };
+  util::Point getX(size_t i) const { return d_modelData_p->getX(i); };
 
   /*!
    * @brief Set current coordinate of the node
@@ -305,8 +302,7 @@ public:
    * @param i Local id of node
    * @return x Current coordinate
    */
-  util::Point &getXLocal(size_t i) { return d_modelData_p->getX(i+d_globStart); };
-  const util::Point &getXLocal(size_t i) const { return d_modelData_p->getX(i+d_globStart); };
+  util::Point getXLocal(size_t i) const { return d_modelData_p->getX(i+d_globStart); };
 
   /*!
    * @brief Set current coordinate of the node given node's local id
@@ -352,8 +348,7 @@ public:
    * @param i Global id of node
    * @return u Displacement
    */
-  util::Point &getU(size_t i) { return d_modelData_p->getU(i); };
-  const util::Point &getU(size_t i) const { return d_modelData_p->getU(i); };
+  util::Point getU(size_t i) const { return d_modelData_p->getU(i); };
 
   /*!
    * @brief Set displacement of the node
@@ -390,10 +385,7 @@ public:
    * @param i Local id of node
    * @return u Displacement
    */
-  util::Point &getULocal(size_t i) { return d_modelData_p->getU(i+d_globStart); };
-
-  /*! @copydoc getULocal(size_t i) */
-  const util::Point &getULocal(size_t i) const { return d_modelData_p->getU(i+d_globStart); };
+  util::Point getULocal(size_t i) const { return d_modelData_p->getU(i+d_globStart); };
 
   /*!
    * @brief Set displacement of the node given node's local id
@@ -439,8 +431,7 @@ public:
    * @param i Global id of node
    * @return v Velocity
    */
-  util::Point &getV(size_t i) { return d_modelData_p->getV(i); };
-  const util::Point &getV(size_t i) const { return d_modelData_p->getV(i); };
+  util::Point getV(size_t i) const { return d_modelData_p->getV(i); };
 
   /*!
    * @brief Set velocity of the node
@@ -477,8 +468,7 @@ public:
    * @param i Local id of node
    * @return v Velocity
    */
-  util::Point &getVLocal(size_t i) { return d_modelData_p->getV(i+d_globStart); };
-  const util::Point &getVLocal(size_t i) const { return d_modelData_p->getV(i+d_globStart); };
+  util::Point getVLocal(size_t i) const { return d_modelData_p->getV(i+d_globStart); };
 
   /*!
    * @brief Set velocity of the node given node's local id
@@ -524,8 +514,7 @@ public:
    * @param i Global id of node
    * @return f Force
    */
-  util::Point &getF(size_t i) { return d_modelData_p->getF(i); };
-  const util::Point &getF(size_t i) const { return d_modelData_p->getF(i); };
+  util::Point getF(size_t i) const { return d_modelData_p->getF(i); };
 
   /*!
    * @brief Set force of the node
@@ -562,8 +551,7 @@ public:
    * @param i Local id of node
    * @return f Force
    */
-  util::Point &getFLocal(size_t i) { return d_modelData_p->getF(i+d_globStart); };
-  const util::Point &getFLocal(size_t i) const { return d_modelData_p->getF(i+d_globStart); };
+  util::Point getFLocal(size_t i) const { return d_modelData_p->getF(i+d_globStart); };
 
   /*!
    * @brief Set force of the node given node's local id
@@ -822,12 +810,7 @@ public:
    * @brief Get current coordinate of center node
    * @return x Current coordinate
    */
-  util::Point &getXCenter() {
-    return d_modelData_p->getX(d_globStart + d_rp_p->getCenterNodeId());
-  };
-
-  /*! @copydoc getXCenter() */
-  const util::Point &getXCenter() const {
+  util::Point getXCenter() const {
     return d_modelData_p->getX(d_globStart + d_rp_p->getCenterNodeId());
   };
 
@@ -835,12 +818,7 @@ public:
    * @brief Get displacement of center node
    * @return u Displacement
    */
-  util::Point &getUCenter() {
-    return d_modelData_p->getU(d_globStart + d_rp_p->getCenterNodeId());
-  };
-
-  /*! @copydoc getUCenter() */
-  const util::Point &getUCenter() const {
+  util::Point getUCenter() const {
     return d_modelData_p->getU(d_globStart + d_rp_p->getCenterNodeId());
   };
 
@@ -848,12 +826,7 @@ public:
    * @brief Get velocity of center node
    * @return v Velocity
    */
-  util::Point &getVCenter() {
-    return d_modelData_p->getV(d_globStart + d_rp_p->getCenterNodeId());
-  };
-
-  /*! @copydoc getVCenter() */
-  const util::Point &getVCenter() const {
+  util::Point getVCenter() const {
     return d_modelData_p->getV(d_globStart + d_rp_p->getCenterNodeId());
   };
   /** @}*/
@@ -923,6 +896,17 @@ public:
   /*! @brief Specify if we compute force */
   bool d_computeForce;
 
+  /*! @brief Specify if particle is sleeping, i.e., it is at rest and its
+   * nodes are skipped in integration and force computation (see
+   * inp::ModelDeck::d_sleepVelocityThreshold) */
+  bool d_sleeping;
+
+  /*! @brief Number of time steps for which particle has been at rest */
+  size_t d_restSteps;
+
+  /*! @brief Specify if wall is analytic (see inp::ParticleZone::d_analyticWall) */
+  bool d_analyticWall;
+
   /*! @brief horizon */
   double d_horizon;
 
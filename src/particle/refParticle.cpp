@@ -11,6 +11,7 @@
 #include "refParticle.h"
 #include "inp/pdecks/particleDeck.h"
 #include "fe/baseElem.h"
+#include "fe/meshUtil.h"
 #include "util/geom.h"
 #include <iostream>
 
@@ -45,6 +46,27 @@ particle::RefParticle::RefParticle(size_t id,
   }
 }
 
+void particle::RefParticle::setupBoundaryNodes() {
+
+  d_bNodes = fe::getBoundaryNodes(*d_mesh_p);
+  d_bDist.assign(d_mesh_p->getNumNodes(), 0.);
+  if (d_bNodes.empty())
+    return;
+
+  std::vector<util::Point> x_b;
+  for (auto i : d_bNodes)
+    x_b.push_back(d_mesh_p->getNode(i));
+
+  auto nsearch = nsearch::NFlannSearchKd<3>(x_b);
+  nsearch.setInputCloud();
+  for (size_t i = 0; i < d_mesh_p->getNumNodes(); i++) {
+    size_t j;
+    double sqr_dist;
+    nsearch.closestPoint(d_mesh_p->getNode(i), j, sqr_dist);
+    d_bDist[i] = std::sqrt(sqr_dist);
+  }
+}
+
 std::string particle::RefParticle::printStr(int nt, int lvl) const {
 
   auto tabS = util::io::getTabS(nt);
@@ -62,6 +84,7 @@ std::string particle::RefParticle::printStr(int nt, int lvl) const {
   oss << d_geom_p->printStr(nt + 1, lvl);
   oss << tabS << "Radius = " << d_pRadius << std::endl;
   oss << tabS << "Num interior flag data = " << d_intFlags.size() << std::endl;
+  oss << tabS << "Num boundary nodes = " << d_bNodes.size() << std::endl;
 
   oss << tabS << std::endl;
 
@@ -129,8 +129,25 @@ public:
    */
   double getParticleRadius() const { return d_pRadius; };
 
+  /*!
+   * @brief Get distance of node from the closest boundary node (zero if
+   * boundary nodes are not computed, see setupBoundaryNodes())
+   * @param i Id of node
+   * @return Distance Distance from boundary
+   */
+  double getBoundaryDistance(const size_t &i) const {
+    return d_bDist.empty() ? 0. : d_bDist[i];
+  };
+
   /** @}*/
 
+  /*!
+   * @brief Finds nodes on boundary of mesh (see fe::getBoundaryNodes()) and
+   * computes distance of each node from the closest boundary node. If mesh
+   * does not have element data, distance is zero for all nodes.
+   */
+  void setupBoundaryNodes();
+
   /*!
    * @brief Returns the string containing printable information about the object
    *
@@ -170,6 +187,9 @@ public:
   /*! @brief List of nodes near boundary */
   std::vector<size_t> d_bNodes;
 
+  /*! @brief Distance of nodes from the closest node in d_bNodes */
+  std::vector<double> d_bDist;
+
   /*!
    * @brief Interior flags. For given node i the flag is d_intFlags[i%8]. We
    * use 1 bit per node.
@@ -47,8 +47,10 @@ void rw::writer::VtkParticleWriter::appendNodes(
   auto points = vtkSmartPointer<vtkPoints>::New();
 
   // get all the nodes first
-  for (const auto &x : model->d_x)
+  for (size_t i = 0; i < model->d_x.size(); i++) {
+    const auto x = model->getX(i);
     points->InsertNextPoint(x.d_x, x.d_y, x.d_z);
+  }
 
   // write point data
   d_grid_p = vtkSmartPointer<vtkUnstructuredGrid>::New();
@@ -73,7 +75,8 @@ void rw::writer::VtkParticleWriter::appendNodes(
     array->SetComponentName(1, "y");
     array->SetComponentName(2, "z");
 
-    for (const auto &ui : model->d_u) {
+    for (size_t i = 0; i < model->d_u.size(); i++) {
+      const auto ui = model->getU(i);
       value[0] = ui.d_x;
       value[1] = ui.d_y;
       value[2] = ui.d_z;
@@ -95,7 +98,8 @@ void rw::writer::VtkParticleWriter::appendNodes(
     array->SetComponentName(1, "y");
     array->SetComponentName(2, "z");
 
-    for (const auto &ui : model->d_v) {
+    for (size_t i = 0; i < model->d_v.size(); i++) {
+      const auto ui = model->getV(i);
       value[0] = ui.d_x;
       value[1] = ui.d_y;
       value[2] = ui.d_z;
@@ -117,7 +121,8 @@ void rw::writer::VtkParticleWriter::appendNodes(
     array->SetComponentName(1, "y");
     array->SetComponentName(2, "z");
 
-    for (const auto &ui : model->d_f) {
+    for (size_t i = 0; i < model->d_f.size(); i++) {
+      const auto ui = model->getF(i);
       value[0] = ui.d_x;
       value[1] = ui.d_y;
       value[2] = ui.d_z;
@@ -139,15 +144,13 @@ void rw::writer::VtkParticleWriter::appendNodes(
     array->SetComponentName(1, "y");
     array->SetComponentName(2, "z");
 
-    size_t i_count = 0;
-    for (const auto &ui : model->d_f) {
-      const auto &voli = model->d_vol[i_count];
+    for (size_t i = 0; i < model->d_f.size(); i++) {
+      const auto ui = model->getF(i);
+      const auto &voli = model->d_vol[i];
       value[0] = ui.d_x * voli;
       value[1] = ui.d_y * voli;
       value[2] = ui.d_z * voli;
       array->InsertNextTuple(value);
-
-      i_count++;
     }
 
     // write
@@ -204,17 +207,17 @@ void rw::writer::VtkParticleWriter::appendNodes(
     d_grid_p->GetPointData()->AddArray(array);
   } // Zone ID
 
-  // handle force fixity
+  // handle force fixity (no dof of node is fixed for force, so zero is
+  // written for each node)
   if (util::methods::isTagInList("Force_Fixity", tags)) {
 
     auto array = vtkSmartPointer<vtkDoubleArray>::New();
     array->SetNumberOfComponents(1);
     array->SetName("Force_Fixity");
 
-    for (const auto &n : model->d_forceFixity) {
-      p_tag[0] = double(n);
+    p_tag[0] = 0.;
+    for (size_t i = 0; i < model->d_x.size(); i++)
       array->InsertNextTuple(p_tag);
-    }
 
     // write
     d_grid_p->GetPointData()->AddArray(array);
@@ -376,7 +379,7 @@ void rw::writer::VtkParticleWriter::appendContactData(
 
   // get all the nodes first
   for (const auto &i : *processed_nodes) {
-    const auto &x = model->d_x[i];
+    const auto x = model->getX(i);
     points->InsertNextPoint(x.d_x, x.d_y, x.d_z);
   }
 
@@ -425,8 +428,8 @@ void rw::writer::VtkParticleWriter::appendContactData(
       auto glob_id1 = (*processed_nodes)[ids[0]];
       auto glob_id2 = (*processed_nodes)[ids[1]];
 
-      const auto &x1 = model->d_x[glob_id1];
-      const auto &x2 = model->d_x[glob_id2];
+      const auto x1 = model->getX(glob_id1);
+      const auto x2 = model->getX(glob_id2);
 
       auto xd = (x1 - x2)/((x2 - x1).length());
 
@@ -603,6 +603,19 @@ double util::computeMeshSize(const std::vector<util::Point> &nodes, size_t start
   return guess;
 }
 
+double util::computeMeshSize(const util::PointSoA &nodes, size_t start,
+                             size_t end) {
+
+  if (end <= start)
+    return 0.;
+
+  std::vector<util::Point> nodes_range(end - start);
+  for (size_t i = start; i < end; i++)
+    nodes_range[i - start] = nodes.get(i);
+
+  return computeMeshSize(nodes_range);
+}
+
 std::pair<util::Point, util::Point> util::computeBBox(const std::vector<util::Point> &nodes) {
 
   auto p1 = util::Point();
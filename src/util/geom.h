@@ -12,6 +12,7 @@
 #define UTIL_GEOMETRY_H
 
 #include "point.h" // definition of Point
+#include "pointSoA.h" // definition of PointSoA
 #include <vector>
 
 namespace util {
@@ -306,6 +307,10 @@ double computeMeshSize(const std::vector<util::Point> &nodes);
 double computeMeshSize(const std::vector<util::Point> &nodes, size_t start,
                        size_t end);
 
+/*! @copydoc computeMeshSize(const std::vector<util::Point> &nodes, size_t start, size_t end) */
+double computeMeshSize(const util::PointSoA &nodes, size_t start,
+                       size_t end);
+
 /*!
  * @brief Computes bounding box for vector nodes
  *
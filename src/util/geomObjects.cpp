@@ -9,6 +9,8 @@
 #include "function.h"
 #include "geom.h"
 #include "methods.h"
+#include <algorithm>
+#include <limits>
 #include <vector>
 #include <set>
 
@@ -30,6 +32,25 @@ namespace {
 
     return oss.str();
   }
+
+  /*
+   * Signed distance of point from axis-aligned box centered at origin with
+   * given half edge lengths (only first dim components are used)
+   */
+  double boxSignedDistance(const util::Point &dx, const util::Point &half,
+                           size_t dim) {
+
+    double out_sq = 0.;
+    double in_max = -std::numeric_limits<double>::max();
+    for (size_t i = 0; i < dim; i++) {
+      auto q = std::abs(dx[i]) - half[i];
+      if (q > 0.)
+        out_sq += q * q;
+      in_max = std::max(in_max, q);
+    }
+
+    return std::sqrt(out_sq) + std::min(in_max, 0.);
+  }
 };
 
 //
@@ -412,6 +433,10 @@ namespace util {
     return isNearBoundary(x, 1.0E-8, false);
   }
 
+  double util::geometry::Square::signedDistance(const util::Point &x) const {
+    return boxSignedDistance(x - d_x, 0.5 * util::Point(d_L, d_L, 0.), 2);
+  }
+
   bool util::geometry::Square::isInside(
           const std::pair<util::Point, util::Point> &box) const {
 
@@ -549,6 +574,10 @@ namespace util {
       return isNearBoundary(x, 1.0E-8, false);
     }
 
+    double util::geometry::Rectangle::signedDistance(const util::Point &x) const {
+      return boxSignedDistance(x - d_x, 0.5 * util::Point(d_Lx, d_Ly, 0.), 2);
+    }
+
     bool util::geometry::Rectangle::isInside(
             const std::pair<util::Point, util::Point> &box) const {
 
@@ -984,6 +1013,10 @@ namespace util {
       return isNearBoundary(x, 1.0E-8, false);
     }
 
+    double util::geometry::Cube::signedDistance(const util::Point &x) const {
+      return boxSignedDistance(x - d_x, 0.5 * util::Point(d_L, d_L, d_L), 3);
+    }
+
     bool util::geometry::Cube::isInside(
             const std::pair<util::Point, util::Point> &box) const {
 
@@ -1126,6 +1159,10 @@ namespace util {
       return isNearBoundary(x, 1.0E-8, false);
     }
 
+    double util::geometry::Cuboid::signedDistance(const util::Point &x) const {
+      return boxSignedDistance(x - d_x, 0.5 * util::Point(d_Lx, d_Ly, d_Lz), 3);
+    }
+
     bool util::geometry::Cuboid::isInside(
             const std::pair<util::Point, util::Point> &box) const {
 
@@ -1266,6 +1303,10 @@ namespace util {
       return isNearBoundary(x, 1.0E-8, false);
     }
 
+    double util::geometry::Circle::signedDistance(const util::Point &x) const {
+      return (x - d_x).length() - d_r;
+    }
+
     bool util::geometry::Circle::isInside(
             const std::pair<util::Point, util::Point> &box) const {
 
@@ -1469,6 +1510,17 @@ namespace util {
       return isNearBoundary(x, 1.0E-8, false);
     }
 
+    double util::geometry::Cylinder::signedDistance(const util::Point &x) const {
+      // signed distance from 2d box in (radial, axial) coordinates
+      auto dx = x - d_xBegin;
+      double dx_dot_xa = dx * d_xa;
+      auto dx_project = dx - dx_dot_xa * d_xa;
+
+      return boxSignedDistance(
+              util::Point(dx_project.length(), dx_dot_xa - 0.5 * d_l, 0.),
+              util::Point(d_r, 0.5 * d_l, 0.), 2);
+    }
+
     bool util::geometry::Cylinder::isInside(
             const std::pair<util::Point, util::Point> &box) const {
 
@@ -1609,6 +1661,10 @@ namespace util {
       return isNearBoundary(x, 1.0E-8, false);
     }
 
+    double util::geometry::Sphere::signedDistance(const util::Point &x) const {
+      return (x - d_x).length() - d_r;
+    }
+
     bool util::geometry::Sphere::isInside(
             const std::pair<util::Point, util::Point> &box) const {
 
@@ -1770,6 +1826,12 @@ namespace util {
       return isNearBoundary(x, 1.0E-8, false);
     }
 
+    double util::geometry::AnnulusGeomObject::signedDistance(const util::Point &x) const {
+      // inside outer object and outside inner object
+      return std::max(d_outObj_p->signedDistance(x),
+                      -d_inObj_p->signedDistance(x));
+    }
+
     bool util::geometry::AnnulusGeomObject::isInside(
             const std::pair<util::Point, util::Point> &box) const {
 
@@ -1969,6 +2031,22 @@ namespace util {
       return isNearBoundary(x, 1.0E-8, false);
     }
 
+    double util::geometry::ComplexGeomObject::signedDistance(const util::Point &x) const {
+      // union for objects with plus flag and difference for objects with
+      // minus flag (same order as in isInside())
+      double dist = d_obj[0]->signedDistance(x);
+      for (size_t i = 1; i < d_objFlag.size(); i++) {
+
+        const auto &obj_i = d_obj[i];
+        if (d_objFlagInt[i] < 0)
+          dist = std::max(dist, -obj_i->signedDistance(x));
+        else
+          dist = std::min(dist, obj_i->signedDistance(x));
+      }
+
+      return dist;
+    }
+
     bool util::geometry::ComplexGeomObject::isInside(
             const std::pair<util::Point, util::Point> &box) const {
 
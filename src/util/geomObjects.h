@@ -133,6 +133,21 @@ namespace util {
             virtual bool
             doesIntersect(const util::Point &x) const { return false; };
 
+            /*!
+             * @brief Computes signed distance of point from the boundary of
+             * this object (negative inside and positive outside)
+             *
+             * Used to compute contact with rigid walls without meshing them.
+             *
+             * @param x Point
+             * @return Distance Signed distance
+             */
+            virtual double signedDistance(const util::Point &x) const {
+              std::cerr << "Error: Signed distance is not implemented for "
+                           "geometry = " << d_name << ".\n";
+              exit(1);
+            };
+
             /** @}*/
 
             /**
@@ -752,6 +767,11 @@ namespace util {
              */
             bool doesIntersect(const util::Point &x) const override;
 
+            /*!
+             * @copydoc GeomObject::signedDistance(const util::Point &x) const
+             */
+            double signedDistance(const util::Point &x) const override;
+
             /** @}*/
 
             /**
@@ -949,6 +969,11 @@ namespace util {
              */
             bool doesIntersect(const util::Point &x) const override;
 
+            /*!
+             * @copydoc GeomObject::signedDistance(const util::Point &x) const
+             */
+            double signedDistance(const util::Point &x) const override;
+
             /** @}*/
 
             /**
@@ -1587,6 +1612,11 @@ namespace util {
              */
             bool doesIntersect(const util::Point &x) const override;
 
+            /*!
+             * @copydoc GeomObject::signedDistance(const util::Point &x) const
+             */
+            double signedDistance(const util::Point &x) const override;
+
             /** @}*/
 
             /**
@@ -1825,6 +1855,11 @@ namespace util {
              */
             bool doesIntersect(const util::Point &x) const override;
 
+            /*!
+             * @copydoc GeomObject::signedDistance(const util::Point &x) const
+             */
+            double signedDistance(const util::Point &x) const override;
+
             /** @}*/
 
             /**
@@ -1990,6 +2025,11 @@ namespace util {
              */
             bool doesIntersect(const util::Point &x) const override;
 
+            /*!
+             * @copydoc GeomObject::signedDistance(const util::Point &x) const
+             */
+            double signedDistance(const util::Point &x) const override;
+
             /** @}*/
 
             /**
@@ -2313,6 +2353,11 @@ namespace util {
              */
             bool doesIntersect(const util::Point &x) const override;
 
+            /*!
+             * @copydoc GeomObject::signedDistance(const util::Point &x) const
+             */
+            double signedDistance(const util::Point &x) const override;
+
             /** @}*/
 
             /**
@@ -2492,6 +2537,11 @@ namespace util {
              */
             bool doesIntersect(const util::Point &x) const override;
 
+            /*!
+             * @copydoc GeomObject::signedDistance(const util::Point &x) const
+             */
+            double signedDistance(const util::Point &x) const override;
+
             /** @}*/
 
             /**
@@ -2657,6 +2707,11 @@ namespace util {
              */
             bool doesIntersect(const util::Point &x) const override;
 
+            /*!
+             * @copydoc GeomObject::signedDistance(const util::Point &x) const
+             */
+            double signedDistance(const util::Point &x) const override;
+
             /** @}*/
 
             /**
@@ -2827,6 +2882,11 @@ namespace util {
              */
             bool doesIntersect(const util::Point &x) const override;
 
+            /*!
+             * @copydoc GeomObject::signedDistance(const util::Point &x) const
+             */
+            double signedDistance(const util::Point &x) const override;
+
             /** @}*/
 
             /**
@@ -422,11 +422,11 @@ namespace util {
 
         if (check_passed) {
           // if check is passed
-          auto rin = new util::geometry::Rectangle(
+          auto rout = new util::geometry::Rectangle(
                   util::Point(params[0], params[1],
                               params[2]),
                   util::Point(params[3], params[4], params[5]));
-          auto rout = new util::geometry::Rectangle(
+          auto rin = new util::geometry::Rectangle(
                   util::Point(params[6], params[7],
                               params[8]),
                   util::Point(params[9], params[10],
@@ -448,12 +448,12 @@ namespace util {
 
         if (check_passed) {
           // if check is passed
-          auto rin = new util::geometry::Cuboid(
+          auto rout = new util::geometry::Cuboid(
                   util::Point(params[0], params[1],
                               params[2]),
                   util::Point(params[3], params[4],
                               params[5]));
-          auto rout = new util::geometry::Cuboid(
+          auto rin = new util::geometry::Cuboid(
                   util::Point(params[6], params[7],
                               params[8]),
                   util::Point(params[9], params[10],
@@ -835,10 +835,10 @@ namespace util {
           if (params.size() == n) {
             if (n == 12) {
 
-              auto rin = new util::geometry::Rectangle(
+              auto rout = new util::geometry::Rectangle(
                       util::Point(params[0], params[1], params[2]),
                       util::Point(params[3], params[4], params[5]));
-              auto rout = new util::geometry::Rectangle(
+              auto rin = new util::geometry::Rectangle(
                       util::Point(params[6], params[7], params[8]),
                       util::Point(params[9], params[10], params[11]));
 
@@ -858,10 +858,10 @@ namespace util {
           if (params.size() == n) {
             if (n == 12) {
 
-              auto rin = new util::geometry::Cuboid(
+              auto rout = new util::geometry::Cuboid(
                       util::Point(params[0], params[1], params[2]),
                       util::Point(params[3], params[4], params[5]));
-              auto rout = new util::geometry::Cuboid(
+              auto rin = new util::geometry::Cuboid(
                       util::Point(params[6], params[7], params[8]),
                       util::Point(params[9], params[10], params[11]));
 
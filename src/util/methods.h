@@ -11,6 +11,7 @@
 #pragma once
 
 #include "point.h"           // definition of Point
+#include "pointSoA.h"        // definition of PointSoA
 #include <cstdint> // uint8_t type
 #include <cstring> // string and size_t type
 #include <vector>
@@ -214,6 +215,16 @@ inline std::pair<double, size_t> maxLengthAndMaxLengthIndex(const std::vector<ut
       return {length_data[i], i};
 };
 
+/*! @copydoc maxLengthAndMaxLengthIndex(const std::vector<util::Point> &data) */
+inline std::pair<double, size_t> maxLengthAndMaxLengthIndex(const util::PointSoA &data) {
+      std::vector<double> length_data(data.size());
+      for (size_t i = 0; i < data.size(); i++)
+        length_data[i] = data.get(i).length();
+
+      auto i = util::methods::maxIndex(length_data);
+      return {length_data[i], i};
+};
+
 /*!
  * @brief Returns the minimum length of point and index from list of points
  * @param data List of points
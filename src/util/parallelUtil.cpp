@@ -11,6 +11,7 @@
 #include "parallelUtil.h"
 #include <iostream>
 #include <sstream>
+#include <taskflow/taskflow/taskflow.hpp>
 
 namespace {
 
@@ -20,6 +21,7 @@ namespace {
 
     // Thread-related (via Taskflow)
     unsigned int numThreads = 0;
+    tf::Executor *executor_p = nullptr;
 }
 
 void util::parallel::initMpi(int argc, char *argv[]) {
@@ -107,6 +109,10 @@ const util::parallel::MpiStatus *util::parallel::getMpiStatus() {
 }
 
 void util::parallel::initNThreads(unsigned int nThreads) {
+  if (executor_p != nullptr)
+    std::cout << "Executor is already created with " << executor_p->num_workers()
+              << " threads. Call to initNThreads() will not change it.\n";
+
   if (numThreads > 0) {
     std::cout << "Number of threads numThreads is already initialized.\n";
   } else
@@ -119,4 +125,16 @@ unsigned int util::parallel::getNThreads() {
   return numThreads;
 }
 
+tf::Executor &util::parallel::getExecutor() {
+  if (executor_p == nullptr)
+    executor_p = new tf::Executor(getNThreads());
+  return *executor_p;
+}
 
+void util::parallel::runTaskflow(tf::Taskflow &taskflow) {
+  auto &executor = getExecutor();
+  if (executor.this_worker_id() >= 0)
+    executor.corun(taskflow);
+  else
+    executor.run(taskflow).get();
+}
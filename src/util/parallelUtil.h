@@ -15,6 +15,12 @@
 #include <vector>
 #include <thread>
 
+// forward declaration of taskflow executor
+namespace tf {
+class Executor;
+class Taskflow;
+}
+
 namespace util {
 
     /*! @brief Implements some key functions and classes regularly used in the code when running with MPI */
@@ -107,5 +113,29 @@ namespace util {
          * @return nThreads Number of threads
          */
         unsigned int getNThreads();
+
+        /*!
+         * @brief Get the executor shared by all parallel sections in the code
+         *
+         * Executor is created on first call with getNThreads() workers and
+         * lives until the end of the program. Creating a tf::Executor spawns
+         * and joins a pool of threads, so parallel loops should use this
+         * executor instead of creating their own.
+         *
+         * @return executor Reference to the taskflow executor
+         */
+        tf::Executor &getExecutor();
+
+        /*!
+         * @brief Runs the taskflow on the shared executor and waits for it
+         *
+         * If called from a worker of the executor, e.g., from inside a task
+         * of a larger task graph, the calling worker joins the execution of
+         * the taskflow (corun) instead of blocking, so that nested parallel
+         * sections do not deadlock the executor.
+         *
+         * @param taskflow Taskflow to run
+         */
+        void runTaskflow(tf::Taskflow &taskflow);
     } // namespace parallel
 } // namespace util
\ No newline at end of file
@@ -0,0 +1,225 @@
+/*
+ * -------------------------------------------
+ * Copyright (c) 2021 - 2024 Prashant K. Jha
+ * -------------------------------------------
+ * PeriDEM https://github.com/prashjha/PeriDEM
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE)
+ */
+
+#ifndef UTIL_POINTSOA_H
+#define UTIL_POINTSOA_H
+
+#include "point.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <vector>
+
+namespace util {
+
+/*!
+ * @brief A structure-of-arrays (SoA) container for list of 3d vectors
+ *
+ * Each of the first dim() components of the vectors is stored in its own
+ * contiguous array. Components beyond dim() are not stored and are zero,
+ * e.g., in two-dimensional simulations only x and y components are stored.
+ * This cuts the memory traffic of loops over nodes compared to storing
+ * util::Point for each node, and allows loops to stream each component
+ * contiguously via data().
+ *
+ * Individual vectors are accessed as util::Point using get() and modified
+ * using set() and add(). Components are accessed using operator()(i, dof).
+ */
+class PointSoA {
+
+public:
+  /*! @brief Maximum number of components */
+  static constexpr size_t max_dim = 3;
+
+  /*!
+   * @brief Constructor
+   *
+   * @param dim Number of components to store (values outside [1, 3] are
+   * replaced by 3)
+   */
+  explicit PointSoA(size_t dim = max_dim)
+      : d_dim((dim < 1 or dim > max_dim) ? max_dim : dim) {}
+
+  /*!
+   * @brief Returns number of components stored
+   *
+   * @return dim Number of components
+   */
+  size_t dim() const { return d_dim; }
+
+  /*!
+   * @brief Returns number of vectors
+   *
+   * @return n Number of vectors
+   */
+  size_t size() const { return d_data[0].size(); }
+
+  /*!
+   * @brief Returns true if container is empty
+   *
+   * @return bool True if empty
+   */
+  bool empty() const { return d_data[0].empty(); }
+
+  /*!
+   * @brief Resizes the container (new vectors are set to zero)
+   *
+   * @param n New size
+   */
+  void resize(size_t n) {
+    for (size_t d = 0; d < d_dim; d++)
+      d_data[d].resize(n, 0.);
+  }
+
+  /*!
+   * @brief Reserves memory for n vectors
+   *
+   * @param n Number of vectors
+   */
+  void reserve(size_t n) {
+    for (size_t d = 0; d < d_dim; d++)
+      d_data[d].reserve(n);
+  }
+
+  /*! @brief Releases memory reserved beyond the current size */
+  void shrink_to_fit() {
+    for (size_t d = 0; d < d_dim; d++)
+      d_data[d].shrink_to_fit();
+  }
+
+  /*!
+   * @brief Returns memory used by the container in bytes
+   *
+   * @return size Memory in bytes
+   */
+  size_t memorySize() const {
+    size_t n = 0;
+    for (size_t d = 0; d < d_dim; d++)
+      n += d_data[d].capacity() * sizeof(double);
+    return n;
+  }
+
+  /*! @brief Removes all vectors */
+  void clear() {
+    for (size_t d = 0; d < d_dim; d++)
+      d_data[d].clear();
+  }
+
+  /*!
+   * @brief Appends vector to the end of container
+   *
+   * @param p Vector to append
+   */
+  void push_back(const util::Point &p) {
+    for (size_t d = 0; d < d_dim; d++)
+      d_data[d].push_back(p[d]);
+  }
+
+  /*!
+   * @brief Get vector
+   *
+   * @param i Id of vector
+   * @return p Vector
+   */
+  util::Point get(size_t i) const {
+    return {d_data[0][i], d_dim > 1 ? d_data[1][i] : 0.,
+            d_dim > 2 ? d_data[2][i] : 0.};
+  }
+
+  /*!
+   * @brief Set vector
+   *
+   * @param i Id of vector
+   * @param p Vector to set (components beyond dim() are ignored)
+   */
+  void set(size_t i, const util::Point &p) {
+    for (size_t d = 0; d < d_dim; d++)
+      d_data[d][i] = p[d];
+  }
+
+  /*!
+   * @brief Add to vector
+   *
+   * @param i Id of vector
+   * @param p Vector to add (components beyond dim() are ignored)
+   */
+  void add(size_t i, const util::Point &p) {
+    for (size_t d = 0; d < d_dim; d++)
+      d_data[d][i] += p[d];
+  }
+
+  /*!
+   * @brief Set all vectors to given vector
+   *
+   * @param p Vector to set
+   */
+  void fill(const util::Point &p) {
+    for (size_t d = 0; d < d_dim; d++)
+      std::fill(d_data[d].begin(), d_data[d].end(), p[d]);
+  }
+
+  /*!
+   * @brief Get reference to component of vector
+   *
+   * @param i Id of vector
+   * @param dof Component (should be less than dim())
+   * @return value Reference to component
+   */
+  double &operator()(size_t i, size_t dof) {
+    assert(dof < d_dim && "dof should be less than dimension of PointSoA");
+    return d_data[dof][i];
+  }
+
+  /*!
+   * @brief Get component of vector
+   *
+   * @param i Id of vector
+   * @param dof Component
+   * @return value Component (zero if dof is not less than dim())
+   */
+  double operator()(size_t i, size_t dof) const {
+    return dof < d_dim ? d_data[dof][i] : 0.;
+  }
+
+  /*!
+   * @brief Get pointer to contiguous array of a component
+   *
+   * @param dof Component (should be less than dim())
+   * @return pointer Pointer to first element
+   */
+  double *data(size_t dof) { return d_data[dof].data(); }
+
+  /*! @copydoc data(size_t dof) */
+  const double *data(size_t dof) const { return d_data[dof].data(); }
+
+  /*!
+   * @brief Copy vectors into vector of points (useful for functions that
+   * expect std::vector<util::Point>)
+   *
+   * @return points Vector of points
+   */
+  std::vector<util::Point> toVector() const {
+    std::vector<util::Point> points(size());
+    for (size_t i = 0; i < points.size(); i++)
+      points[i] = get(i);
+    return points;
+  }
+
+private:
+  /*! @brief Number of components stored */
+  size_t d_dim;
+
+  /*! @brief Component arrays */
+  std::array<std::vector<double>, max_dim> d_data;
+};
+
+} // namespace util
+
+#endif // UTIL_POINTSOA_H
@@ -1,14 +1,26 @@
 #!/bin/bash
 MY_PWD=$(pwd)
 
+# variants of this test share this directory (see RESOURCE_LOCK in
+# test/CMakeLists.txt), so remove output of previous runs
+rm -rf out out_double
+
+# pass exit status of PeriDEM through tee
+set -o pipefail
+
 (
 if [[ $# -gt 0 ]]; then n_threads="$1"; else n_threads="2"; fi 
 
 cd "inp" && python3 -B problem_setup.py
 
+# optionally move broken peridynamic bonds out of the list of bonds
+if [[ $# -gt 1 && "$2" == "pd_bond_compaction" ]]; then
+  sed -i 's/^Model:/Model:\n  PD_Bond_Compaction_Threshold: 0.001\n  PD_Bond_Compaction_Interval: 10/' input_0.yaml
+fi
+
 peridem="../../../../../bin/PeriDEM"
-$peridem -i input_0.yaml -nThreads $n_threads
-) 2>&1 |  tee output.log
+$peridem -i input_0.yaml -nThreads $n_threads || exit 1
+) 2>&1 |  tee output.log || exit 1
 
 # check if we have produced 'output_10.vtu' file
 cd $MY_PWD
@@ -0,0 +1,108 @@
+"""Compares point data of two vtu files written by PeriDEM.
+
+Usage:
+  python3 compare_vtu.py <vtu file> <reference vtu file> <field>:<tol> ...
+
+For each field, the maximum difference (over nodes and components) between
+the two files is computed and divided by the maximum absolute value of the
+field in the reference file. The script exits with 1 if this relative error
+exceeds the tolerance for any field.
+
+Only the appended, base64 encoded format written by PeriDEM (with or without
+zlib compression) is supported. It does not need vtk python module.
+"""
+import base64
+import struct
+import sys
+import xml.etree.ElementTree as ET
+import zlib
+
+type_fmt = {'Int8': 'b', 'UInt8': 'B', 'Int16': 'h', 'UInt16': 'H',
+            'Int32': 'i', 'UInt32': 'I', 'Int64': 'q', 'UInt64': 'Q',
+            'Float32': 'f', 'Float64': 'd'}
+
+
+def num_base64_chars(num_bytes):
+  return 4 * ((num_bytes + 2) // 3)
+
+
+def read_point_data(filename):
+  """Returns dictionary of point data arrays (flattened) in vtu file"""
+
+  with open(filename, 'rb') as f:
+    content = f.read()
+
+  # appended data is not valid xml so split it from rest of the file
+  i0 = content.find(b'<AppendedData')
+  i1 = content.find(b'_', content.find(b'>', i0)) + 1
+  i2 = content.find(b'</AppendedData>')
+  appended = content[i1:i2].rstrip()
+  root = ET.fromstring(content[:i0] + b'</VTKFile>')
+
+  bo = '<' if root.get('byte_order', 'LittleEndian') == 'LittleEndian' else '>'
+  hfmt = bo + type_fmt[root.get('header_type', 'UInt32')]
+  hsize = struct.calcsize(hfmt)
+  compressed = root.get('compressor') is not None
+
+  data = {}
+  for arr in root.iter('DataArray'):
+    if arr.get('format') != 'appended':
+      continue
+
+    dfmt = bo + type_fmt[arr.get('type')]
+    s = appended[int(arr.get('offset')):]
+    if compressed:
+      # header: number of blocks, block size, last block size, and
+      # compressed size of each block
+      num_blocks = struct.unpack(hfmt, base64.b64decode(
+        s[:num_base64_chars(hsize)])[:hsize])[0]
+      nh = num_base64_chars((3 + num_blocks) * hsize)
+      header = struct.unpack(bo + str(3 + num_blocks) + hfmt[1],
+                             base64.b64decode(s[:nh])[:(3 + num_blocks) * hsize])
+      nc = sum(header[3:])
+      raw = base64.b64decode(s[nh:nh + num_base64_chars(nc)])
+      buf, pos = b'', 0
+      for c in header[3:]:
+        buf += zlib.decompress(raw[pos:pos + c])
+        pos += c
+    else:
+      # header: number of bytes of data
+      nbytes = struct.unpack(hfmt, base64.b64decode(
+        s[:num_base64_chars(hsize)])[:hsize])[0]
+      raw = base64.b64decode(s[:num_base64_chars(hsize + nbytes)])
+      buf = raw[hsize:hsize + nbytes]
+
+    n = len(buf) // struct.calcsize(dfmt)
+    data[arr.get('Name')] = struct.unpack(bo + str(n) + dfmt[1], buf)
+
+  return data
+
+
+if __name__ == "__main__":
+
+  if len(sys.argv) < 4:
+    print(__doc__)
+    sys.exit(1)
+
+  a = read_point_data(sys.argv[1])
+  b = read_point_data(sys.argv[2])
+
+  failed = False
+  for field_tol in sys.argv[3:]:
+    field, tol = field_tol.split(':')
+    if field not in a or field not in b or len(a[field]) != len(b[field]):
+      print('Field {} is missing or has different size in files'.format(field))
+      failed = True
+      continue
+
+    err = max(abs(x - y) for x, y in zip(a[field], b[field]))
+    ref = max(abs(y) for y in b[field])
+    rel_err = err / ref if ref > 0. else err
+    status = 'ok' if rel_err <= float(tol) else 'FAILED'
+    print('Field {}: max error = {}, max reference value = {}, '
+          'relative error = {}, tolerance = {} ({})'.format(
+      field, err, ref, rel_err, tol, status))
+    if rel_err > float(tol):
+      failed = True
+
+  sys.exit(1 if failed else 0)
@@ -1,15 +1,103 @@
 #!/bin/bash
 MY_PWD=$(pwd)
 
+# variants of this test share this directory (see RESOURCE_LOCK in
+# test/CMakeLists.txt), so remove output of previous runs
+rm -rf out out_double
+
+# pass exit status of PeriDEM through tee
+set -o pipefail
+
 (
 if [[ $# -gt 0 ]]; then n_threads="$1"; else n_threads="2"; fi 
 
 cd "inp" && python3 -B problem_setup.py
 
+# optionally run time step as single task graph
+if [[ $# -gt 1 && "$2" == "step_task_graph" ]]; then
+  sed -i 's/^Model:/Model:\n  Step_Task_Graph: true/' input_0.yaml
+fi
+
+# optionally cache reference quantities of peridynamic bonds
+if [[ $# -gt 1 && "$2" == "pd_bond_cache" ]]; then
+  sed -i 's/^Model:/Model:\n  PD_Bond_Cache: true/' input_0.yaml
+fi
+
+# optionally store bond-level quantities in single precision; deck with
+# double precision writing to out_double is also created and used as reference
+rm -f input_0_double.yaml
+if [[ $# -gt 1 && "$2" == "mixed_precision" ]]; then
+  mkdir -p ../out_double
+  sed 's|^  Path: ../out/|  Path: ../out_double/|' input_0.yaml > input_0_double.yaml
+  sed -i 's/^Model:/Model:\n  Mixed_Precision: true/' input_0.yaml
+fi
+
+# optionally renumber nodes of meshes along Hilbert curve
+if [[ $# -gt 1 && "$2" == "node_ordering" ]]; then
+  sed -i 's/^Mesh:/Mesh:\n  Node_Ordering: hilbert/' input_0.yaml
+fi
+
+# optionally put particles at rest to sleep (force threshold is large so
+# that particles at rest initially sleep and are woken by the moving wall)
+if [[ $# -gt 1 && ("$2" == "particle_sleep" || "$2" == "analytic_wall_particle_sleep") ]]; then
+  sed -i 's/^Model:/Model:\n  Sleep_Velocity_Threshold: 1.0e-3\n  Sleep_Force_Threshold: 1.0e+12\n  Sleep_Steps: 20\n  Sleep_Check_Interval: 5/' input_0.yaml
+fi
+
+# optionally compute contact with walls using their geometry instead of
+# wall nodes
+if [[ $# -gt 1 && ("$2" == "analytic_wall" || "$2" == "analytic_wall_particle_sleep") ]]; then
+  sed -i 's/^    Create_Particle_Using_ParticleZone_GeomObject: true/&\n    Analytic_Wall: true/' input_0.yaml
+fi
+
+# optionally use skin-based contact neighborlist
+if [[ $# -gt 1 && "$2" == "contact_skin" ]]; then
+  sed -i 's/^Neighbor:/Neighbor:\n  Skin_Factor: 0.5/' input_0.yaml
+fi
+
+# optionally use only nodes near boundary of particles in contact search
+if [[ $# -gt 1 && "$2" == "contact_boundary_nodes" ]]; then
+  sed -i 's/^Neighbor:/Neighbor:\n  Contact_Boundary_Nodes_Only: true/' input_0.yaml
+fi
+
+# optionally evaluate contact force of each pair of nodes once
+if [[ $# -gt 1 && "$2" == "contact_half_pairs" ]]; then
+  sed -i 's/^Model:/Model:\n  Contact_Half_Pairs: true/' input_0.yaml
+fi
+
+# optionally refit contact search tree instead of rebuilding it
+if [[ $# -gt 1 && "$2" == "tree_refit" ]]; then
+  sed -i 's/^Neighbor:/Neighbor:\n  Tree_Refit: true/' input_0.yaml
+fi
+
+# optionally share peridynamic neighborhoods of particles created from the
+# same reference particle
+if [[ $# -gt 1 && "$2" == "pd_share_neighbors" ]]; then
+  sed -i 's/^Model:/Model:\n  PD_Share_Reference_Neighbors: true/' input_0.yaml
+fi
+
 peridem="../../../../../bin/PeriDEM"
-$peridem -i input_0.yaml -nThreads $n_threads
-) 2>&1 |  tee output.log
+$peridem -i input_0.yaml -nThreads $n_threads || exit 1
+if [[ -f "input_0_double.yaml" ]]; then
+  $peridem -i input_0_double.yaml -nThreads $n_threads || exit 1
+fi
+) 2>&1 |  tee output.log || exit 1
 
 # check if we have produced 'output_10.vtu' file
 cd $MY_PWD
-if [[ -f "out/output_0_10.vtu" ]]; then exit 0; else exit 1; fi
+if [[ ! -f "out/output_0_10.vtu" ]]; then exit 1; fi
+
+# check that sleeping particles are woken by the moving analytic wall (nodes
+# of analytic wall are not in contact neighborlist)
+if [[ $# -gt 1 && "$2" == "analytic_wall_particle_sleep" ]]; then
+  grep -qE "woken = [1-9]" output.log || exit 1
+fi
+
+# compare final displacement and damage of mixed precision run against double
+# precision run (tolerances are estimates and have not been calibrated against
+# observed differences of full runs; compare_vtu.py prints the relative error
+# of each field so that they can be tightened)
+if [[ $# -gt 1 && "$2" == "mixed_precision" ]]; then
+  python3 -B ../compare_vtu.py out/output_0_10.vtu out_double/output_0_10.vtu \
+    Displacement:1.0e-4 Damage_Z:1.0e-2 || exit 1
+fi
+exit 0
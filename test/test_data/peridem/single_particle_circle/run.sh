@@ -1,17 +1,50 @@
 #!/bin/bash
 MY_PWD=$(pwd)
 
+# variants of this test share this directory (see RESOURCE_LOCK in
+# test/CMakeLists.txt), so remove output of previous runs
+rm -rf out out_vtu
+
+# pass exit status of PeriDEM through tee
+set -o pipefail
+
 (
-if [[ $# -gt 0 ]]; then n_threads="$1"; else n_threads="2"; fi 
+if [[ $# -gt 0 ]]; then n_threads="$1"; else n_threads="2"; fi
 
 mkdir -p out
 
-cd "inp" 
+cd "inp"
 
 peridem="../../../../../bin/PeriDEM"
-$peridem -i input_0.yaml -nThreads $n_threads
-) 2>&1 |  tee output.log
+
+# optionally renumber nodes of .vtu mesh (with nodal volume, so element data
+# is not read with nodes) along Hilbert curve and output strain and stress,
+# which need element data; deck without renumbering writing to out_vtu is
+# used as reference
+if [[ $# -gt 1 && "$2" == "node_ordering" ]]; then
+  mkdir -p ../out_vtu
+  sed -e 's/^    File: mesh_cir_1_0.msh/    File: mesh_cir_1_0.vtu/' \
+      -e 's/^  Tags:/  Tags:\n    - Strain_Stress/' \
+      -e 's|^  Path: ../out/|  Path: ../out_vtu/|' \
+      input_0.yaml > input_0_vtu.yaml
+  sed -e 's|^  Path: ../out_vtu/|  Path: ../out/|' \
+      -e 's/^Mesh:/Mesh:\n  Node_Ordering: hilbert/' \
+      input_0_vtu.yaml > input_0_node_ordering.yaml
+  $peridem -i input_0_vtu.yaml -nThreads $n_threads || exit 1
+  $peridem -i input_0_node_ordering.yaml -nThreads $n_threads || exit 1
+else
+  $peridem -i input_0.yaml -nThreads $n_threads || exit 1
+fi
+) 2>&1 |  tee output.log || exit 1
 
 # check if we have produced 'output_10.vtu' file
 cd $MY_PWD
-if [[ -f "out/output_0_10.vtu" ]]; then exit 0; else exit 1; fi
+if [[ ! -f "out/output_0_10.vtu" ]]; then exit 1; fi
+
+# strain and stress at quadrature points (ordered by element, so not
+# affected by renumbering of nodes) must agree with run without renumbering
+if [[ $# -gt 1 && "$2" == "node_ordering" ]]; then
+  python3 -B ../compare_vtu.py out/output_strain_0_10.vtu \
+    out_vtu/output_strain_0_10.vtu Strain:1.0e-6 Stress:1.0e-6 || exit 1
+fi
+exit 0
@@ -1,15 +1,50 @@
 #!/bin/bash
 MY_PWD=$(pwd)
 
+# variants of this test share this directory (see RESOURCE_LOCK in
+# test/CMakeLists.txt), so remove output of previous runs
+rm -rf out out_double
+
+# pass exit status of PeriDEM through tee
+set -o pipefail
+
 (
 if [[ $# -gt 0 ]]; then n_threads="$1"; else n_threads="2"; fi 
 
 cd "inp" && python3 -B problem_setup.py
 
+# optionally store bond-level quantities in single precision; deck with
+# double precision writing to out_double is also created and used as reference
+rm -f input_0_double.yaml
+if [[ $# -gt 1 && "$2" == "mixed_precision" ]]; then
+  mkdir -p ../out_double
+  sed 's|^  Path: ../out/|  Path: ../out_double/|' input_0.yaml > input_0_double.yaml
+  sed -i 's/^Model:/Model:\n  Mixed_Precision: true/' input_0.yaml
+fi
+
+# optionally use bond-based material and store each bond once
+if [[ $# -gt 1 && "$2" == "half_bonds" ]]; then
+  sed -i 's/^    Type: PDState/    Type: PMBBond/' input_0.yaml
+  sed -i 's/^Model:/Model:\n  PD_Half_Bonds: true/' input_0.yaml
+fi
+
 peridem="../../../../../bin/PeriDEM"
-$peridem -i input_0.yaml -nThreads $n_threads
-) 2>&1 |  tee output.log
+$peridem -i input_0.yaml -nThreads $n_threads || exit 1
+if [[ -f "input_0_double.yaml" ]]; then
+  $peridem -i input_0_double.yaml -nThreads $n_threads || exit 1
+fi
+) 2>&1 |  tee output.log || exit 1
 
 # check if we have produced 'output_10.vtu' file
 cd $MY_PWD
-if [[ -f "out/output_0_10.vtu" ]]; then exit 0; else exit 1; fi
+if [[ ! -f "out/output_0_10.vtu" ]]; then exit 1; fi
+
+# compare final displacement and damage of mixed precision run against double
+# precision run (tolerances are estimates and have not been calibrated against
+# observed differences of full runs; compare_vtu.py prints the relative error
+# of each field so that they can be tightened)
+if [[ $# -gt 1 && "$2" == "mixed_precision" ]]; then
+  python3 -B ../compare_vtu.py out/output_0_10.vtu out_double/output_0_10.vtu \
+    Displacement:1.0e-4 Damage_Z:1.0e-2 || exit 1
+fi
+exit 0
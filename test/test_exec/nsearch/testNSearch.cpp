@@ -30,7 +30,7 @@ int main(int argc, char *argv[]) {
     // print help
     std::cout << argv[0] << " (Version " << MAJOR_VERSION << "."
               << MINOR_VERSION << "." << UPDATE_VERSION
-              << ") -i <num-points> -o <select-test; 0 - test with different lattice, 1 - profile nanoflann, 2 - test closest point search>" << std::endl;
+              << ") -i <num-points> -o <select-test; 0 - test with different lattice, 1 - profile nanoflann, 2 - test closest point search, 3 - test search on subset of points, 4 - compare cell list search with nanoflann, 5 - count allocations in search, 6 - compare refitted tree with rebuilt tree, 7 - compare batched search with search point by point>" << std::endl;
     //exit(EXIT_FAILURE);
   }
 
@@ -214,6 +214,136 @@ int main(int argc, char *argv[]) {
       } // loop dL
     } // loop L
   }
+  else if (testSelect == 3) {
+    // test 3
+    std::cout << "\n\nTesting search on subset of points for different lattice sizes\n\n";
+
+    for (auto L: L_test) {
+      for (auto dL: dL_test) {
+        for (auto seed: seeds) {
+          for (auto n: N_test) {
+
+            std::cout << "\n**** Test number = " << test_count++ << " ****\n";
+            std::cout << fmt::format("Test parameters: L = {}, lattice "
+                                     "perturbation = {}, seed = {}, "
+                                     "N = {}\n\n",
+                                     L, dL * L, seed, n);
+
+            std::cout << test::testNanoflannSubset(n, L, dL * L, seed);
+
+          } // loop N
+        } // loop seed
+      } // loop dL
+    } // loop L
+  }
+  else if (testSelect == 4) {
+    // test 4
+    std::cout << "\n\nTesting cell list search against nanoflann for different lattice sizes\n\n";
+
+    for (auto L: L_test) {
+      for (auto dL: dL_test) {
+        for (auto seed: seeds) {
+          for (auto n: N_test) {
+            for (auto dim: dims) {
+
+              std::cout << "\n**** Test number = " << test_count++ << " ****\n";
+              std::cout << fmt::format("Test parameters: L = {}, lattice "
+                                       "perturbation = {}, seed = {}, "
+                                       "N = {}, dim = {}\n\n",
+                                       L, dL * L, seed, n, dim);
+
+              if (dim == 2)
+                std::cout << test::testCellList<2>(n, L, dL * L, seed);
+              else if (dim == 3)
+                std::cout << test::testCellList<3>(n, L, dL * L, seed);
+
+            } // loop dim
+          } // loop N
+        } // loop seed
+      } // loop dL
+    } // loop L
+  }
+  else if (testSelect == 5) {
+    // test 5
+    std::cout << "\n\nTesting heap allocations in search for different lattice sizes\n\n";
+
+    for (auto L: L_test) {
+      for (auto dL: dL_test) {
+        for (auto seed: seeds) {
+          for (auto n: N_test) {
+            for (auto dim: dims) {
+
+              std::cout << "\n**** Test number = " << test_count++ << " ****\n";
+              std::cout << fmt::format("Test parameters: L = {}, lattice "
+                                       "perturbation = {}, seed = {}, "
+                                       "N = {}, dim = {}\n\n",
+                                       L, dL * L, seed, n, dim);
+
+              if (dim == 2)
+                std::cout << test::testSearchAllocations<2>(n, L, dL * L, seed);
+              else if (dim == 3)
+                std::cout << test::testSearchAllocations<3>(n, L, dL * L, seed);
+
+            } // loop dim
+          } // loop N
+        } // loop seed
+      } // loop dL
+    } // loop L
+  }
+  else if (testSelect == 6) {
+    // test 6
+    std::cout << "\n\nTesting refit of nanoflann tree for different lattice sizes\n\n";
+
+    for (auto L: L_test) {
+      for (auto dL: dL_test) {
+        for (auto seed: seeds) {
+          for (auto n: N_test) {
+            for (auto dim: dims) {
+
+              std::cout << "\n**** Test number = " << test_count++ << " ****\n";
+              std::cout << fmt::format("Test parameters: L = {}, lattice "
+                                       "perturbation = {}, seed = {}, "
+                                       "N = {}, dim = {}\n\n",
+                                       L, dL * L, seed, n, dim);
+
+              if (dim == 2)
+                std::cout << test::testTreeRefit<2>(n, L, dL * L, seed);
+              else if (dim == 3)
+                std::cout << test::testTreeRefit<3>(n, L, dL * L, seed);
+
+            } // loop dim
+          } // loop N
+        } // loop seed
+      } // loop dL
+    } // loop L
+  }
+  else if (testSelect == 7) {
+    // test 7
+    std::cout << "\n\nTesting batched search for different lattice sizes\n\n";
+
+    for (auto L: L_test) {
+      for (auto dL: dL_test) {
+        for (auto seed: seeds) {
+          for (auto n: N_test) {
+            for (auto dim: dims) {
+
+              std::cout << "\n**** Test number = " << test_count++ << " ****\n";
+              std::cout << fmt::format("Test parameters: L = {}, lattice "
+                                       "perturbation = {}, seed = {}, "
+                                       "N = {}, dim = {}\n\n",
+                                       L, dL * L, seed, n, dim);
+
+              if (dim == 2)
+                std::cout << test::testSearchBatch<2>(n, L, dL * L, seed);
+              else if (dim == 3)
+                std::cout << test::testSearchBatch<3>(n, L, dL * L, seed);
+
+            } // loop dim
+          } // loop N
+        } // loop seed
+      } // loop dL
+    } // loop L
+  }
 
   return EXIT_SUCCESS;
 }
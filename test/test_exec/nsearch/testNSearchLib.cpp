@@ -10,6 +10,7 @@
 
 #include "testNSearchLib.h"
 #include "nsearch/nsearch.h"
+#include "nsearch/cellListSearch.h"
 #include "util/function.h"
 #include "util/matrix.h"
 #include "util/methods.h"
@@ -17,9 +18,13 @@
 #include "util/randomDist.h"
 #include "util/parallelUtil.h"
 #include <fmt/format.h>
+#include <algorithm>
+#include <atomic>
 #include <bitset>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <new>
 #include <random>
 #include <vector>
 
@@ -28,6 +33,31 @@
 
 namespace {
 
+/*! @brief If true, calls to global operator new are counted (switched on
+ * and off by testSearchAllocations) */
+std::atomic<bool> count_allocations(false);
+
+/*! @brief Number of calls to global operator new while counting is on */
+std::atomic<size_t> num_allocations(0);
+
+} // anonymous namespace
+
+// count heap allocations of this executable when counting is switched on
+// (used in testSearchAllocations)
+void *operator new(std::size_t size) {
+  if (count_allocations.load(std::memory_order_relaxed))
+    num_allocations++;
+  if (void *p = std::malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
 bool isInList(const std::vector<size_t> *list, size_t i) {
   for (auto j : *list)
     if (j == i)
@@ -103,6 +133,26 @@ void assignRandomTags(std::vector<util::Point> &x,
     xTags[i] = dist(gen);
 }
 
+/*!
+ * @brief Creates perturbed lattice of N^dim points, copies the points to
+ * point cloud x, and assigns random tags to the points
+ */
+void setupTaggedLattice(size_t N, double L, double dL, int seed, int dim,
+                        std::vector<util::Point> &x_vec, util::PointSoA &x,
+                        std::vector<size_t> &x_tags) {
+
+  size_t N_tot = dim == 3 ? N * N * N : N * N;
+  x_vec = std::vector<util::Point>(N_tot, util::Point());
+  lattice(L, N, N, N, dL, seed, x_vec, dim);
+
+  for (const auto &p : x_vec)
+    x.push_back(p);
+
+  size_t num_tags = 4;
+  x_tags.resize(N_tot);
+  assignRandomTags(x_vec, num_tags, seed, x_tags);
+}
+
 template <class NSearch>
 double neighSearchTree(const std::vector<util::Point> &x,
                        const std::unique_ptr<NSearch> &nsearch,
@@ -113,7 +163,6 @@ double neighSearchTree(const std::vector<util::Point> &x,
   neigh_sq_dist.resize(x.size());
   auto t1 = steady_clock::now();
 
-  tf::Executor executor(util::parallel::getNThreads());
   tf::Taskflow taskflow;
 
   taskflow.for_each_index((std::size_t) 0, x.size(), (std::size_t) 1, [&x, &neigh, &neigh_sq_dist, &nsearch, r](std::size_t i) {
@@ -131,7 +180,7 @@ double neighSearchTree(const std::vector<util::Point> &x,
     }
   ); // for_each
 
-  executor.run(taskflow).get();
+  util::parallel::getExecutor().run(taskflow).get();
 
   auto t2 = steady_clock::now();
   return util::methods::timeDiff(t1, t2, "microseconds");
@@ -147,7 +196,6 @@ double neighSearchTreeSizet(const std::vector<util::Point> &x,
   neigh_sq_dist.resize(x.size());
   auto t1 = steady_clock::now();
 
-  tf::Executor executor(util::parallel::getNThreads());
   tf::Taskflow taskflow;
 
   taskflow.for_each_index((std::size_t) 0, x.size(), (std::size_t) 1, [&x, &neigh, &neigh_sq_dist, &nsearch, r](std::size_t i) {
@@ -165,7 +213,7 @@ double neighSearchTreeSizet(const std::vector<util::Point> &x,
     }
   ); // for_each
 
-  executor.run(taskflow).get();
+  util::parallel::getExecutor().run(taskflow).get();
 
   auto t2 = steady_clock::now();
   return util::methods::timeDiff(t1, t2, "microseconds");
@@ -187,7 +235,6 @@ double neighSearchTreeSizetExcludeInclude(const std::vector<util::Point> &x,
   neigh_sq_dist.resize(x.size());
   auto t1 = steady_clock::now();
 
-  tf::Executor executor(util::parallel::getNThreads());
   tf::Taskflow taskflow;
 
   taskflow.for_each_index((std::size_t) 0,
@@ -227,7 +274,7 @@ double neighSearchTreeSizetExcludeInclude(const std::vector<util::Point> &x,
       }
   ); // for_each
 
-  executor.run(taskflow).get();
+  util::parallel::getExecutor().run(taskflow).get();
 
   auto t2 = steady_clock::now();
   return util::methods::timeDiff(t1, t2, "microseconds");
@@ -242,7 +289,6 @@ double neighSearchBrute(const std::vector<util::Point> &x, const double &r,
 
   auto t1 = steady_clock::now();
 
-  tf::Executor executor(util::parallel::getNThreads());
   tf::Taskflow taskflow;
 
   taskflow.for_each_index((std::size_t) 0,
@@ -265,7 +311,7 @@ double neighSearchBrute(const std::vector<util::Point> &x, const double &r,
     }
   ); // for_each
 
-  executor.run(taskflow).get();
+  util::parallel::getExecutor().run(taskflow).get();
 
   auto t2 = steady_clock::now();
   return util::methods::timeDiff(t1, t2, "microseconds");
@@ -287,7 +333,6 @@ double neighSearchBruteExcludeInclude(const std::vector<util::Point> &x,
 
   auto t1 = steady_clock::now();
 
-  tf::Executor executor(util::parallel::getNThreads());
   tf::Taskflow taskflow;
 
   taskflow.for_each_index((std::size_t) 0,
@@ -325,7 +370,7 @@ double neighSearchBruteExcludeInclude(const std::vector<util::Point> &x,
     }
   ); // for_each
 
-  executor.run(taskflow).get();
+  util::parallel::getExecutor().run(taskflow).get();
 
   auto t2 = steady_clock::now();
   return util::methods::timeDiff(t1, t2, "microseconds");
@@ -366,7 +411,6 @@ double neighSearchTreeClosestPointSizet(const std::vector<util::Point> &x,
 
   auto t1 = steady_clock::now();
 
-  tf::Executor executor(util::parallel::getNThreads());
   tf::Taskflow taskflow;
 
   taskflow.for_each_index((std::size_t) 0, x.size(), (std::size_t) 1, [&x,
@@ -399,7 +443,7 @@ double neighSearchTreeClosestPointSizet(const std::vector<util::Point> &x,
     }
   ); // for_each
 
-  executor.run(taskflow).get();
+  util::parallel::getExecutor().run(taskflow).get();
 
   auto t2 = steady_clock::now();
   return util::methods::timeDiff(t1, t2, "microseconds");
@@ -822,6 +866,483 @@ std::string test::testNanoflannClosestPoint(size_t N, double L, double dL, int s
 
 }
 
+std::string test::testNanoflannSubset(size_t N, double L, double dL, int seed) {
+
+  std::vector<util::Point> x_vec;
+  util::PointSoA x(3);
+  std::vector<size_t> x_tags;
+  setupTaggedLattice(N, L, dL, seed, 3, x_vec, x, x_tags);
+  const size_t N_tot = x_vec.size();
+
+  // subset (leave out every third point)
+  std::vector<size_t> ids;
+  for (size_t i = 0; i < N_tot; i++)
+    if (i % 3 != 0)
+      ids.push_back(i);
+
+  auto full_nsearch =
+          std::make_unique<nsearch::NFlannSearchKd<3, util::PointSoA>>(x, 0);
+  auto cloud = nsearch::PointCloudSubset(x, ids);
+  auto subset_nsearch = std::make_unique<
+          nsearch::NFlannSearchKd<3, nsearch::PointCloudSubset>>(cloud, 0);
+
+  full_nsearch->setInputCloud();
+  auto subset_tree_set_time = subset_nsearch->setInputCloud();
+
+  double search_r = 1.5 * L;
+  size_t err_search = 0, err_closest = 0, num_neighs = 0;
+  for (size_t i = 0; i < N_tot; i++) {
+
+    std::vector<size_t> neighs_full, neighs_subset;
+    std::vector<double> sqr_dist_full, sqr_dist_subset;
+
+    full_nsearch->radiusSearchExcludeTag(x.get(i), search_r, neighs_full,
+                                         sqr_dist_full, x_tags[i], x_tags);
+    subset_nsearch->radiusSearchExcludeTag(x.get(i), search_r, neighs_subset,
+                                           sqr_dist_subset, x_tags[i], x_tags);
+
+    // results from full tree restricted to subset
+    std::vector<size_t> neighs_expected;
+    for (auto j : neighs_full)
+      if (j % 3 != 0)
+        neighs_expected.push_back(j);
+
+    std::sort(neighs_expected.begin(), neighs_expected.end());
+    std::sort(neighs_subset.begin(), neighs_subset.end());
+    if (neighs_expected != neighs_subset)
+      err_search++;
+    num_neighs += neighs_subset.size();
+
+    // closest point should be in subset
+    size_t j_closest;
+    double sqr_dist_closest;
+    subset_nsearch->closestPoint(x.get(i), j_closest, sqr_dist_closest);
+    if (j_closest % 3 == 0 or
+        !util::isLess(std::abs((x.get(j_closest) - x.get(i)).lengthSq() -
+                               sqr_dist_closest), 1.0e-10))
+      err_closest++;
+  }
+
+  std::ostringstream msg;
+  msg << fmt::format("  Setup times (microseconds): \n"
+                     "    subset_tree_set_time = {}\n"
+                     "  Comparison results: \n"
+                     "    total points = {}, subset points = {}, "
+                     "neighbors found = {}\n"
+                     "    points with mismatched neighbors = {}, "
+                     "points with wrong closest point = {}\n",
+                     subset_tree_set_time, N_tot, ids.size(), num_neighs,
+                     err_search, err_closest);
+
+  if (err_search > 0 or err_closest > 0) {
+    std::cerr << msg.str() << "Error: Search on subset of points failed.\n";
+    exit(EXIT_FAILURE);
+  }
+
+  return msg.str();
+}
+
+template <int dim>
+std::string test::testCellList(size_t N, double L, double dL, int seed) {
+
+  std::vector<util::Point> x_vec;
+  util::PointSoA x(dim);
+  std::vector<size_t> x_tags;
+  setupTaggedLattice(N, L, dL, seed, dim, x_vec, x, x_tags);
+  const size_t N_tot = x_vec.size();
+
+  double search_r = 1.5 * L;
+
+  auto nflann_nsearch =
+          std::make_unique<nsearch::NFlannSearchKd<3, util::PointSoA>>(x, 0);
+  auto cell_nsearch =
+          std::make_unique<nsearch::CellListSearch<dim, util::PointSoA>>(x, 0);
+  cell_nsearch->setSearchRadius(search_r);
+
+  auto nflann_set_time = nflann_nsearch->setInputCloud();
+  auto cell_set_time = cell_nsearch->setInputCloud();
+
+  // search using both methods and time it
+  auto search = [&x, &x_tags, search_r, N_tot](nsearch::BaseNSearch *nsearch,
+          std::vector<std::vector<size_t>> &neighs_def,
+          std::vector<std::vector<size_t>> &neighs_exc,
+          std::vector<std::vector<size_t>> &neighs_inc) {
+    neighs_def.resize(N_tot);
+    neighs_exc.resize(N_tot);
+    neighs_inc.resize(N_tot);
+
+    auto t1 = steady_clock::now();
+    std::vector<double> sqr_dist;
+    for (size_t i = 0; i < N_tot; i++) {
+      nsearch->radiusSearch(x.get(i), search_r, neighs_def[i], sqr_dist);
+      nsearch->radiusSearchExcludeTag(x.get(i), search_r, neighs_exc[i],
+                                      sqr_dist, x_tags[i], x_tags);
+      nsearch->radiusSearchIncludeTag(x.get(i), search_r, neighs_inc[i],
+                                      sqr_dist, x_tags[i], x_tags);
+      std::sort(neighs_def[i].begin(), neighs_def[i].end());
+      std::sort(neighs_exc[i].begin(), neighs_exc[i].end());
+      std::sort(neighs_inc[i].begin(), neighs_inc[i].end());
+    }
+    return util::methods::timeDiff(t1, steady_clock::now());
+  };
+
+  std::vector<std::vector<size_t>> nflann_def, nflann_exc, nflann_inc;
+  std::vector<std::vector<size_t>> cell_def, cell_exc, cell_inc;
+  auto nflann_search_time = search(nflann_nsearch.get(), nflann_def,
+                                   nflann_exc, nflann_inc);
+  auto cell_search_time = search(cell_nsearch.get(), cell_def, cell_exc,
+                                 cell_inc);
+
+  size_t err_search = 0, err_closest = 0, num_neighs = 0;
+  for (size_t i = 0; i < N_tot; i++) {
+    if (nflann_def[i] != cell_def[i] or nflann_exc[i] != cell_exc[i] or
+        nflann_inc[i] != cell_inc[i])
+      err_search++;
+    num_neighs += cell_def[i].size();
+
+    // closest point to point shifted from lattice point
+    auto xi = x.get(i) + util::Point(0.3 * L, 0.2 * L, dim == 3 ? 0.1 * L : 0.);
+    size_t j_nflann, j_cell;
+    double sqr_dist_nflann, sqr_dist_cell;
+    nflann_nsearch->closestPoint(xi, j_nflann, sqr_dist_nflann);
+    cell_nsearch->closestPoint(xi, j_cell, sqr_dist_cell);
+    if (!util::isLess(std::abs(sqr_dist_nflann - sqr_dist_cell), 1.0e-10))
+      err_closest++;
+  }
+
+  // move points randomly and update cell list using updatePointCloud()
+  RandGenerator gen(util::get_rd_gen(seed));
+  UniformDistribution dist(-0.5 * L, 0.5 * L);
+  for (size_t i = 0; i < N_tot; i++) {
+    x_vec[i] += util::Point(dist(gen), dist(gen), dim == 3 ? dist(gen) : 0.);
+    x.set(i, x_vec[i]);
+  }
+
+  nflann_nsearch->setInputCloud();
+  auto cell_update_time = cell_nsearch->updatePointCloud(x_vec);
+  search(nflann_nsearch.get(), nflann_def, nflann_exc, nflann_inc);
+  search(cell_nsearch.get(), cell_def, cell_exc, cell_inc);
+
+  size_t err_update = 0;
+  for (size_t i = 0; i < N_tot; i++)
+    if (nflann_def[i] != cell_def[i] or nflann_exc[i] != cell_exc[i] or
+        nflann_inc[i] != cell_inc[i])
+      err_update++;
+
+  std::ostringstream msg;
+  msg << fmt::format("  Setup times (microseconds): \n"
+                     "    nflann_tree_set_time = {}, cell_list_set_time = {}\n"
+                     "    cell_list_update_time = {}\n"
+                     "  Search times (microseconds): \n"
+                     "    nflann_search_time = {}, cell_list_search_time = {}\n"
+                     "  Comparison results: \n"
+                     "    total points = {}, neighbors found = {}\n"
+                     "    points with mismatched neighbors = {}, "
+                     "points with wrong closest point = {}\n"
+                     "    points with mismatched neighbors after update = {}\n",
+                     nflann_set_time, cell_set_time, cell_update_time,
+                     nflann_search_time, cell_search_time,
+                     N_tot, num_neighs, err_search, err_closest, err_update);
+
+  if (err_search > 0 or err_closest > 0 or err_update > 0) {
+    std::cerr << msg.str() << "Error: Cell list search does not match "
+                              "nanoflann search.\n";
+    exit(EXIT_FAILURE);
+  }
+
+  return msg.str();
+}
+
+template <int dim>
+std::string test::testSearchAllocations(size_t N, double L, double dL,
+                                        int seed) {
+
+  std::vector<util::Point> x_vec;
+  util::PointSoA x(dim);
+  std::vector<size_t> x_tags;
+  setupTaggedLattice(N, L, dL, seed, dim, x_vec, x, x_tags);
+  const size_t N_tot = x_vec.size();
+
+  double search_r = 1.5 * L;
+
+  auto nflann_nsearch =
+          std::make_unique<nsearch::NFlannSearchKd<dim, util::PointSoA>>(x, 0);
+  auto cell_nsearch =
+          std::make_unique<nsearch::CellListSearch<dim, util::PointSoA>>(x, 0);
+  cell_nsearch->setSearchRadius(search_r);
+  nflann_nsearch->setInputCloud();
+  cell_nsearch->setInputCloud();
+
+  // allocations in searches of all points with results in fresh vectors
+  auto search_fresh = [&x, &x_tags, search_r, N_tot](
+          nsearch::BaseNSearch *nsearch) {
+    auto n0 = num_allocations.load();
+    for (size_t i = 0; i < N_tot; i++) {
+      std::vector<size_t> neighs;
+      std::vector<double> sqr_dist;
+      nsearch->radiusSearchExcludeTag(x.get(i), search_r, neighs, sqr_dist,
+                                      x_tags[i], x_tags);
+    }
+    return num_allocations.load() - n0;
+  };
+
+  // allocations in searches of all points with results in reused buffers
+  // (size_t/double and int/float versions); first pass grows the buffers
+  auto search_reuse = [&x, &x_tags, search_r, N_tot](
+          nsearch::BaseNSearch *nsearch) {
+    auto &buffer = nsearch::getThreadSearchBuffer();
+    std::vector<int> neighs_int;
+    std::vector<float> sqr_dist_float;
+    size_t n = 0;
+    for (size_t pass = 0; pass < 2; pass++) {
+      auto n0 = num_allocations.load();
+      for (size_t i = 0; i < N_tot; i++) {
+        nsearch->radiusSearch(x.get(i), search_r, buffer.d_neighs,
+                              buffer.d_sqrDist);
+        nsearch->radiusSearchExcludeTag(x.get(i), search_r, buffer.d_neighs,
+                                        buffer.d_sqrDist, x_tags[i], x_tags);
+        nsearch->radiusSearchIncludeTag(x.get(i), search_r, buffer.d_neighs,
+                                        buffer.d_sqrDist, x_tags[i], x_tags);
+        nsearch->radiusSearchExcludeTag(x.get(i), search_r, neighs_int,
+                                        sqr_dist_float, x_tags[i], x_tags);
+        size_t j;
+        double sqr_dist_j;
+        nsearch->closestPoint(x.get(i), j, sqr_dist_j);
+      }
+      n = num_allocations.load() - n0;
+    }
+    return n;
+  };
+
+  count_allocations = true;
+  auto nflann_fresh = search_fresh(nflann_nsearch.get());
+  auto cell_fresh = search_fresh(cell_nsearch.get());
+  auto nflann_reuse = search_reuse(nflann_nsearch.get());
+  auto cell_reuse = search_reuse(cell_nsearch.get());
+  count_allocations = false;
+
+  std::ostringstream msg;
+  msg << fmt::format("  Heap allocations in {} searches: \n"
+                     "    fresh vectors: nflann = {}, cell_list = {}\n"
+                     "    reused buffers: nflann = {}, cell_list = {}\n",
+                     N_tot, nflann_fresh, cell_fresh, nflann_reuse,
+                     cell_reuse);
+
+  if (nflann_reuse > 0 or cell_reuse > 0) {
+    std::cerr << msg.str() << "Error: Search with reused buffers allocates "
+                              "memory.\n";
+    exit(EXIT_FAILURE);
+  }
+
+  return msg.str();
+}
+
+template <int dim>
+std::string test::testTreeRefit(size_t N, double L, double dL, int seed) {
+
+  std::vector<util::Point> x_vec;
+  util::PointSoA x(dim);
+  std::vector<size_t> x_tags;
+  setupTaggedLattice(N, L, dL, seed, dim, x_vec, x, x_tags);
+  const size_t N_tot = x_vec.size();
+
+  double search_r = 1.5 * L;
+
+  // tree that is refitted is built using multiple threads
+  auto refit_nsearch = std::make_unique<
+          nsearch::NFlannSearchKd<dim, util::PointSoA>>(x, 0, 10, 4);
+  auto build_nsearch =
+          std::make_unique<nsearch::NFlannSearchKd<dim, util::PointSoA>>(x, 0);
+  auto refit_build_time = refit_nsearch->setInputCloud();
+
+  auto search = [&x, &x_tags, search_r, N_tot](nsearch::BaseNSearch *nsearch,
+          std::vector<std::vector<size_t>> &neighs) {
+    neighs.resize(N_tot);
+    std::vector<double> sqr_dist;
+    for (size_t i = 0; i < N_tot; i++) {
+      nsearch->radiusSearchExcludeTag(x.get(i), search_r, neighs[i], sqr_dist,
+                                      x_tags[i], x_tags);
+      std::sort(neighs[i].begin(), neighs[i].end());
+    }
+  };
+
+  RandGenerator gen(util::get_rd_gen(seed));
+  UniformDistribution dist(-0.02 * L, 0.02 * L);
+
+  size_t num_steps = 10, num_refits = 0, num_rebuilds = 0, err_search = 0;
+  double refit_time = 0., build_time = 0.;
+  bool reflect_rebuilt = false;
+  for (size_t step = 0; step <= num_steps; step++) {
+
+    // small random displacement in each step and reflection in last step
+    for (size_t i = 0; i < N_tot; i++) {
+      auto xi = x.get(i);
+      if (step < num_steps)
+        xi += util::Point(dist(gen), dist(gen), dim == 3 ? dist(gen) : 0.);
+      else
+        xi.d_x = -xi.d_x;
+      x.set(i, xi);
+    }
+
+    bool rebuilt = false;
+    refit_time += refit_nsearch->refitInputCloud(rebuilt);
+    build_time += build_nsearch->setInputCloud();
+    if (rebuilt)
+      num_rebuilds++;
+    else
+      num_refits++;
+    if (step == num_steps)
+      reflect_rebuilt = rebuilt;
+
+    std::vector<std::vector<size_t>> neighs_refit, neighs_build;
+    search(refit_nsearch.get(), neighs_refit);
+    search(build_nsearch.get(), neighs_build);
+    for (size_t i = 0; i < N_tot; i++)
+      if (neighs_refit[i] != neighs_build[i])
+        err_search++;
+  }
+
+  std::ostringstream msg;
+  msg << fmt::format("  Setup times (microseconds): \n"
+                     "    threaded_build_time = {}\n"
+                     "    refit_time = {}, build_time = {}\n"
+                     "  Comparison results: \n"
+                     "    total points = {}, refits = {}, rebuilds = {}\n"
+                     "    mismatched neighbors = {}, "
+                     "rebuilt after reflection = {}\n",
+                     refit_build_time, refit_time, build_time, N_tot,
+                     num_refits, num_rebuilds, err_search, reflect_rebuilt);
+
+  if (err_search > 0 or !reflect_rebuilt) {
+    std::cerr << msg.str() << "Error: Search on refitted tree does not match "
+                              "search on rebuilt tree.\n";
+    exit(EXIT_FAILURE);
+  }
+
+  return msg.str();
+}
+
+template <int dim>
+std::string test::testSearchBatch(size_t N, double L, double dL, int seed) {
+
+  std::vector<util::Point> x_vec;
+  util::PointSoA x(dim);
+  std::vector<size_t> x_tags;
+  setupTaggedLattice(N, L, dL, seed, dim, x_vec, x, x_tags);
+  const size_t N_tot = x_vec.size();
+
+  // search radius varies between points
+  RandGenerator gen(util::get_rd_gen(seed));
+  UniformDistribution dist(1.0 * L, 2.0 * L);
+  std::vector<double> search_r(N_tot);
+  for (auto &r : search_r)
+    r = dist(gen);
+
+  // morton order should be a permutation
+  auto order = nsearch::getMortonOrder(x_vec);
+  std::sort(order.begin(), order.end());
+  size_t err_order = 0;
+  for (size_t i = 0; i < N_tot; i++)
+    if (order[i] != i)
+      err_order++;
+
+  auto nflann_nsearch =
+          std::make_unique<nsearch::NFlannSearchKd<dim, util::PointSoA>>(x, 0);
+  auto cell_nsearch =
+          std::make_unique<nsearch::CellListSearch<dim, util::PointSoA>>(x, 0);
+  cell_nsearch->setSearchRadius(2.0 * L);
+  nflann_nsearch->setInputCloud();
+  cell_nsearch->setInputCloud();
+
+  // compare batch with search point by point for given filter
+  double batch_time = 0., single_time = 0.;
+  size_t num_neighs = 0;
+  auto compare = [&](nsearch::BaseNSearch *nsearch,
+                     nsearch::SearchTagFilter filter) {
+    std::vector<std::vector<size_t>> neighs_batch(N_tot), neighs_single(N_tot);
+
+    auto t1 = steady_clock::now();
+    nsearch->radiusSearchBatch(
+            x_vec, search_r,
+            [&neighs_batch](size_t q, const nsearch::SearchBuffer &buffer) {
+              neighs_batch[q] = buffer.d_neighs;
+            },
+            filter, x_tags, x_tags);
+    batch_time += util::methods::timeDiff(t1, steady_clock::now());
+
+    t1 = steady_clock::now();
+    std::vector<double> sqr_dist;
+    for (size_t i = 0; i < N_tot; i++) {
+      if (filter == nsearch::SearchTagFilter::exclude)
+        nsearch->radiusSearchExcludeTag(x_vec[i], search_r[i],
+                                        neighs_single[i], sqr_dist,
+                                        x_tags[i], x_tags);
+      else if (filter == nsearch::SearchTagFilter::include)
+        nsearch->radiusSearchIncludeTag(x_vec[i], search_r[i],
+                                        neighs_single[i], sqr_dist,
+                                        x_tags[i], x_tags);
+      else
+        nsearch->radiusSearch(x_vec[i], search_r[i], neighs_single[i],
+                              sqr_dist);
+    }
+    single_time += util::methods::timeDiff(t1, steady_clock::now());
+
+    size_t err = 0;
+    for (size_t i = 0; i < N_tot; i++) {
+      std::sort(neighs_batch[i].begin(), neighs_batch[i].end());
+      std::sort(neighs_single[i].begin(), neighs_single[i].end());
+      if (neighs_batch[i] != neighs_single[i])
+        err++;
+      num_neighs += neighs_batch[i].size();
+    }
+
+    return err;
+  };
+
+  size_t err_search = 0;
+  for (auto filter : {nsearch::SearchTagFilter::none,
+                      nsearch::SearchTagFilter::exclude,
+                      nsearch::SearchTagFilter::include}) {
+    err_search += compare(nflann_nsearch.get(), filter);
+    err_search += compare(cell_nsearch.get(), filter);
+  }
+
+  std::ostringstream msg;
+  msg << fmt::format("  Search times (microseconds): \n"
+                     "    batch_search_time = {}, single_search_time = {}\n"
+                     "  Comparison results: \n"
+                     "    total points = {}, neighbors found = {}\n"
+                     "    mismatched neighbors = {}, "
+                     "errors in morton order = {}\n",
+                     batch_time, single_time, N_tot, num_neighs, err_search,
+                     err_order);
+
+  if (err_search > 0 or err_order > 0) {
+    std::cerr << msg.str() << "Error: Batched search does not match search "
+                              "point by point.\n";
+    exit(EXIT_FAILURE);
+  }
+
+  return msg.str();
+}
+
+template std::string test::testSearchBatch<2>(size_t N, double L, double dL,
+                                              int seed);
+template std::string test::testSearchBatch<3>(size_t N, double L, double dL,
+                                              int seed);
+
+template std::string test::testTreeRefit<2>(size_t N, double L, double dL,
+                                            int seed);
+template std::string test::testTreeRefit<3>(size_t N, double L, double dL,
+                                            int seed);
+
+template std::string test::testSearchAllocations<2>(size_t N, double L,
+                                                    double dL, int seed);
+template std::string test::testSearchAllocations<3>(size_t N, double L,
+                                                    double dL, int seed);
+
+template std::string test::testCellList<2>(size_t N, double L, double dL, int seed);
+template std::string test::testCellList<3>(size_t N, double L, double dL, int seed);
 
 template std::string test::testNanoflann<2>(size_t N, double L, double dL, int seed);
 template std::string test::testNanoflann<3>(size_t N, double L, double dL, int seed);
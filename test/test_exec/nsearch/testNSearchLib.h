@@ -67,6 +67,70 @@ std::string testNanoflannExcludeInclude(size_t N, double L,
  */
 std::string testNanoflannClosestPoint(size_t N, double L, double dL, int seed);
 
+/*!
+ * @brief Compares search on tree built on subset of points (see
+ * nsearch::PointCloudSubset) with search on tree built on all points
+ * @param N size of particle cloud in each dimension. total size would be N^3
+ * @param L Size of unit cell to create crystal lattice point cloud
+ * @param dL Perturbation of lattice sites
+ * @param seed Seed
+ * @return str String containing various information
+ */
+std::string testNanoflannSubset(size_t N, double L, double dL, int seed);
+
+/*!
+ * @brief Compares search using nsearch::CellListSearch with search using
+ * nanoflann tree and reports setup and search times of both
+ * @param N size of particle cloud in each dimension. total size would be N^dim
+ * @param L Size of unit cell to create crystal lattice point cloud
+ * @param dL Perturbation of lattice sites
+ * @param seed Seed
+ * @return str String containing various information
+ */
+template <int dim = 3>
+std::string testCellList(size_t N, double L, double dL, int seed);
+
+/*!
+ * @brief Counts heap allocations in radius searches of nanoflann tree and
+ * cell list when results are written in fresh vectors and when they are
+ * written in reused buffer (see nsearch::SearchBuffer). Test fails if
+ * searches with reused buffer allocate.
+ * @param N size of particle cloud in each dimension. total size would be N^dim
+ * @param L Size of unit cell to create crystal lattice point cloud
+ * @param dL Perturbation of lattice sites
+ * @param seed Seed
+ * @return str String containing various information
+ */
+template <int dim = 3>
+std::string testSearchAllocations(size_t N, double L, double dL, int seed);
+
+/*!
+ * @brief Moves points of lattice in small steps and compares search on
+ * refitted nanoflann tree (see nsearch::NFlannSearchKd::refitInputCloud)
+ * with search on tree built from scratch. Last step reflects the points,
+ * which must trigger rebuild of tree.
+ * @param N size of particle cloud in each dimension. total size would be N^dim
+ * @param L Size of unit cell to create crystal lattice point cloud
+ * @param dL Perturbation of lattice sites
+ * @param seed Seed
+ * @return str String containing various information
+ */
+template <int dim = 3>
+std::string testTreeRefit(size_t N, double L, double dL, int seed);
+
+/*!
+ * @brief Compares batched radius search (see
+ * nsearch::BaseNSearch::radiusSearchBatch) with search point by point for
+ * nanoflann and cell list, with and without tag filters
+ * @param N size of particle cloud in each dimension. total size would be N^dim
+ * @param L Size of unit cell to create crystal lattice point cloud
+ * @param dL Perturbation of lattice sites
+ * @param seed Seed
+ * @return str String containing various information
+ */
+template <int dim = 3>
+std::string testSearchBatch(size_t N, double L, double dL, int seed);
+
 } // namespace test
 
 #endif // TEST_NSEARCH_LIB_H
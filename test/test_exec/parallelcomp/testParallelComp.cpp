@@ -33,13 +33,22 @@ int main(int argc, char *argv[]) {
     // print help
     std::cout << argv[0] << " (Version " << MAJOR_VERSION << "."
               << MINOR_VERSION << "." << UPDATE_VERSION
-              << ") -o <test-option; 0 - taskflow, 1 - parallel on in-built mesh, 2 - user-defined mesh>"
-                  " -i <vector-size> -n <grid-size>"
+              << ") -o <test-option; 0 - taskflow, 1 - parallel on in-built mesh, 2 - user-defined mesh, 3 - taskflow executor reuse, 4 - SIMD bond kernel, 5 - mixed-precision bond kernel, 6 - node ordering>"
+                  " -i <vector-size> -l <number-of-loops> -n <grid-size>"
                   " -m <horizon-integer-factor>"
                   " -nThreads <number of threads to be used in taskflow>" << std::endl;
     std::cout << "To test taskflow, run\n";
     std::cout << argv[0] << " -o 0 -i 10000"
                             " -nThreads <number of threads to be used in taskflow>\n";
+    std::cout << "To profile overhead of creating taskflow executor in every parallel loop, run\n";
+    std::cout << argv[0] << " -o 3 -i 10000 -l 1000"
+                            " -nThreads <number of threads to be used in taskflow>\n";
+    std::cout << "To profile SIMD bond-based force kernel against scalar kernel, run\n";
+    std::cout << argv[0] << " -o 4 -n 200 -m 2 -l 10\n";
+    std::cout << "To compare bond-based force kernel using single and double precision bond cache, run\n";
+    std::cout << argv[0] << " -o 5 -n 200 -m 2 -l 10\n";
+    std::cout << "To profile bond-based force kernel for random and space-filling curve order of nodes, run\n";
+    std::cout << argv[0] << " -o 6 -n 200 -m 2 -l 10\n";
     std::cout << "To test parallel using in-built mesh, run\n";
     std::cout << argv[0] << " -o 1 -m 4 -n 50\n";
     std::cout << "To test parallel on user-provided mesh (filename = filepath/meshfile.vtu)" << std::endl;
@@ -83,6 +92,86 @@ int main(int argc, char *argv[]) {
       auto msg = test::testTaskflow(n, seed);
       util::io::print(msg);
     }
+  } else if (testOption == 3) {
+    util::io::print("\nTesting taskflow executor reuse\n\n");
+
+    size_t nTaskflow;
+    if (input.cmdOptionExists("-i")) nTaskflow = std::stoi(input.getCmdOption("-i"));
+    else {
+      nTaskflow = 10000;
+      util::io::print(fmt::format("Running test with default vector-size = {}\n", nTaskflow));
+    }
+
+    size_t nLoops;
+    if (input.cmdOptionExists("-l")) nLoops = std::stoi(input.getCmdOption("-l"));
+    else {
+      nLoops = 1000;
+      util::io::print(fmt::format("Running test with default number of loops = {}\n", nLoops));
+    }
+
+    unsigned int nThreads;
+    if (input.cmdOptionExists("-nThreads")) nThreads = std::stoi(input.getCmdOption("-nThreads"));
+    else {
+      nThreads = std::thread::hardware_concurrency();
+      util::io::print(fmt::format("Running test with default number of threads = {}\n", nThreads));
+    }
+    // set number of threads
+    util::parallel::initNThreads(nThreads);
+    util::io::print(fmt::format("Number of threads = {}\n", util::parallel::getNThreads()));
+
+    std::vector<size_t> N_test = {size_t(nTaskflow/100), size_t(nTaskflow/10), nTaskflow};
+    int seed = 0;
+    size_t test_count = 0;
+    for (auto n : N_test) {
+      util::io::print(fmt::format("**** Test number = {} ****\n"
+                                  "Test parameters: N = {}, number of loops = {}\n\n",
+                                  test_count++, n, nLoops));
+      auto msg = test::testTaskflowExecutorReuse(n, nLoops, seed);
+      util::io::print(msg);
+    }
+  } else if (testOption == 4 or testOption == 5 or testOption == 6) {
+    if (testOption == 4)
+      util::io::print("\nTesting SIMD bond-based force kernel\n\n");
+    else if (testOption == 5)
+      util::io::print("\nTesting mixed-precision bond-based force kernel\n\n");
+    else
+      util::io::print("\nTesting node ordering for bond-based force kernel\n\n");
+
+    size_t nGrid;
+    if (input.cmdOptionExists("-n")) nGrid = std::stoi(input.getCmdOption("-n"));
+    else {
+      nGrid = 200;
+      util::io::print(fmt::format("Running test with default grid size = {}\n", nGrid));
+    }
+
+    size_t mHorizon;
+    if (input.cmdOptionExists("-m")) mHorizon = std::stoi(input.getCmdOption("-m"));
+    else {
+      mHorizon = 2;
+      util::io::print(fmt::format("Running test with default integer factor for horizon = {}\n", mHorizon));
+    }
+
+    size_t nLoops;
+    if (input.cmdOptionExists("-l")) nLoops = std::stoi(input.getCmdOption("-l"));
+    else {
+      nLoops = 10;
+      util::io::print(fmt::format("Running test with default number of loops = {}\n", nLoops));
+    }
+
+    int seed = 0;
+    for (auto m : {mHorizon, 2 * mHorizon}) {
+      util::io::print(fmt::format("**** Test parameters: N = {}, m = {}, "
+                                  "number of loops = {} ****\n\n",
+                                  nGrid, m, nLoops));
+      std::string msg;
+      if (testOption == 4)
+        msg = test::testSimdBondKernel(nGrid, m, nLoops, seed);
+      else if (testOption == 5)
+        msg = test::testMixedPrecisionBondKernel(nGrid, m, nLoops, seed);
+      else
+        msg = test::testNodeOrdering(nGrid, m, nLoops, seed);
+      util::io::print(msg);
+    }
   } else if (testOption == 1 or testOption == 2) {
 
     util::io::print("\nTesting MPI parallelization\n\n");
@@ -9,19 +9,26 @@
  */
 
 #include "testParallelCompLib.h"
+#include "util/function.h"
 #include "util/methods.h"
 #include "util/randomDist.h"
 #include "util/point.h"
 #include "util/methods.h" // declares std::chrono and defines timeDiff()
 #include "util/io.h"
+#include "util/parallelUtil.h"
 #include "fe/mesh.h"
 #include "fe/meshPartitioning.h"
 #include "fe/meshUtil.h"
+#include "geometry/bondList.h"
 #include "geometry/geometryUtil.h"
+#include "material/mparticle/influenceFn.h"
+#include "material/pdSimdKernel.h"
+#include "util/pointSoA.h"
 #include <mpi.h>
 #include <fmt/format.h>
 #include <fstream>
 #include <iostream>
+#include <numeric>
 #include <random>
 #include <vector>
 
@@ -216,6 +223,80 @@ namespace {
       }
     } // loop over j_proc
   } // exchangeDispData()
+  /*!
+   * @brief Creates uniform 2d grid with mesh size and horizon of particles in
+   * compression_large_set test, randomly perturbed displacement, and bonds of
+   * which some are broken
+   */
+  void setupBondTestGrid(size_t nGrid, size_t mHorizon, int seed, double &h,
+                         double &horizon, util::PointSoA &x, util::PointSoA &u,
+                         std::vector<double> &vol, geometry::BondList &bonds) {
+
+    h = 2.e-4;
+    horizon = double(mHorizon) * h;
+    const size_t n = nGrid * nGrid;
+
+    auto dist = util::DistributionSample<UniformDistribution>(-1., 1., seed);
+
+    vol = std::vector<double>(n, h * h);
+    for (size_t j = 0; j < nGrid; j++)
+      for (size_t i = 0; i < nGrid; i++) {
+        x.push_back(util::Point(double(i) * h, double(j) * h, 0.));
+        u.push_back(util::Point(dist(), dist(), 0.) * 1.e-3 * h);
+      }
+
+    // neighborlist
+    std::vector<std::vector<size_t>> neighs(n);
+    const int m = int(mHorizon);
+    for (int j = 0; j < int(nGrid); j++)
+      for (int i = 0; i < int(nGrid); i++)
+        for (int dj = -m; dj <= m; dj++)
+          for (int di = -m; di <= m; di++) {
+            if ((di == 0 and dj == 0) or i + di < 0 or j + dj < 0 or
+                i + di >= int(nGrid) or j + dj >= int(nGrid) or
+                util::isGreater(double(di * di + dj * dj) * h * h,
+                                horizon * horizon))
+              continue;
+            neighs[j * nGrid + i].push_back((j + dj) * nGrid + i + di);
+          }
+
+    bonds.build(neighs);
+
+    // break some of the bonds so that contact of broken bonds is also tested
+    for (size_t b = 0; b < bonds.numBonds(); b++)
+      if (dist() > 0.9)
+        bonds.setBondState(b, true);
+  }
+
+  /*!
+   * @brief Sets mesh, material, and contact data of bond kernel node used in
+   * bond kernel tests; bond cache pointers are set to null
+   */
+  template <typename T>
+  void setupBondTestNode(material::LinearBondForceNode<T> &node, size_t dim,
+                         util::PointSoA &x, util::PointSoA &u,
+                         std::vector<double> &vol, double h, double horizon,
+                         bool breakBonds) {
+
+    node.d_dim = dim;
+    for (size_t d = 0; d < 3; d++) {
+      node.d_xRef[d] = d < dim ? x.data(d) : nullptr;
+      node.d_u[d] = d < dim ? u.data(d) : nullptr;
+    }
+    node.d_vol = vol.data();
+    node.d_bondLength = nullptr;
+    node.d_bondVolume = nullptr;
+    node.d_bondInfFn = nullptr;
+    node.d_c = 1.e+12;
+    node.d_sc = 1.e-3;
+    node.d_breakBonds = breakBonds;
+    node.d_materialHorizon = horizon;
+    node.d_horizon = horizon;
+    node.d_meshSize = h;
+    node.d_Kn = 1.e+10;
+    node.d_Rc = 0.95 * h;
+  }
+
 } // namespace
 
 
@@ -282,6 +363,390 @@ std::string test::testTaskflow(size_t N, int seed) {
   return msg.str();
 }
 
+std::string test::testTaskflowExecutorReuse(size_t N, size_t nLoops, int seed) {
+
+  auto nThreads = util::parallel::getNThreads();
+  util::io::print(fmt::format("\n\ntestTaskflowExecutorReuse(): Number of threads = {}\n\n", nThreads));
+
+  // task: perform nLoops parallel loops over vector of size N
+  // 1. create new executor in each loop
+  // 2. use executor shared by the code
+
+  // generate vector of random numbers
+  auto dist = util::DistributionSample<UniformDistribution>(0., 1., seed);
+
+  std::vector<double> x(N);
+  std::vector<double> y1(N, 0.);
+  std::vector<double> y2(N, 0.);
+  std::generate(std::begin(x), std::end(x), [&] { return dist(); });
+
+  // new executor in each loop
+  auto t1 = steady_clock::now();
+  for (size_t l = 0; l < nLoops; l++) {
+    tf::Executor executor(nThreads);
+    tf::Taskflow taskflow;
+
+    taskflow.for_each_index((std::size_t) 0, N, (std::size_t) 1, [&x, &y1](std::size_t i) {
+        y1[i] += x[i] < 0.5 ? f1(x[i]) : f2(x[i]);
+      }
+    ); // for_each
+
+    executor.run(taskflow).get();
+  }
+  auto t2 = steady_clock::now();
+  auto dt12 = util::methods::timeDiff(t1, t2, "microseconds");
+
+  // shared executor
+  for (size_t l = 0; l < nLoops; l++) {
+    tf::Taskflow taskflow;
+
+    taskflow.for_each_index((std::size_t) 0, N, (std::size_t) 1, [&x, &y2](std::size_t i) {
+        y2[i] += x[i] < 0.5 ? f1(x[i]) : f2(x[i]);
+      }
+    ); // for_each
+
+    util::parallel::getExecutor().run(taskflow).get();
+  }
+  auto t3 = steady_clock::now();
+  auto dt23 = util::methods::timeDiff(t2, t3, "microseconds");
+
+  // compare results
+  double y_err = 0.;
+  for (size_t i=0; i<N; i++)
+    y_err += std::pow(y1[i] - y2[i], 2);
+
+  if (y_err > 1.e-10) {
+    std::cerr << fmt::format("Error: Results using new and shared executor do not match (squared error = {})\n",
+                             y_err);
+    exit(1);
+  }
+
+  // get time
+  std::ostringstream msg;
+  msg << fmt::format("  New executor per loop took = {}ms\n", dt12);
+  msg << fmt::format("  Shared executor took = {}ms\n", dt23);
+  msg << fmt::format("  Overhead per loop removed = {}ms\n", (dt12 - dt23)/double(nLoops));
+  msg << fmt::format("  Speed-up factor = {}\n\n\n", dt12/dt23);
+
+  return msg.str();
+}
+
+std::string test::testSimdBondKernel(size_t nGrid, size_t mHorizon,
+                                     size_t nLoops, int seed) {
+
+  util::io::print(fmt::format("\n\ntestSimdBondKernel(): SIMD kernel supported = {}\n\n",
+                              material::isSimdBondKernelSupported()));
+
+  const size_t dim = 2;
+  const size_t n = nGrid * nGrid;
+  double h, horizon;
+  util::PointSoA x(dim), u(dim);
+  std::vector<double> vol;
+  geometry::BondList bonds;
+  setupBondTestGrid(nGrid, mHorizon, seed, h, horizon, x, u, vol, bonds);
+
+  std::vector<geometry::BondList> bonds_test = {bonds, bonds};
+
+  material::GaussianInfluenceFn inf_fn({}, dim);
+
+  material::LinearBondForceNode<double> node;
+  setupBondTestNode(node, dim, x, u, vol, h, horizon, true);
+
+  // compute force using scalar (k = 0) and SIMD (k = 1) kernels
+  std::vector<std::vector<util::Point>> force(2, std::vector<util::Point>(n));
+  std::vector<std::vector<float>> Z(2, std::vector<float>(n, 0.));
+  std::vector<double> dt(2, 0.);
+  for (size_t k = 0; k < 2; k++) {
+    auto t1 = steady_clock::now();
+    for (size_t l = 0; l < nLoops; l++) {
+      for (size_t i = 0; i < n; i++) {
+        node.d_xi = x.get(i);
+        node.d_ui = u.get(i);
+        node.d_bonds = bonds_test[k].data() + bonds_test[k].begin(i);
+        node.d_numBonds = bonds_test[k].numBonds(i);
+
+        force[k][i] = util::Point();
+        Z[k][i] = 0.;
+        material::computeLinearBondForce(node, &inf_fn, force[k][i], Z[k][i],
+                                         k == 1);
+      }
+    }
+    dt[k] = util::methods::timeDiff(t1, steady_clock::now(), "milliseconds");
+  }
+
+  // compare results
+  double f_max = 0., f_err = 0., Z_err = 0.;
+  size_t state_err = 0, num_broken = 0;
+  for (size_t i = 0; i < n; i++) {
+    f_max = std::max(f_max, force[0][i].length());
+    f_err = std::max(f_err, (force[0][i] - force[1][i]).length());
+    Z_err = std::max(Z_err, double(std::abs(Z[0][i] - Z[1][i])));
+  }
+  for (size_t b = 0; b < bonds.numBonds(); b++) {
+    if (bonds_test[0].getBondState(b) != bonds_test[1].getBondState(b))
+      state_err++;
+    if (bonds_test[0].getBondState(b))
+      num_broken++;
+  }
+
+  if (f_err > 1.e-10 * f_max or Z_err > 1.e-6 or state_err > 0) {
+    std::cerr << fmt::format("Error: Results of scalar and SIMD bond kernels "
+                             "do not match (force error = {}, max force = {}, "
+                             "damage error = {}, bond state mismatch = {})\n",
+                             f_err, f_max, Z_err, state_err);
+    exit(1);
+  }
+
+  // get time
+  std::ostringstream msg;
+  msg << fmt::format("  Number of nodes = {}, bonds = {}, broken bonds = {}\n",
+                     n, bonds.numBonds(), num_broken);
+  msg << fmt::format("  Scalar kernel took = {}ms\n", dt[0]);
+  msg << fmt::format("  SIMD kernel took = {}ms\n", dt[1]);
+  msg << fmt::format("  Max force error relative to max force = {}\n", f_err / f_max);
+  msg << fmt::format("  Speed-up factor = {}\n\n\n", dt[0]/dt[1]);
+
+  return msg.str();
+}
+
+std::string test::testMixedPrecisionBondKernel(size_t nGrid, size_t mHorizon,
+                                               size_t nLoops, int seed) {
+
+  util::io::print("\n\ntestMixedPrecisionBondKernel(): Comparing bond kernel "
+                  "with single and double precision bond cache\n\n");
+
+  const size_t dim = 2;
+  const size_t n = nGrid * nGrid;
+  double h, horizon;
+  util::PointSoA x(dim), u(dim);
+  std::vector<double> vol;
+  geometry::BondList bonds;
+  setupBondTestGrid(nGrid, mHorizon, seed, h, horizon, x, u, vol, bonds);
+
+  material::GaussianInfluenceFn inf_fn({}, dim);
+
+  // bond cache in double and single precision
+  const double check_up = horizon + 0.5 * h;
+  const double check_low = horizon - 0.5 * h;
+  const auto nb = bonds.numBonds();
+  std::vector<double> length(nb), volume(nb), infFn(nb);
+  std::vector<float> lengthF(nb), volumeF(nb), infFnF(nb);
+  for (size_t i = 0; i < n; i++)
+    for (size_t b = bonds.begin(i); b < bonds.end(i); b++) {
+      const auto j = bonds.getNeighbor(b);
+      double rji = (x.get(j) - x.get(i)).length();
+      double volj = vol[j];
+      if (util::isGreater(rji, check_low))
+        volj *= (check_up - rji) / h;
+
+      length[b] = rji;
+      volume[b] = volj;
+      infFn[b] = inf_fn.getInfFn(rji / horizon);
+      lengthF[b] = float(length[b]);
+      volumeF[b] = float(volume[b]);
+      infFnF[b] = float(infFn[b]);
+    }
+
+  material::LinearBondForceNode<double> node;
+  material::LinearBondForceNode<float> nodeF;
+  setupBondTestNode(node, dim, x, u, vol, h, horizon, true);
+  setupBondTestNode(nodeF, dim, x, u, vol, h, horizon, true);
+
+  // compute force using double cache (k = 0), float cache with scalar
+  // kernel (k = 1), and float cache with SIMD kernel (k = 2)
+  std::vector<geometry::BondList> bonds_test = {bonds, bonds, bonds};
+  std::vector<std::vector<util::Point>> force(3, std::vector<util::Point>(n));
+  std::vector<std::vector<float>> Z(3, std::vector<float>(n, 0.));
+  std::vector<double> dt(3, 0.);
+  for (size_t k = 0; k < 3; k++) {
+    auto t1 = steady_clock::now();
+    for (size_t l = 0; l < nLoops; l++) {
+      for (size_t i = 0; i < n; i++) {
+        const auto b0 = bonds_test[k].begin(i);
+        force[k][i] = util::Point();
+        Z[k][i] = 0.;
+        if (k == 0) {
+          node.d_xi = x.get(i);
+          node.d_ui = u.get(i);
+          node.d_bonds = bonds_test[k].data() + b0;
+          node.d_numBonds = bonds_test[k].numBonds(i);
+          node.d_bondLength = length.data() + b0;
+          node.d_bondVolume = volume.data() + b0;
+          node.d_bondInfFn = infFn.data() + b0;
+          material::computeLinearBondForce(node, &inf_fn, force[k][i],
+                                           Z[k][i], false);
+        } else {
+          nodeF.d_xi = x.get(i);
+          nodeF.d_ui = u.get(i);
+          nodeF.d_bonds = bonds_test[k].data() + b0;
+          nodeF.d_numBonds = bonds_test[k].numBonds(i);
+          nodeF.d_bondLength = lengthF.data() + b0;
+          nodeF.d_bondVolume = volumeF.data() + b0;
+          nodeF.d_bondInfFn = infFnF.data() + b0;
+          material::computeLinearBondForce(nodeF, &inf_fn, force[k][i],
+                                           Z[k][i], k == 2);
+        }
+      }
+    }
+    dt[k] = util::methods::timeDiff(t1, steady_clock::now(), "milliseconds");
+  }
+
+  // compare results against double precision; bond strain is computed from
+  // double precision positions so bond states should match exactly
+  double f_max = 0.;
+  std::vector<double> f_err(3, 0.), Z_err(3, 0.);
+  std::vector<size_t> state_err(3, 0);
+  for (size_t i = 0; i < n; i++)
+    f_max = std::max(f_max, force[0][i].length());
+  for (size_t k = 1; k < 3; k++) {
+    for (size_t i = 0; i < n; i++) {
+      f_err[k] = std::max(f_err[k], (force[0][i] - force[k][i]).length());
+      Z_err[k] = std::max(Z_err[k], double(std::abs(Z[0][i] - Z[k][i])));
+    }
+    for (size_t b = 0; b < nb; b++)
+      if (bonds_test[0].getBondState(b) != bonds_test[k].getBondState(b))
+        state_err[k]++;
+
+    if (f_err[k] > 1.e-5 * f_max or Z_err[k] > 1.e-6 or state_err[k] > 0) {
+      std::cerr << fmt::format("Error: Results of bond kernel with single "
+                               "precision cache do not match double precision "
+                               "(kernel = {}, force error = {}, max force = {}, "
+                               "damage error = {}, bond state mismatch = {})\n",
+                               k == 1 ? "scalar" : "SIMD", f_err[k], f_max,
+                               Z_err[k], state_err[k]);
+      exit(1);
+    }
+  }
+
+  // get time
+  std::ostringstream msg;
+  msg << fmt::format("  Number of nodes = {}, bonds = {}\n", n, nb);
+  msg << fmt::format("  Bond cache memory: double = {} bytes, float = {} bytes\n",
+                     3 * nb * sizeof(double), 3 * nb * sizeof(float));
+  msg << fmt::format("  Double cache kernel took = {}ms\n", dt[0]);
+  msg << fmt::format("  Float cache kernel took = {}ms\n", dt[1]);
+  msg << fmt::format("  Float cache SIMD kernel took = {}ms (SIMD supported = {})\n",
+                     dt[2], material::isSimdBondKernelSupported());
+  msg << fmt::format("  Max force error relative to max force: scalar = {}, SIMD = {}\n\n\n",
+                     f_err[1] / f_max, f_err[2] / f_max);
+
+  return msg.str();
+}
+
+std::string test::testNodeOrdering(size_t nGrid, size_t mHorizon,
+                                   size_t nLoops, int seed) {
+
+  util::io::print("\n\ntestNodeOrdering(): Comparing bond kernel for random, "
+                  "Morton, and Hilbert order of nodes\n\n");
+
+  // nodes and bonds in grid order
+  const size_t dim = 2;
+  const size_t n = nGrid * nGrid;
+  double h, horizon;
+  util::PointSoA x(dim), u(dim);
+  std::vector<double> vol;
+  geometry::BondList bonds;
+  setupBondTestGrid(nGrid, mHorizon, seed, h, horizon, x, u, vol, bonds);
+
+  // random order of nodes to mimic node order in unstructured mesh files
+  std::vector<size_t> perm(n);
+  std::iota(perm.begin(), perm.end(), 0);
+  std::shuffle(perm.begin(), perm.end(), RandGenerator(seed));
+
+  std::vector<util::Point> nodes_perm(n);
+  for (size_t k = 0; k < n; k++)
+    nodes_perm[k] = x.get(perm[k]);
+
+  std::vector<std::string> methods = {"random", "morton", "hilbert"};
+  std::vector<std::vector<util::Point>> force(3, std::vector<util::Point>(n));
+  std::vector<double> dt(3, 0.), avg_dist(3, 0.);
+
+  material::GaussianInfluenceFn inf_fn({}, dim);
+
+  for (size_t m = 0; m < methods.size(); m++) {
+
+    // grid id of each node in the new order
+    std::vector<size_t> order = perm;
+    if (m > 0) {
+      auto sfc = fe::getSpaceFillingCurveOrder(nodes_perm, dim, methods[m]);
+      for (size_t k = 0; k < n; k++)
+        order[k] = perm[sfc[k]];
+    }
+
+    std::vector<size_t> new_id(n);
+    for (size_t k = 0; k < n; k++)
+      new_id[order[k]] = k;
+
+    // renumber data
+    util::PointSoA xm(dim), um(dim);
+    std::vector<double> volm(n);
+    std::vector<std::vector<size_t>> neighs(n);
+    for (size_t k = 0; k < n; k++) {
+      xm.push_back(x.get(order[k]));
+      um.push_back(u.get(order[k]));
+      volm[k] = vol[order[k]];
+      for (auto b = bonds.begin(order[k]); b < bonds.end(order[k]); b++) {
+        neighs[k].push_back(new_id[bonds.getNeighbor(b)]);
+        avg_dist[m] += std::abs(double(neighs[k].back()) - double(k));
+      }
+    }
+    avg_dist[m] /= double(bonds.numBonds());
+
+    geometry::BondList bonds_m;
+    bonds_m.build(neighs);
+    for (size_t k = 0; k < n; k++) {
+      auto bm = bonds_m.begin(k);
+      for (auto b = bonds.begin(order[k]); b < bonds.end(order[k]); b++)
+        bonds_m.setBondState(bm++, bonds.getBondState(b));
+    }
+
+    material::LinearBondForceNode<double> node;
+    setupBondTestNode(node, dim, xm, um, volm, h, horizon, false);
+
+    auto t1 = steady_clock::now();
+    for (size_t l = 0; l < nLoops; l++) {
+      for (size_t k = 0; k < n; k++) {
+        node.d_xi = xm.get(k);
+        node.d_ui = um.get(k);
+        node.d_bonds = bonds_m.data() + bonds_m.begin(k);
+        node.d_numBonds = bonds_m.numBonds(k);
+
+        util::Point f;
+        float Z = 0.;
+        material::computeLinearBondForce(node, &inf_fn, f, Z, false);
+        force[m][order[k]] = f;
+      }
+    }
+    dt[m] = util::methods::timeDiff(t1, steady_clock::now(), "milliseconds");
+  }
+
+  // compare results
+  double f_max = 0., f_err = 0.;
+  for (size_t i = 0; i < n; i++) {
+    f_max = std::max(f_max, force[0][i].length());
+    for (size_t m = 1; m < methods.size(); m++)
+      f_err = std::max(f_err, (force[0][i] - force[m][i]).length());
+  }
+
+  if (f_err > 1.e-10 * f_max) {
+    std::cerr << fmt::format("Error: Results of bond kernel for different "
+                             "node order do not match (force error = {}, max "
+                             "force = {})\n", f_err, f_max);
+    exit(1);
+  }
+
+  // get time
+  std::ostringstream msg;
+  msg << fmt::format("  Number of nodes = {}, bonds = {}\n", n, bonds.numBonds());
+  for (size_t m = 0; m < methods.size(); m++)
+    msg << fmt::format("  Order = {:8s}: average |i - j| of bonds = {:12.2f}, "
+                       "kernel took = {}ms, speed-up factor = {}\n",
+                       methods[m], avg_dist[m], dt[m], dt[0] / dt[m]);
+  msg << "\n\n";
+
+  return msg.str();
+}
+
 void test::testMPI(size_t nGrid, size_t mHorizon,
                    size_t testOption, std::string meshFilename) {
   int mpiSize, mpiRank;
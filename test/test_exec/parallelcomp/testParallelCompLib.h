@@ -23,6 +23,52 @@ namespace test {
  */
 std::string testTaskflow(size_t N, int seed);
 
+/*!
+ * @brief Profile overhead of creating new taskflow executor in every
+ * parallel loop against using the executor shared by the code
+ * (util::parallel::getExecutor())
+ * @param N size of vector processed in each parallel loop
+ * @param nLoops Number of parallel loops (e.g., number of loops in a time step times the number of time steps)
+ * @param seed Seed
+ * @return str String containing various information
+ */
+std::string testTaskflowExecutorReuse(size_t N, size_t nLoops, int seed);
+
+/*!
+ * @brief Profile explicitly vectorized bond-based force kernel against the
+ * scalar kernel and check that results match
+ * (see material::computeLinearBondForce())
+ * @param nGrid Number of nodes along a line of uniform 2d grid
+ * @param mHorizon Integer factor that is used to compute horizon (epsilon = m * h, h being mesh size)
+ * @param nLoops Number of times force is computed
+ * @param seed Seed
+ * @return str String containing various information
+ */
+std::string testSimdBondKernel(size_t nGrid, size_t mHorizon, size_t nLoops, int seed);
+
+/*!
+ * @brief Compare bond-based force kernel using single precision bond cache
+ * (mixed-precision mode) against double precision bond cache
+ * @param nGrid Number of nodes along a line of uniform 2d grid
+ * @param mHorizon Integer factor that is used to compute horizon (epsilon = m * h, h being mesh size)
+ * @param nLoops Number of times force is computed
+ * @param seed Seed
+ * @return str String containing various information
+ */
+std::string testMixedPrecisionBondKernel(size_t nGrid, size_t mHorizon, size_t nLoops, int seed);
+
+/*!
+ * @brief Profile bond-based force kernel for nodes numbered in random order
+ * (mimicking unstructured mesh files) and along Morton and Hilbert curves
+ * (see fe::getSpaceFillingCurveOrder())
+ * @param nGrid Number of nodes along a line of uniform 2d grid
+ * @param mHorizon Integer factor that is used to compute horizon (epsilon = m * h, h being mesh size)
+ * @param nLoops Number of times force is computed
+ * @param seed Seed
+ * @return str String containing various information
+ */
+std::string testNodeOrdering(size_t nGrid, size_t mHorizon, size_t nLoops, int seed);
+
 /*!
  * @brief Perform parallelization test using MPI on mesh partition based on metis
  * @param nGrid Number of element along a line (total number of elements is N*N)
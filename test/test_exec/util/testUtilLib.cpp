@@ -10,6 +10,7 @@
 
 #include "testUtilLib.h"
 #include "util/geom.h"
+#include "util/pointSoA.h"
 #include "util/transformation.h"
 #include <fstream>
 #include "fmt/format.h"
@@ -107,4 +108,38 @@ void test::testUtilMethods() {
     if (std::abs(M_PI/3. - util::angle(x1, x2)) > tol)
       errExit("Error: angle()\n");
   }
+  //
+  {
+    // structure-of-arrays storage of points in 2d
+    std::vector<util::Point> x = {util::Point(0., 0., 0.),
+                                  util::Point(1., 0., 0.),
+                                  util::Point(0.5, 2., 0.)};
+    util::PointSoA x_soa(2);
+    for (const auto &xi : x)
+      x_soa.push_back(xi);
+
+    if (x_soa.size() != x.size() or x_soa.dim() != 2)
+      errExit("Error: PointSoA::push_back()\n");
+
+    for (size_t i = 0; i < x.size(); i++)
+      if (x_soa.get(i).dist(x[i]) > tol)
+        errExit(fmt::format("Error: PointSoA::get(). x = {}, x_soa = {}\n",
+                            x[i].printStr(), x_soa.get(i).printStr()));
+
+    // components beyond dimension are not stored
+    x_soa.add(1, util::Point(1., 1., 1.));
+    if (x_soa.get(1).dist(util::Point(2., 1., 0.)) > tol or
+        std::abs(x_soa(1, 0) - 2.) > tol)
+      errExit("Error: PointSoA::add()\n");
+
+    x_soa.set(1, x[1]);
+    if (std::abs(util::computeMeshSize(x_soa, 0, x_soa.size())
+                 - util::computeMeshSize(x)) > tol)
+      errExit("Error: computeMeshSize() for PointSoA\n");
+
+    auto y = x_soa.toVector();
+    for (size_t i = 0; i < x.size(); i++)
+      if (y[i].dist(x[i]) > tol)
+        errExit("Error: PointSoA::toVector()\n");
+  }
 }
\ No newline at end of file